@@ -0,0 +1,112 @@
+// Compares simulation cost of a LAN of 256 hosts on CSMA channel with the
+// same LAN on model::IdealChannel, every host sends UDP packets to its
+// neighbour
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include <boost/asio/ip/network_v4.hpp>
+
+#include <ns3/simulator.h>
+
+#include <fmt/core.h>
+
+#include "model/channel.h"
+#include "model/model.h"
+#include "model/name_service.h"
+#include "parser/parser.h"
+
+namespace {
+constexpr auto default_hosts = 256;
+constexpr auto packets_per_host = "1000";
+constexpr auto interval = "1ms";
+constexpr auto data_rate = "1Gbps";
+
+auto host_address(int index) -> std::string {
+  return fmt::format("10.0.{}.{}/16", (index + 1) / 256, (index + 1) % 256);
+}
+
+// Serialized ns3::Address of host for address attributes of applications
+auto remote_address(int index) -> std::string {
+  return fmt::format("0-4-0A:00:{:02X}:{:02X}", (index + 1) / 256,
+                     (index + 1) % 256);
+}
+
+auto make_lan(const std::string &type, model::channel_type channel,
+              int hosts) -> parser::ModelDescription {
+  parser::ModelDescription description{.model_name = "lan",
+                                       .populate_neighbor_cache = true,
+                                       .end_time = "2s"};
+  parser::ConnectionDescription lan{
+      .name = "lan",
+      .type = channel,
+      .attributes = {{"DataRate", data_rate}, {"Delay", "1us"}}};
+  if (channel == model::channel_type::Ideal) {
+    // Ideal channel has no rate, it is limited by devices
+    lan.attributes.erase("DataRate");
+  }
+
+  for (int i = 0; i < hosts; ++i) {
+    auto name = fmt::format("host{}", i);
+
+    parser::NodeDescription node{
+        .name = name,
+        .devices = {{.name = "eth0",
+                     .type = type,
+                     .ipv4_addresses = {
+                         boost::asio::ip::make_network_v4(host_address(i))}}},
+        .applications = {
+            {.name = name + "-server",
+             .type = "ns3::UdpServer",
+             .attributes = {{"Port", "9"}}},
+            {.name = name + "-client",
+             .type = "ns3::UdpClient",
+             .attributes = {{"RemoteAddress", remote_address((i + 1) % hosts)},
+                            {"RemotePort", "9"},
+                            {"MaxPackets", packets_per_host},
+                            {"Interval", interval}}}}};
+    if (channel == model::channel_type::Ideal) {
+      node.devices.front().attributes = {{"DataRate", data_rate}};
+    }
+
+    lan.interfaces.push_back(name + "/eth0");
+    description.nodes.push_back(std::move(node));
+  }
+
+  description.connections.push_back(std::move(lan));
+  return description;
+}
+
+void run(const std::string &name, const parser::ModelDescription &lan) {
+  {
+    model::Model model;
+    model.build_from_description(lan);
+
+    ns3::Simulator::Stop(ns3::Time{lan.end_time});
+
+    auto start = std::chrono::steady_clock::now();
+    ns3::Simulator::Run();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    auto events = ns3::Simulator::GetEventCount();
+    std::cout << fmt::format(
+        "{:<8} {:>12} events {:>10.3f} s {:>14.0f} events/s\n", name, events,
+        elapsed.count(), static_cast<double>(events) / elapsed.count());
+  }
+
+  ns3::Simulator::Destroy();
+  model::names::cleanup();
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  auto hosts = argc > 1 ? std::stoi(argv[1]) : default_hosts;
+
+  run("csma", make_lan("Csma", model::channel_type::CSMA, hosts));
+  run("ideal", make_lan("Ideal", model::channel_type::Ideal, hosts));
+
+  return 0;
+}
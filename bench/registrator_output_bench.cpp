@@ -0,0 +1,74 @@
+// Compares throughput of CSV output of ns3::FileAggregator (used by
+// format="csv" registrators) with stats::BinaryWriter (format="binary")
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ns3/file-aggregator.h>
+#include <ns3/object.h>
+
+#include <fmt/core.h>
+
+#include "stats/binary_writer.h"
+
+namespace {
+constexpr std::uint64_t default_samples = 10'000'000;
+
+void run(const std::string &name, std::uint64_t samples,
+         const std::function<void(std::int64_t, double)> &write,
+         const std::function<void()> &finish) {
+  auto start = std::chrono::steady_clock::now();
+
+  for (std::uint64_t i = 0; i < samples; ++i) {
+    write(static_cast<std::int64_t>(i * 1000), static_cast<double>(i % 1500));
+  }
+  finish();
+
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  std::cout << fmt::format(
+      "{:<10} {:>12} samples {:>10.3f} s {:>14.0f} samples/s\n", name,
+      samples, elapsed.count(), static_cast<double>(samples) / elapsed.count());
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  auto samples = argc > 1 ? std::stoull(argv[1]) : default_samples;
+
+  {
+    auto aggregator = ns3::CreateObject<ns3::FileAggregator>(
+        "bench_csv.txt", ns3::FileAggregator::COMMA_SEPARATED);
+    aggregator->SetHeading("Time,value");
+
+    run(
+        "csv", samples,
+        [&aggregator](std::int64_t time, double value) {
+          aggregator->Write2d("", static_cast<double>(time) * 1e-9, value);
+        },
+        [&aggregator] { aggregator = nullptr; });
+  }
+
+  {
+    auto writer = std::make_unique<stats::BinaryWriter>(
+        "bench_binary.bin", std::vector<std::string>{"value"}, 1e-9);
+
+    run(
+        "binary", samples,
+        [&writer](std::int64_t time, double value) {
+          writer->write(time, &value);
+        },
+        [&writer] { writer = nullptr; });
+  }
+
+  std::remove("bench_csv.txt");
+  std::remove("bench_binary.bin");
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+// Measures construction of model::Topology from description and breadth-first
+// search over it on a ring of nodes with random chords, 250000 nodes give
+// 500000 point-to-point links, i.e. 2M directed edges between nodes and
+// channels
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include "model/channel.h"
+#include "model/topology.h"
+#include "parser/parser.h"
+
+namespace {
+constexpr auto default_nodes = 250'000;
+constexpr auto bfs_runs = 10;
+constexpr auto seed = 42;
+
+auto make_graph(int nodes) -> parser::ModelDescription {
+  parser::ModelDescription description{.model_name = "graph"};
+  description.nodes.reserve(nodes);
+  description.connections.reserve(2 * static_cast<std::size_t>(nodes));
+
+  for (int i = 0; i < nodes; ++i) {
+    parser::NodeDescription node{.name = fmt::format("n{}", i)};
+    for (const auto *device : {"eth0", "eth1", "eth2", "eth3"}) {
+      node.devices.push_back({.name = device, .type = "PPP"});
+    }
+    description.nodes.push_back(std::move(node));
+  }
+
+  std::vector<int> chord(nodes);
+  std::iota(chord.begin(), chord.end(), 0);
+  std::shuffle(chord.begin(), chord.end(), std::mt19937{seed});
+
+  auto link = [&description](const std::string &lhs, const std::string &rhs) {
+    description.connections.push_back(
+        {.name = lhs + "-" + rhs,
+         .type = model::channel_type::PPP,
+         .interfaces = {lhs, rhs},
+         .attributes = {{"Delay", "1ms"}}});
+  };
+
+  for (int i = 0; i < nodes; ++i) {
+    link(fmt::format("n{}/eth0", i), fmt::format("n{}/eth1", (i + 1) % nodes));
+    link(fmt::format("n{}/eth2", i), fmt::format("n{}/eth3", chord[i]));
+  }
+
+  return description;
+}
+
+template <typename F>
+auto measure(F &&function) -> double {
+  auto start = std::chrono::steady_clock::now();
+  function();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  auto nodes = argc > 1 ? std::stoi(argv[1]) : default_nodes;
+  auto description = make_graph(nodes);
+
+  model::Topology topology;
+  auto build_time =
+      measure([&] { topology = model::Topology::build(description); });
+  std::cout << fmt::format(
+      "build {:>10} nodes {:>10} edges {:>10.3f} s {:>14.0f} edges/s\n",
+      topology.nodes_count(), topology.edges_count(), build_time,
+      static_cast<double>(topology.edges_count()) / build_time);
+
+  std::size_t reached = 0;
+  auto bfs_time = measure([&] {
+    for (int run = 0; run < bfs_runs; ++run) {
+      auto distance = topology.bfs(run * (nodes / bfs_runs));
+      reached += std::count_if(distance.begin(), distance.end(), [](auto hops) {
+        return hops != model::Topology::invalid;
+      });
+    }
+  });
+  bfs_time /= bfs_runs;
+  std::cout << fmt::format(
+      "bfs   {:>10} nodes {:>10} edges {:>10.3f} s {:>14.0f} edges/s\n",
+      reached / bfs_runs, topology.edges_count(), bfs_time,
+      static_cast<double>(topology.edges_count()) / bfs_time);
+
+  return 0;
+}
@@ -0,0 +1,103 @@
+// Compares simulation cost of ns3::OnOffApplication (one event per packet)
+// with applications::BurstSource (one event per burst) at the same offered
+// load over one point-to-point link
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include <ns3/application-container.h>
+#include <ns3/data-rate.h>
+#include <ns3/inet-socket-address.h>
+#include <ns3/internet-stack-helper.h>
+#include <ns3/ipv4-address-helper.h>
+#include <ns3/ipv4-interface-container.h>
+#include <ns3/net-device-container.h>
+#include <ns3/node-container.h>
+#include <ns3/nstime.h>
+#include <ns3/object-factory.h>
+#include <ns3/packet-sink.h>
+#include <ns3/point-to-point-helper.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/uinteger.h>
+
+#include <fmt/core.h>
+
+#include "applications/applications.h"
+
+namespace {
+constexpr auto default_duration = 1.0;
+constexpr auto offered_load = "5Gb/s";
+constexpr auto link_rate = "10Gb/s";
+constexpr std::uint32_t packet_size = 1000;
+constexpr std::uint16_t port = 9;
+constexpr auto always_on = "ns3::ConstantRandomVariable[Constant=1e9]";
+constexpr auto never_off = "ns3::ConstantRandomVariable[Constant=0]";
+
+void run(const std::string &name, const std::string &source_type,
+         double duration) {
+  ns3::NodeContainer nodes;
+  nodes.Create(2);
+
+  ns3::PointToPointHelper link;
+  link.SetDeviceAttribute("DataRate", ns3::StringValue(link_rate));
+  link.SetChannelAttribute("Delay", ns3::StringValue("1ms"));
+  auto devices = link.Install(nodes);
+
+  ns3::InternetStackHelper internet;
+  internet.Install(nodes);
+
+  ns3::Ipv4AddressHelper addresses{"10.1.1.0", "255.255.255.0"};
+  auto interfaces = addresses.Assign(devices);
+
+  auto remote = ns3::InetSocketAddress(interfaces.GetAddress(1), port);
+
+  ns3::ObjectFactory source_factory{source_type};
+  source_factory.Set("DataRate", ns3::StringValue(offered_load));
+  source_factory.Set("PacketSize", ns3::UintegerValue(packet_size));
+  source_factory.Set("Remote", ns3::AddressValue(remote));
+  if (source_type == "ns3::OnOffApplication") {
+    source_factory.Set("OnTime", ns3::StringValue(always_on));
+    source_factory.Set("OffTime", ns3::StringValue(never_off));
+  }
+  auto source = source_factory.Create<ns3::Application>();
+  nodes.Get(0)->AddApplication(source);
+
+  auto sink = ns3::CreateObject<ns3::PacketSink>();
+  sink->SetAttribute("Local",
+                     ns3::AddressValue(ns3::InetSocketAddress(
+                         ns3::Ipv4Address::GetAny(), port)));
+  nodes.Get(1)->AddApplication(sink);
+
+  ns3::Simulator::Stop(ns3::Seconds(duration));
+
+  auto start = std::chrono::steady_clock::now();
+  ns3::Simulator::Run();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  auto events = ns3::Simulator::GetEventCount();
+  auto received = sink->GetTotalRx();
+  ns3::Simulator::Destroy();
+
+  std::cout << fmt::format(
+      "{:<8} {:>12} events {:>10.3f} s {:>14.0f} events/s {:>10.3f} Gb/s "
+      "received\n",
+      name, events, elapsed.count(),
+      static_cast<double>(events) / elapsed.count(),
+      static_cast<double>(received) * 8 / duration / 1e9);
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  auto duration = argc > 1 ? std::stod(argv[1]) : default_duration;
+
+  applications::register_types();
+
+  run("onoff", "ns3::OnOffApplication", duration);
+  run("burst", "applications::BurstSource", duration);
+
+  return 0;
+}
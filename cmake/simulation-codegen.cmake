@@ -0,0 +1,66 @@
+# simulation_add_model(<target> <xml> [GENERATOR <simulation executable>])
+#
+# Generates C++ source of the model with `simulation --codegen` and builds
+# it into executable <target>, which runs the model without reading XML.
+# The source is regenerated when the model or the generator changes.
+# Generator is the `simulation` target of this project or the installed
+# `simulation` executable.
+function(simulation_add_model target xml)
+  cmake_parse_arguments(ARG "" "GENERATOR" "" ${ARGN})
+
+  if (NOT ARG_GENERATOR)
+    if (TARGET simulation)
+      set(ARG_GENERATOR simulation)
+    else()
+      find_program(SIMULATION_EXECUTABLE simulation)
+      if (NOT SIMULATION_EXECUTABLE)
+        message(FATAL_ERROR "simulation executable is not found")
+      endif()
+      set(ARG_GENERATOR ${SIMULATION_EXECUTABLE})
+    endif()
+  endif()
+
+  if (TARGET simulation::simulation_lib)
+    set(library simulation::simulation_lib)
+  else()
+    set(library simulation_lib)
+  endif()
+
+  get_filename_component(xml_path ${xml} ABSOLUTE)
+  set(source ${CMAKE_CURRENT_BINARY_DIR}/${target}.cpp)
+
+  add_custom_command(
+    OUTPUT ${source}
+    COMMAND ${ARG_GENERATOR} --xml ${xml_path} --codegen ${source}
+    DEPENDS ${xml_path} ${ARG_GENERATOR}
+    COMMENT "Generating model ${target} from ${xml}"
+    VERBATIM
+  )
+
+  add_executable(${target} ${source})
+
+  target_link_libraries(
+    ${target} PRIVATE
+    ${library}
+
+    # FIX: fix for loading static type information on start-up
+    -Wl,--no-as-needed
+    ns3::libcore
+    ns3::libnetwork
+    ns3::libinternet
+    ns3::libstats
+    ns3::libcsma
+    ns3::libpoint-to-point
+    ns3::libapplications
+    -Wl,--as-needed
+  )
+
+  target_compile_features(${target} PRIVATE cxx_std_17)
+
+  set_target_properties(
+    ${target}
+    PROPERTIES
+      CXX_STANDARD 17
+      CXX_STANDARD_REQUIRED TRUE
+  )
+endfunction()
@@ -0,0 +1,81 @@
+// Builds model of udp_echo.xml in memory with parser::ModelBuilder and runs
+// it, chain of N routers between client and server is generated instead of
+// one LAN: ./embedded_udp_echo [routers]
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include <fmt/core.h>
+
+#include "model/channel.h"
+#include "model/model.h"
+#include "parser/model_builder.h"
+
+namespace {
+constexpr auto default_routers = 4;
+constexpr auto netmask = "255.255.255.0";
+
+// Address of host on link between hop and hop + 1
+auto link_address(int hop, int host) -> std::string {
+  return fmt::format("10.1.{}.{}", hop, host);
+}
+
+// Serialized ns3::Address of the same host for application attributes
+auto remote_address(int hop, int host) -> std::string {
+  return fmt::format("0-4-0A:01:{:02X}:{:02X}", hop, host);
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  auto routers = argc > 1 ? std::stoi(argv[1]) : default_routers;
+  auto hops = routers + 1;
+
+  parser::ModelBuilder builder{"embedded_udp_echo"};
+  builder.duration("10s").populate_routing_tables();
+
+  builder.node("client")
+      .device("eth0", "PPP", {{"DataRate", "100Mbps"}})
+      .address(link_address(0, 1), netmask)
+      .application("echo-client", "ns3::UdpEchoClient",
+                   {{"RemoteAddress", remote_address(hops - 1, 2)},
+                    {"RemotePort", "9"},
+                    {"MaxPackets", "100"},
+                    {"Interval", "10ms"}});
+
+  for (int i = 1; i <= routers; ++i) {
+    builder.node(fmt::format("router{}", i))
+        .device("eth0", "PPP", {{"DataRate", "100Mbps"}})
+        .address(link_address(i - 1, 2), netmask)
+        .device("eth1", "PPP", {{"DataRate", "100Mbps"}})
+        .address(link_address(i, 1), netmask);
+  }
+
+  builder.node("server")
+      .device("eth0", "PPP", {{"DataRate", "100Mbps"}})
+      .address(link_address(hops - 1, 2), netmask)
+      .application("echo-server", "ns3::UdpEchoServer", {{"Port", "9"}});
+
+  for (int hop = 0; hop < hops; ++hop) {
+    auto lhs = hop == 0 ? "client/eth0" : fmt::format("router{}/eth1", hop);
+    auto rhs = hop == routers ? "server/eth0"
+                              : fmt::format("router{}/eth0", hop + 1);
+    builder.connect(fmt::format("link{}", hop), model::channel_type::PPP,
+                    {lhs, rhs}, {{"Delay", "1ms"}});
+  }
+
+  try {
+    model::Model model;
+    model.build_from_description(builder.build());
+
+    std::cout << fmt::format("{} nodes, {} links, running...\n",
+                             model.topology().nodes_count(),
+                             model.topology().channels_count());
+    model.start();
+  } catch (std::exception &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
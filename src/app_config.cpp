@@ -10,10 +10,56 @@
 bool AppConfig::parse(int argc, char *argv[]) noexcept {
   CLI::App app{"NS3 simululation core", "simulation"};
 
-  app.add_option("-i,--xml", xml_model_path,
-                 "Path to network model in XML format")
-      ->check(CLI::ExistingFile)
-      ->required();
+  auto *mode = app.add_option_group("mode", "Run one model or serve models");
+  auto *xml = mode->add_option("-i,--xml", xml_model_path,
+                               "Path to network model in XML format")
+                  ->check(CLI::ExistingFile);
+  mode->add_option("--serve", serve_socket,
+                   "Run models sent by simulation-client to this Unix "
+                   "socket in pre-started worker processes");
+  mode->require_option(1);
+
+  app.add_option("--workers", serve_workers,
+                 "Number of worker processes of --serve, CPU count by "
+                 "default");
+
+  app.add_option("--profile-events", event_profile_path,
+                 "Profile executed events per node and event source, "
+                 "write JSON profile to the given file");
+
+  app.add_option("--profile-top", event_profile_top,
+                 "Number of top event sources printed by --profile-events")
+      ->check(CLI::PositiveNumber);
+
+  app.add_flag("--profile-build", profile_build,
+               "Print wall time, allocations and RSS delta of model parse "
+               "and build phases");
+
+  app.add_option("--profile-build-json", build_profile_path,
+                 "Write build phases profile in JSON to the given file");
+
+  app.add_flag("--track-allocations", track_allocations,
+               "Report heap allocations count, bytes and peak per phase "
+               "(parse, build, routing, run) at exit");
+
+  app.add_flag("--prune", prune,
+               "Don't build nodes which can't lie on a path between "
+               "application endpoints, report pruned parts of the model");
+
+  app.add_option("--cache", cache_dir,
+                 "Restore output files of the same model, RNG seed and "
+                 "simulator build from this directory instead of "
+                 "simulating, store them after the run otherwise");
+
+  app.add_option("--cache-size", cache_size,
+                 "Limit of the result cache size, least recently used "
+                 "results are removed above it (1GiB by default)")
+      ->transform(CLI::AsSizeValue(false));
+
+  app.add_option("--codegen", codegen_path,
+                 "Don't run the model, write C++ source of a program "
+                 "building and running it without XML to the given file")
+      ->needs(xml);
 
   try {
     app.parse(argc, argv);
@@ -1,6 +1,8 @@
 #ifndef __APP_CONFIG_H_A5SZBOTDX6W8__
 #define __APP_CONFIG_H_A5SZBOTDX6W8__
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 enum class log_type { plain, json };
@@ -22,6 +24,70 @@ struct AppConfig {
   bool parse(int argc, char *argv[]) noexcept;  // NOLINT
 
   std::string xml_model_path;
+
+  /**
+   * @brief Path to JSON event profile, profiling is disabled if empty
+   *
+   */
+  std::string event_profile_path;
+
+  std::size_t event_profile_top = 20;
+
+  /**
+   * @brief Print time, allocations and RSS delta of parse and build phases
+   *
+   */
+  bool profile_build = false;
+
+  /**
+   * @brief Path to JSON build profile, not written if empty
+   *
+   */
+  std::string build_profile_path;
+
+  /**
+   * @brief Count heap allocations per program phase and report them at exit
+   *
+   */
+  bool track_allocations = false;
+
+  /**
+   * @brief Leave out nodes which can't carry traffic between applications
+   *
+   */
+  bool prune = false;
+
+  /**
+   * @brief Unix socket of server mode, models are run from command line if
+   * empty
+   *
+   */
+  std::string serve_socket;
+
+  /**
+   * @brief Number of worker processes of server, CPU count if 0
+   *
+   */
+  std::size_t serve_workers = 0;
+
+  /**
+   * @brief Directory of result cache, models are always simulated if empty
+   *
+   */
+  std::string cache_dir;
+
+  /**
+   * @brief Limit of total size of cached results in bytes
+   *
+   */
+  std::uintmax_t cache_size = std::uintmax_t{1} << 30;
+
+  /**
+   * @brief Path of C++ source generated from the model, the model is run if
+   * empty
+   *
+   */
+  std::string codegen_path;
 };
 
 #endif  // __APP_CONFIG_H_A5SZBOTDX6W8__
@@ -0,0 +1,15 @@
+#include "applications.h"
+
+#include "applications/burst_source.h"
+#include "applications/latency_sink.h"
+#include "applications/timestamp_tag.h"
+
+namespace applications {
+
+void register_types() {
+  BurstSource::GetTypeId();
+  LatencySink::GetTypeId();
+  TimestampTag::GetTypeId();
+}
+
+}  // namespace applications
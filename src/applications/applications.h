@@ -0,0 +1,17 @@
+#ifndef __APPLICATIONS_H_X3T9QM6CJV1D__
+#define __APPLICATIONS_H_X3T9QM6CJV1D__
+
+namespace applications {
+
+/**
+ * @brief Register TypeId of project applications
+ *
+ * Registration by static objects is dropped by linker together with unused
+ * object files of static library, so applications are registered explicitly
+ * before the model is built.
+ */
+void register_types();
+
+}  // namespace applications
+
+#endif  // __APPLICATIONS_H_X3T9QM6CJV1D__
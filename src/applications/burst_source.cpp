@@ -0,0 +1,152 @@
+#include "burst_source.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <ns3/boolean.h>
+#include <ns3/fatal-error.h>
+#include <ns3/inet-socket-address.h>
+#include <ns3/inet6-socket-address.h>
+#include <ns3/nstime.h>
+#include <ns3/pointer.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/udp-socket-factory.h>
+#include <ns3/uinteger.h>
+
+#include "applications/timestamp_tag.h"
+
+namespace applications {
+
+NS_OBJECT_ENSURE_REGISTERED(BurstSource);
+
+auto BurstSource::GetTypeId() -> ns3::TypeId {
+  static ns3::TypeId tid =
+      ns3::TypeId("applications::BurstSource")
+          .SetParent<ns3::Application>()
+          .SetGroupName("Applications")
+          .AddConstructor<BurstSource>()
+          .AddAttribute("Remote", "The address of the destination",
+                        ns3::AddressValue(),
+                        ns3::MakeAddressAccessor(&BurstSource::_remote),
+                        ns3::MakeAddressChecker())
+          .AddAttribute("Protocol", "The type id of the protocol to use",
+                        ns3::TypeIdValue(ns3::UdpSocketFactory::GetTypeId()),
+                        ns3::MakeTypeIdAccessor(&BurstSource::_protocol),
+                        ns3::MakeTypeIdChecker())
+          .AddAttribute("DataRate", "Average offered load",
+                        ns3::DataRateValue(ns3::DataRate("1Gb/s")),
+                        ns3::MakeDataRateAccessor(&BurstSource::_rate),
+                        ns3::MakeDataRateChecker())
+          .AddAttribute("PacketSize", "The size of packets sent in bursts",
+                        ns3::UintegerValue(1000),
+                        ns3::MakeUintegerAccessor(&BurstSource::_packet_size),
+                        ns3::MakeUintegerChecker<std::uint32_t>(1))
+          .AddAttribute(
+              "BurstSize", "Number of packets in a burst",
+              ns3::StringValue("ns3::ConstantRandomVariable[Constant=16]"),
+              ns3::MakePointerAccessor(&BurstSource::_burst_size),
+              ns3::MakePointerChecker<ns3::RandomVariableStream>())
+          .AddAttribute(
+              "InterBurst",
+              "Multiplier of the nominal gap between bursts, mean 1 keeps "
+              "DataRate",
+              ns3::StringValue("ns3::ConstantRandomVariable[Constant=1]"),
+              ns3::MakePointerAccessor(&BurstSource::_inter_burst),
+              ns3::MakePointerChecker<ns3::RandomVariableStream>())
+          .AddAttribute("MaxBytes",
+                        "The total number of bytes to send, 0 is unlimited",
+                        ns3::UintegerValue(0),
+                        ns3::MakeUintegerAccessor(&BurstSource::_max_bytes),
+                        ns3::MakeUintegerChecker<std::uint64_t>())
+          .AddAttribute("Timestamp",
+                        "Add TimestampTag with send time to every packet",
+                        ns3::BooleanValue(true),
+                        ns3::MakeBooleanAccessor(&BurstSource::_timestamp),
+                        ns3::MakeBooleanChecker())
+          .AddTraceSource("Tx", "A new packet is created and is sent",
+                          ns3::MakeTraceSourceAccessor(&BurstSource::_tx_trace),
+                          "ns3::Packet::TracedCallback");
+  return tid;
+}
+
+auto BurstSource::AssignStreams(std::int64_t stream) -> std::int64_t {
+  _burst_size->SetStream(stream);
+  _inter_burst->SetStream(stream + 1);
+  return 2;
+}
+
+void BurstSource::DoDispose() {
+  _socket = nullptr;
+  ns3::Application::DoDispose();
+}
+
+void BurstSource::StartApplication() {
+  if (_rate.GetBitRate() == 0) {
+    NS_FATAL_ERROR("DataRate must be positive");
+  }
+
+  if (_socket == nullptr) {
+    _socket = ns3::Socket::CreateSocket(GetNode(), _protocol);
+
+    int bound = -1;
+    if (ns3::Inet6SocketAddress::IsMatchingType(_remote)) {
+      bound = _socket->Bind6();
+    } else if (ns3::InetSocketAddress::IsMatchingType(_remote)) {
+      bound = _socket->Bind();
+    }
+    if (bound == -1) {
+      NS_FATAL_ERROR("Failed to bind socket");
+    }
+
+    _socket->Connect(_remote);
+    _socket->SetAllowBroadcast(true);
+    _socket->ShutdownRecv();
+  }
+
+  _send_event = ns3::Simulator::ScheduleNow(&BurstSource::SendBurst, this);
+}
+
+void BurstSource::StopApplication() {
+  ns3::Simulator::Cancel(_send_event);
+  if (_socket != nullptr) {
+    _socket->Close();
+  }
+}
+
+void BurstSource::SendBurst() {
+  auto packets = static_cast<std::uint32_t>(
+      std::max(1.0, std::round(_burst_size->GetValue())));
+  if (_max_bytes > 0) {
+    auto left = (_max_bytes - _total_bytes + _packet_size - 1) / _packet_size;
+    packets =
+        static_cast<std::uint32_t>(std::min<std::uint64_t>(packets, left));
+  }
+
+  TimestampTag tag{ns3::Simulator::Now()};
+  for (std::uint32_t i = 0; i < packets; ++i) {
+    auto packet = ns3::Create<ns3::Packet>(_packet_size);
+    if (_timestamp) {
+      packet->AddByteTag(tag);
+    }
+
+    _tx_trace(packet);
+    if (_socket->Send(packet) < 0) {
+      ++_dropped;
+    }
+    _total_bytes += _packet_size;
+  }
+
+  if (_max_bytes > 0 && _total_bytes >= _max_bytes) {
+    return;
+  }
+
+  // Gap keeps the average rate for the burst just sent
+  auto nominal_gap =
+      _rate.CalculateBytesTxTime(std::uint64_t{packets} * _packet_size);
+  auto gap = ns3::Seconds(nominal_gap.GetSeconds() *
+                          std::max(0.0, _inter_burst->GetValue()));
+  _send_event = ns3::Simulator::Schedule(gap, &BurstSource::SendBurst, this);
+}
+
+}  // namespace applications
@@ -0,0 +1,77 @@
+#ifndef __BURST_SOURCE_H_N8E4RJ2TYW5K__
+#define __BURST_SOURCE_H_N8E4RJ2TYW5K__
+
+#include <cstdint>
+
+#include <ns3/address.h>
+#include <ns3/application.h>
+#include <ns3/data-rate.h>
+#include <ns3/event-id.h>
+#include <ns3/packet.h>
+#include <ns3/ptr.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/socket.h>
+#include <ns3/traced-callback.h>
+#include <ns3/type-id.h>
+
+namespace applications {
+
+/**
+ * @brief Traffic source sending packet trains with one event per burst
+ *
+ * All packets of a burst are passed to the socket at once, the device queue
+ * spaces them at link rate. The gap between burst starts is the nominal gap,
+ * burst size divided by DataRate, multiplied by a sample of InterBurst, so
+ * the average offered load is DataRate when InterBurst has mean 1.
+ */
+class BurstSource final : public ns3::Application {
+ public:
+  static auto GetTypeId() -> ns3::TypeId;
+
+  BurstSource() = default;
+
+  /**
+   * @brief Assign fixed random streams to random variables
+   *
+   * @param stream first stream index
+   * @return std::int64_t number of assigned streams
+   */
+  auto AssignStreams(std::int64_t stream) -> std::int64_t;
+
+  auto GetTotalTx() const -> std::uint64_t { return _total_bytes; }
+
+  /**
+   * @brief Number of packets refused by the socket
+   *
+   */
+  auto GetDropped() const -> std::uint64_t { return _dropped; }
+
+ protected:
+  void DoDispose() override;
+
+ private:
+  void StartApplication() override;
+  void StopApplication() override;
+
+  void SendBurst();
+
+  ns3::Address _remote;
+  ns3::TypeId _protocol;
+  ns3::DataRate _rate;
+  std::uint32_t _packet_size = 0;
+  std::uint64_t _max_bytes = 0;
+  bool _timestamp = true;
+  ns3::Ptr<ns3::RandomVariableStream> _burst_size;
+  ns3::Ptr<ns3::RandomVariableStream> _inter_burst;
+
+  ns3::Ptr<ns3::Socket> _socket;
+  ns3::EventId _send_event;
+  std::uint64_t _total_bytes = 0;
+  std::uint64_t _dropped = 0;
+
+  ns3::TracedCallback<ns3::Ptr<const ns3::Packet>> _tx_trace;
+};
+
+}  // namespace applications
+
+#endif  // __BURST_SOURCE_H_N8E4RJ2TYW5K__
@@ -0,0 +1,229 @@
+#include "latency_sink.h"
+
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+#include <ns3/enum.h>
+#include <ns3/fatal-error.h>
+#include <ns3/names.h>
+#include <ns3/node.h>
+#include <ns3/packet.h>
+#include <ns3/seq-ts-header.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/udp-socket-factory.h>
+
+#include <fmt/core.h>
+
+#include "applications/timestamp_tag.h"
+
+namespace applications {
+
+namespace {
+constexpr std::array<double, 4> reported_quantiles = {0.5, 0.9, 0.99, 0.999};
+}  // namespace
+
+NS_OBJECT_ENSURE_REGISTERED(LatencySink);
+
+auto LatencySink::GetTypeId() -> ns3::TypeId {
+  static ns3::TypeId tid =
+      ns3::TypeId("applications::LatencySink")
+          .SetParent<ns3::Application>()
+          .SetGroupName("Applications")
+          .AddConstructor<LatencySink>()
+          .AddAttribute("Local", "The address on which to bind the socket",
+                        ns3::AddressValue(),
+                        ns3::MakeAddressAccessor(&LatencySink::_local),
+                        ns3::MakeAddressChecker())
+          .AddAttribute("Protocol", "The type id of the protocol to use",
+                        ns3::TypeIdValue(ns3::UdpSocketFactory::GetTypeId()),
+                        ns3::MakeTypeIdAccessor(&LatencySink::_protocol),
+                        ns3::MakeTypeIdChecker())
+          .AddAttribute("Output",
+                        "CSV file for summary, printed to stdout if empty",
+                        ns3::StringValue(""),
+                        ns3::MakeStringAccessor(&LatencySink::_output),
+                        ns3::MakeStringChecker())
+          .AddAttribute(
+              "Timestamp",
+              "Source of send time: TimestampTag or SeqTsHeader at the "
+              "beginning of each received packet",
+              ns3::EnumValue(TAG),
+              ns3::MakeEnumAccessor(&LatencySink::_timestamp),
+              ns3::MakeEnumChecker(TAG, "Tag", SEQ_TS_HEADER, "SeqTsHeader"));
+  return tid;
+}
+
+auto LatencySink::GetLatency(double quantile) const -> ns3::Time {
+  if (_latency.count() == 0) {
+    return {};
+  }
+  return ns3::Seconds(_latency.quantile(quantile));
+}
+
+void LatencySink::Report() {
+  if (_reported) {
+    return;
+  }
+  _reported = true;
+
+  if (_output.empty()) {
+    WriteText(std::cout);
+    return;
+  }
+
+  std::ofstream out{_output};
+  if (!out) {
+    std::cerr << fmt::format("Error: can't write latency summary to \"{}\"\n",
+                             _output);
+    return;
+  }
+  WriteCsv(out);
+}
+
+void LatencySink::DoDispose() {
+  _socket = nullptr;
+  _accepted.clear();
+  ns3::Application::DoDispose();
+}
+
+void LatencySink::StartApplication() {
+  if (_socket == nullptr) {
+    _socket = ns3::Socket::CreateSocket(GetNode(), _protocol);
+    if (_socket->Bind(_local) == -1) {
+      NS_FATAL_ERROR("Failed to bind socket");
+    }
+    _socket->Listen();
+    _socket->ShutdownSend();
+  }
+
+  _socket->SetRecvCallback(ns3::MakeCallback(&LatencySink::HandleRead, this));
+  _socket->SetAcceptCallback(
+      ns3::MakeNullCallback<bool, ns3::Ptr<ns3::Socket>,
+                            const ns3::Address &>(),
+      ns3::MakeCallback(&LatencySink::HandleAccept, this));
+}
+
+void LatencySink::StopApplication() {
+  for (const auto &socket : _accepted) {
+    socket->Close();
+  }
+  _accepted.clear();
+
+  if (_socket != nullptr) {
+    _socket->Close();
+    _socket->SetRecvCallback(
+        ns3::MakeNullCallback<void, ns3::Ptr<ns3::Socket>>());
+  }
+
+  Report();
+}
+
+void LatencySink::HandleAccept(ns3::Ptr<ns3::Socket> socket,
+                               const ns3::Address & /*from*/) {
+  socket->SetRecvCallback(ns3::MakeCallback(&LatencySink::HandleRead, this));
+  _accepted.push_back(socket);
+}
+
+void LatencySink::HandleRead(ns3::Ptr<ns3::Socket> socket) {
+  ns3::Address from;
+  while (auto packet = socket->RecvFrom(from)) {
+    if (packet->GetSize() == 0) {
+      break;
+    }
+    Receive(packet);
+  }
+}
+
+void LatencySink::Receive(const ns3::Ptr<ns3::Packet> &packet) {
+  auto now = ns3::Simulator::Now();
+  if (_received == 0) {
+    _first_rx = now;
+  }
+  _last_rx = now;
+  ++_received;
+  _bytes += packet->GetSize();
+
+  bool timed = false;
+  ns3::Time sent;
+  if (_timestamp == TAG) {
+    TimestampTag tag;
+    timed = packet->FindFirstMatchingByteTag(tag);
+    sent = tag.time();
+  } else if (packet->GetSize() >= ns3::SeqTsHeader{}.GetSerializedSize()) {
+    ns3::SeqTsHeader header;
+    packet->PeekHeader(header);
+    timed = true;
+    sent = header.GetTs();
+  }
+
+  if (!timed) {
+    ++_untimed;
+    return;
+  }
+
+  auto latency = (now - sent).GetSeconds();
+  _latency.add(latency);
+  _latency_sum += latency;
+}
+
+void LatencySink::WriteCsv(std::ostream &out) const {
+  out << "packets,bytes,untimed,throughput,latency_min,latency_mean";
+  for (auto quantile : reported_quantiles) {
+    out << fmt::format(",latency_p{}", quantile * 100);
+  }
+  out << ",latency_max\n";
+
+  auto duration = (_last_rx - _first_rx).GetSeconds();
+  auto throughput = duration > 0 ? static_cast<double>(_bytes) * 8 / duration
+                                 : 0.0;
+  auto count = _latency.count();
+
+  out << fmt::format("{},{},{},{},{},{}", _received, _bytes, _untimed,
+                     throughput, _latency.quantile(0),
+                     count > 0 ? _latency_sum / static_cast<double>(count)
+                               : std::nan(""));
+  for (auto quantile : reported_quantiles) {
+    out << fmt::format(",{}", _latency.quantile(quantile));
+  }
+  out << fmt::format(",{}\n", _latency.quantile(1));
+}
+
+void LatencySink::WriteText(std::ostream &out) const {
+  auto name = ns3::Names::FindName(GetNode());
+  if (name.empty()) {
+    name = fmt::format("node {}", GetNode()->GetId());
+  }
+
+  auto duration = (_last_rx - _first_rx).GetSeconds();
+  auto throughput = duration > 0 ? static_cast<double>(_bytes) * 8 / duration
+                                 : 0.0;
+
+  out << fmt::format(
+      "LatencySink on {}: {} packets, {} bytes, {:.3f} Mbit/s\n", name,
+      _received, _bytes, throughput / 1e6);
+
+  auto count = _latency.count();
+  if (count == 0) {
+    out << "  no timestamped packets\n";
+    return;
+  }
+
+  constexpr double ms = 1e3;
+  out << fmt::format("  latency, ms: min {:.3f}, mean {:.3f}",
+                     _latency.quantile(0) * ms,
+                     _latency_sum / static_cast<double>(count) * ms);
+  for (auto quantile : reported_quantiles) {
+    out << fmt::format(", p{} {:.3f}", quantile * 100,
+                       _latency.quantile(quantile) * ms);
+  }
+  out << fmt::format(", max {:.3f}\n", _latency.quantile(1) * ms);
+
+  if (_untimed > 0) {
+    out << fmt::format("  {} packets without timestamp\n", _untimed);
+  }
+}
+
+}  // namespace applications
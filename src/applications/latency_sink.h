@@ -0,0 +1,93 @@
+#ifndef __LATENCY_SINK_H_H1V6PD3MZR8C__
+#define __LATENCY_SINK_H_H1V6PD3MZR8C__
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <ns3/address.h>
+#include <ns3/application.h>
+#include <ns3/nstime.h>
+#include <ns3/ptr.h>
+#include <ns3/socket.h>
+#include <ns3/type-id.h>
+
+#include "stats/histogram.h"
+
+namespace applications {
+
+/**
+ * @brief Packet sink collecting latency histogram and throughput in memory
+ *
+ * Latency of each received packet is the difference between receive time and
+ * send time from TimestampTag or ns3::SeqTsHeader. Summary is written once,
+ * when the application is stopped or the simulation is finished.
+ */
+class LatencySink final : public ns3::Application {
+ public:
+  enum timestamp_source { TAG, SEQ_TS_HEADER };
+
+  static auto GetTypeId() -> ns3::TypeId;
+
+  LatencySink() = default;
+
+  /**
+   * @brief Total received bytes
+   *
+   */
+  auto GetTotalRx() const -> std::uint64_t { return _bytes; }
+
+  auto GetReceived() const -> std::uint64_t { return _received; }
+
+  /**
+   * @brief Estimate latency quantile
+   *
+   * @param quantile quantile in [0, 1]
+   * @return ns3::Time zero if no timestamped packets were received
+   */
+  auto GetLatency(double quantile) const -> ns3::Time;
+
+  /**
+   * @brief Write summary to Output file or stdout, only the first call has
+   * effect
+   *
+   */
+  void Report();
+
+ protected:
+  void DoDispose() override;
+
+ private:
+  void StartApplication() override;
+  void StopApplication() override;
+
+  void HandleAccept(ns3::Ptr<ns3::Socket> socket, const ns3::Address &from);
+  void HandleRead(ns3::Ptr<ns3::Socket> socket);
+
+  void Receive(const ns3::Ptr<ns3::Packet> &packet);
+
+  void WriteCsv(std::ostream &out) const;
+  void WriteText(std::ostream &out) const;
+
+  ns3::Address _local;
+  ns3::TypeId _protocol;
+  std::string _output;
+  timestamp_source _timestamp = TAG;
+
+  ns3::Ptr<ns3::Socket> _socket;
+  std::vector<ns3::Ptr<ns3::Socket>> _accepted;
+
+  stats::Histogram _latency;
+  double _latency_sum = 0;
+  std::uint64_t _received = 0;
+  std::uint64_t _untimed = 0;
+  std::uint64_t _bytes = 0;
+  ns3::Time _first_rx;
+  ns3::Time _last_rx;
+  bool _reported = false;
+};
+
+}  // namespace applications
+
+#endif  // __LATENCY_SINK_H_H1V6PD3MZR8C__
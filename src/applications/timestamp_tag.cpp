@@ -0,0 +1,35 @@
+#include "timestamp_tag.h"
+
+namespace applications {
+
+NS_OBJECT_ENSURE_REGISTERED(TimestampTag);
+
+auto TimestampTag::GetTypeId() -> ns3::TypeId {
+  static ns3::TypeId tid = ns3::TypeId("applications::TimestampTag")
+                               .SetParent<ns3::Tag>()
+                               .SetGroupName("Applications")
+                               .AddConstructor<TimestampTag>();
+  return tid;
+}
+
+auto TimestampTag::GetInstanceTypeId() const -> ns3::TypeId {
+  return GetTypeId();
+}
+
+auto TimestampTag::GetSerializedSize() const -> std::uint32_t {
+  return sizeof(_time);
+}
+
+void TimestampTag::Serialize(ns3::TagBuffer buffer) const {
+  buffer.WriteU64(static_cast<std::uint64_t>(_time));
+}
+
+void TimestampTag::Deserialize(ns3::TagBuffer buffer) {
+  _time = static_cast<std::int64_t>(buffer.ReadU64());
+}
+
+void TimestampTag::Print(std::ostream &out) const {
+  out << "time=" << time().As(ns3::Time::S);
+}
+
+}  // namespace applications
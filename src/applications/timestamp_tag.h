@@ -0,0 +1,42 @@
+#ifndef __TIMESTAMP_TAG_H_B7F2LW4XQK9N__
+#define __TIMESTAMP_TAG_H_B7F2LW4XQK9N__
+
+#include <cstdint>
+#include <ostream>
+
+#include <ns3/nstime.h>
+#include <ns3/object-base.h>
+#include <ns3/tag-buffer.h>
+#include <ns3/tag.h>
+#include <ns3/type-id.h>
+
+namespace applications {
+
+/**
+ * @brief Send time of packet, added by traffic sources as byte tag
+ *
+ * Byte tag keeps the time of each sent chunk of data across fragmentation
+ * and TCP segmentation.
+ */
+class TimestampTag final : public ns3::Tag {
+ public:
+  static auto GetTypeId() -> ns3::TypeId;
+
+  TimestampTag() = default;
+  explicit TimestampTag(const ns3::Time &time) : _time{time.GetTimeStep()} {}
+
+  auto GetInstanceTypeId() const -> ns3::TypeId override;
+  auto GetSerializedSize() const -> std::uint32_t override;
+  void Serialize(ns3::TagBuffer buffer) const override;
+  void Deserialize(ns3::TagBuffer buffer) override;
+  void Print(std::ostream &out) const override;
+
+  auto time() const -> ns3::Time { return ns3::TimeStep(_time); }
+
+ private:
+  std::int64_t _time = 0;
+};
+
+}  // namespace applications
+
+#endif  // __TIMESTAMP_TAG_H_B7F2LW4XQK9N__
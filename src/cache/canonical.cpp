@@ -0,0 +1,207 @@
+#include "canonical.h"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include "parser/parser.h"
+
+namespace cache {
+
+namespace {
+/**
+ * @brief Writer of fields in unambiguous text form
+ *
+ */
+class Canonical {
+ public:
+  auto str() && -> std::string { return std::move(_out); }
+
+  void put(std::string_view value) {
+    _out += fmt::format("{}:", value.size());
+    _out += value;
+    _out += ';';
+  }
+
+  void put(const char *value) { put(std::string_view{value}); }
+
+  void put(const std::string &value) { put(std::string_view{value}); }
+
+  template <typename T, std::enable_if_t<std::is_arithmetic_v<T> ||
+                                             std::is_enum_v<T>,
+                                         bool> = true>
+  void put(T value) {
+    if constexpr (std::is_enum_v<T>) {
+      _out += fmt::format("{};", static_cast<std::int64_t>(value));
+    } else if constexpr (std::is_floating_point_v<T>) {
+      // Shortest form which is read back to the same value
+      _out += fmt::format("{};", value);
+    } else {
+      _out += fmt::format("{};", +value);
+    }
+  }
+
+  void put(const address::network_v4 &network) { put(network.to_string()); }
+
+  void put(const address::network_v6 &network) { put(network.to_string()); }
+
+  void put(const address::address_v4 &address) { put(address.to_string()); }
+
+  template <typename T>
+  void put(const std::optional<T> &value) {
+    put(value.has_value());
+    if (value.has_value()) {
+      put(*value);
+    }
+  }
+
+  template <typename T>
+  void put(const std::vector<T> &values) {
+    put(values.size());
+    for (const auto &value : values) {
+      put(value);
+    }
+  }
+
+  void put(const parser::Attributes &attributes) {
+    put(attributes.size());
+    for (const auto &[key, value] : attributes) {
+      put(key);
+      put(value);
+    }
+  }
+
+  void put(const parser::CaptureDescription &capture) {
+    put(capture.file);
+    put(capture.protocol);
+    put(capture.port);
+    put(capture.sample);
+    put(capture.snap_length);
+  }
+
+  void put(const parser::DeviceDescription &device) {
+    put(device.name);
+    put(device.type);
+    put(device.ipv4_addresses);
+    put(device.ipv6_addresses);
+    put(device.attributes);
+    put(device.capture);
+  }
+
+  void put(const parser::ApplicationDescription &application) {
+    put(application.name);
+    put(application.type);
+    put(application.attributes);
+  }
+
+  template <typename Route>
+  auto put(const Route &route)
+      -> decltype(route.network, route.metric, void()) {
+    put(route.network);
+    put(route.interface);
+    put(route.metric);
+  }
+
+  void put(const parser::NodeDescription &node) {
+    put(node.name);
+    put(node.devices);
+    put(node.applications);
+    put(node.routing.ipv4);
+    put(node.routing.ipv6);
+  }
+
+  void put(const parser::ConnectionDescription &connection) {
+    put(connection.name);
+    put(connection.type);
+    put(connection.interfaces);
+    put(connection.attributes);
+  }
+
+  void put(const stats::Statistic &statistic) {
+    put(statistic.kind);
+    put(statistic.quantile);
+    put(statistic.name);
+  }
+
+  void put(const parser::RegistratorDescription &registrator) {
+    put(registrator.source);
+    put(registrator.type);
+    put(registrator.sink);
+    put(registrator.value_name);
+    put(registrator.file);
+    put(registrator.start_time);
+    put(registrator.end_time);
+    put(registrator.format);
+    put(registrator.window);
+    put(registrator.statistics);
+    put(registrator.decimate);
+    put(registrator.min_interval);
+    put(registrator.compress);
+  }
+
+  void put(const parser::PolledValueDescription &value) {
+    put(value.name);
+    put(value.object);
+    put(value.attribute);
+    put(value.getter);
+  }
+
+  void put(const parser::PollerDescription &poller) {
+    put(poller.file);
+    put(poller.period);
+    put(poller.start_time);
+    put(poller.end_time);
+    put(poller.format);
+    put(poller.compress);
+    put(poller.values);
+  }
+
+  void put(const parser::StatisticsDescription &statistics) {
+    put(statistics.async);
+    put(statistics.queue_size);
+    put(statistics.overflow);
+    put(statistics.container);
+    put(statistics.compress);
+    put(statistics.live);
+    put(statistics.live_capacity);
+  }
+
+  void put(const parser::BackgroundFlowDescription &flow) {
+    put(flow.name);
+    put(flow.source);
+    put(flow.destination);
+    put(flow.rate);
+    put(flow.packet_size);
+    put(flow.start_time);
+    put(flow.end_time);
+  }
+
+ private:
+  std::string _out;
+};
+}  // namespace
+
+auto canonical(const parser::ModelDescription &description) -> std::string {
+  Canonical out;
+  out.put(description.model_name);
+  out.put(description.polulate_tables);
+  out.put(description.populate_neighbor_cache);
+  out.put(description.end_time);
+  out.put(description.time_precision);
+  out.put(description.nodes);
+  out.put(description.connections);
+  out.put(description.registrators);
+  out.put(description.pollers);
+  out.put(description.statistics);
+  out.put(description.background.mode);
+  out.put(description.background.flows);
+  return std::move(out).str();
+}
+
+}  // namespace cache
@@ -0,0 +1,24 @@
+#ifndef __CANONICAL_H_M1GX6RD9WF3K__
+#define __CANONICAL_H_M1GX6RD9WF3K__
+
+#include <string>
+
+namespace parser {
+struct ModelDescription;
+}
+
+namespace cache {
+
+/**
+ * @brief Text form of description, equal for equal descriptions
+ *
+ * Every field is written in declaration order, strings are prefixed by
+ * length, so different descriptions give different text. Order of nodes,
+ * attributes and other lists is kept, as it changes node indices and
+ * objects created by ns-3.
+ */
+auto canonical(const parser::ModelDescription &description) -> std::string;
+
+}  // namespace cache
+
+#endif  // __CANONICAL_H_M1GX6RD9WF3K__
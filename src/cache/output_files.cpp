@@ -0,0 +1,95 @@
+#include "output_files.h"
+
+#include <set>
+#include <string>
+#include <system_error>
+
+#include "parser/parser.h"
+
+namespace fs = std::filesystem;
+
+namespace cache {
+
+namespace {
+// Attribute of applications writing results to file
+constexpr auto output_attribute = "Output";
+
+constexpr auto latency_sink_type = "applications::LatencySink";
+}  // namespace
+
+auto written_files(const parser::ModelDescription &description,
+                   fs::file_time_type since) -> std::vector<fs::path> {
+  std::set<fs::path> prefixes;
+  for (const auto &registrator : description.registrators) {
+    prefixes.insert(registrator.file);
+  }
+  for (const auto &poller : description.pollers) {
+    prefixes.insert(poller.file);
+  }
+  for (const auto &node : description.nodes) {
+    for (const auto &device : node.devices) {
+      if (device.capture.has_value()) {
+        prefixes.insert(device.capture->file);
+      }
+    }
+    for (const auto &application : node.applications) {
+      if (auto output = application.attributes.find(output_attribute);
+          output != application.attributes.end() && !output->second.empty()) {
+        prefixes.insert(output->second);
+      }
+    }
+  }
+  if (description.statistics.container.has_value()) {
+    prefixes.insert(*description.statistics.container);
+  }
+
+  std::set<fs::path> files;
+  for (const auto &prefix : prefixes) {
+    auto directory = fs::absolute(prefix).parent_path();
+    auto name = prefix.filename().string();
+
+    std::error_code error;
+    for (const auto &entry : fs::directory_iterator{directory, error}) {
+      auto file = entry.path().filename().string();
+      if (!entry.is_regular_file(error) || file.rfind(name, 0) != 0) {
+        continue;
+      }
+
+      auto modified = entry.last_write_time(error);
+      if (!error && modified >= since) {
+        files.insert(entry.path());
+      }
+    }
+  }
+
+  return {files.begin(), files.end()};
+}
+
+bool prints_summary(const parser::ModelDescription &description) {
+  for (const auto &registrator : description.registrators) {
+    if (registrator.decimate > 1 || registrator.min_interval.has_value()) {
+      return true;
+    }
+  }
+
+  for (const auto &node : description.nodes) {
+    for (const auto &device : node.devices) {
+      if (device.capture.has_value()) {
+        return true;
+      }
+    }
+    for (const auto &application : node.applications) {
+      if (application.type != latency_sink_type) {
+        continue;
+      }
+      auto output = application.attributes.find(output_attribute);
+      if (output == application.attributes.end() || output->second.empty()) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+}  // namespace cache
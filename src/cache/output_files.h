@@ -0,0 +1,42 @@
+#ifndef __OUTPUT_FILES_H_T8VC4NE2PJ7A__
+#define __OUTPUT_FILES_H_T8VC4NE2PJ7A__
+
+#include <filesystem>
+#include <vector>
+
+namespace parser {
+struct ModelDescription;
+}
+
+namespace cache {
+
+/**
+ * @brief Files of registrators, pollers, captures, statistics container and
+ * applications (their Output attribute) written since the given time
+ *
+ * Writers add extensions and suffixes to configured names (".txt",
+ * ".bin.zst", ".pcapng", ".objects.txt"), so files are matched by prefix in
+ * directory of each output.
+ *
+ * @param description model, relative names are resolved against working
+ * directory
+ * @param since start of the run
+ * @return std::vector<std::filesystem::path> absolute paths in sorted order
+ */
+auto written_files(const parser::ModelDescription &description,
+                   std::filesystem::file_time_type since)
+    -> std::vector<std::filesystem::path>;
+
+/**
+ * @brief Whether run prints results, which are not in output files
+ *
+ * Latency sinks without Output file, captures and decimating registrators
+ * print summaries to stdout, restoring files of such run would lose them.
+ *
+ * @param description
+ */
+bool prints_summary(const parser::ModelDescription &description);
+
+}  // namespace cache
+
+#endif  // __OUTPUT_FILES_H_T8VC4NE2PJ7A__
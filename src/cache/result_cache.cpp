@@ -0,0 +1,299 @@
+#include "result_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <elf.h>
+#include <link.h>
+#include <unistd.h>
+
+#include <ns3/rng-seed-manager.h>
+
+#include <fmt/core.h>
+
+#include "cache/canonical.h"
+
+namespace fs = std::filesystem;
+
+namespace cache {
+
+namespace {
+constexpr auto key_file = "key";
+constexpr auto manifest_file = "manifest";
+
+// Temporary entries of crashed runs are removed after this time
+constexpr auto stale_temporary = std::chrono::hours{1};
+
+auto fnv1a(std::string_view text) -> std::uint64_t {
+  constexpr std::uint64_t offset = 14695981039346656037ULL;
+  constexpr std::uint64_t prime = 1099511628211ULL;
+
+  auto hash = offset;
+  for (auto c : text) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= prime;
+  }
+  return hash;
+}
+
+auto read_file(const fs::path &path) -> std::string {
+  std::ifstream in{path, std::ios::binary};
+  std::stringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+auto note_build_id(const dl_phdr_info &info) -> std::string {
+  std::string id;
+  for (std::size_t i = 0; i < info.dlpi_phnum; ++i) {
+    const auto &header = info.dlpi_phdr[i];  // NOLINT
+    if (header.p_type != PT_NOTE) {
+      continue;
+    }
+
+    // Notes are padded to alignment of their segment
+    std::size_t align = header.p_align == 8 ? 8 : 4;
+    auto padded = [align](std::size_t size) {
+      return (size + align - 1) / align * align;
+    };
+
+    // NOLINTNEXTLINE
+    const auto *notes = reinterpret_cast<const unsigned char *>(
+        info.dlpi_addr + header.p_vaddr);
+    std::size_t offset = 0;
+    while (offset + sizeof(ElfW(Nhdr)) <= header.p_memsz) {
+      ElfW(Nhdr) note;
+      std::memcpy(&note, notes + offset, sizeof(note));  // NOLINT
+      offset += sizeof(note);
+
+      const auto *name = notes + offset;  // NOLINT
+      const auto *desc = name + padded(note.n_namesz);  // NOLINT
+      if (note.n_type == NT_GNU_BUILD_ID && note.n_namesz == 4 &&
+          std::memcmp(name, "GNU", 4) == 0) {
+        for (std::size_t byte = 0; byte < note.n_descsz; ++byte) {
+          id += fmt::format("{:02x}", desc[byte]);  // NOLINT
+        }
+        return id;
+      }
+      offset += padded(note.n_namesz) + padded(note.n_descsz);
+    }
+  }
+  return id;
+}
+
+auto file_id(const fs::path &path) -> std::string {
+  std::error_code error;
+  auto size = fs::file_size(path, error);
+  auto modified = fs::last_write_time(path, error);
+  return fmt::format("{}:{}:{}", path.string(), size,
+                     modified.time_since_epoch().count());
+}
+
+auto collect_build_id(dl_phdr_info *info, std::size_t /*size*/, void *data)
+    -> int {
+  auto &ids = *static_cast<std::vector<std::string> *>(data);
+
+  std::string_view name = info->dlpi_name != nullptr ? info->dlpi_name : "";
+  // Virtual objects of the kernel don't affect results
+  if (name.rfind("linux-", 0) == 0) {
+    return 0;
+  }
+
+  auto id = note_build_id(*info);
+  if (id.empty()) {
+    // The executable has empty name
+    id = file_id(name.empty() ? fs::path{"/proc/self/exe"}
+                              : fs::path{std::string{name}});
+  }
+  ids.push_back(std::move(id));
+  return 0;
+}
+
+auto entry_size(const fs::path &entry) -> std::uintmax_t {
+  std::uintmax_t size = 0;
+  std::error_code error;
+  for (const auto &file : fs::recursive_directory_iterator{entry, error}) {
+    if (file.is_regular_file(error)) {
+      size += file.file_size(error);
+    }
+  }
+  return size;
+}
+
+/**
+ * @brief Path of file in manifest, relative if it's in working directory
+ *
+ */
+auto stored_path(const fs::path &file) -> fs::path {
+  auto relative = file.lexically_relative(fs::current_path());
+  if (relative.empty() || *relative.begin() == "..") {
+    return file;
+  }
+  return relative;
+}
+}  // namespace
+
+auto build_id() -> std::string {
+  std::vector<std::string> ids;
+  dl_iterate_phdr(collect_build_id, &ids);
+
+  std::sort(ids.begin(), ids.end());
+  std::string result;
+  for (const auto &id : ids) {
+    result += id;
+    result += ',';
+  }
+  return result;
+}
+
+ResultCache::ResultCache(fs::path directory, std::uintmax_t max_bytes)
+    : _directory(std::move(directory)), _max_bytes(max_bytes) {
+  std::error_code error;
+  fs::create_directories(_directory, error);
+  if (error) {
+    throw CacheError(fmt::format(R"(Can't create cache directory "{}": {})",
+                                 _directory.string(), error.message()));
+  }
+}
+
+auto ResultCache::key(const parser::ModelDescription &description) -> Key {
+  Key key;
+  key.text = fmt::format("{}\nseed={}\nrun={}\nbuild={}\n",
+                         canonical(description),
+                         ns3::RngSeedManager::GetSeed(),
+                         ns3::RngSeedManager::GetRun(), build_id());
+  key.hash = fmt::format("{:016x}", fnv1a(key.text));
+  return key;
+}
+
+auto ResultCache::restore(const Key &key) const
+    -> std::optional<std::vector<fs::path>> {
+  auto entry = _directory / key.hash;
+
+  std::error_code error;
+  // Entry of other key with the same hash is a miss
+  if (!fs::is_directory(entry, error) ||
+      read_file(entry / key_file) != key.text) {
+    return {};
+  }
+
+  std::vector<std::pair<fs::path, fs::path>> files;
+  std::ifstream manifest{entry / manifest_file};
+  std::string line;
+  while (std::getline(manifest, line)) {
+    auto space = line.find(' ');
+    if (space == std::string::npos) {
+      continue;
+    }
+    files.emplace_back(entry / line.substr(0, space), line.substr(space + 1));
+  }
+
+  try {
+    for (const auto &[stored, path] : files) {
+      if (path.has_parent_path()) {
+        fs::create_directories(path.parent_path());
+      }
+      fs::copy_file(stored, path, fs::copy_options::overwrite_existing);
+    }
+    // Order of eviction
+    fs::last_write_time(entry, fs::file_time_type::clock::now());
+  } catch (const fs::filesystem_error &e) {
+    throw CacheError(
+        fmt::format("Can't restore cached results: {}", e.what()));
+  }
+
+  std::vector<fs::path> restored;
+  for (auto &[stored, path] : files) {
+    restored.push_back(std::move(path));
+  }
+  return restored;
+}
+
+void ResultCache::store(const Key &key, const std::vector<fs::path> &files) {
+  auto entry = _directory / key.hash;
+  auto temporary =
+      _directory / fmt::format(".{}.{}", key.hash, ::getpid());
+
+  try {
+    fs::remove_all(temporary);
+    fs::create_directories(temporary);
+
+    std::ofstream{temporary / key_file, std::ios::binary} << key.text;
+
+    std::ofstream manifest{temporary / manifest_file};
+    for (std::size_t i = 0; i < files.size(); ++i) {
+      fs::copy_file(files[i], temporary / std::to_string(i));
+      manifest << i << ' ' << stored_path(files[i]).string() << '\n';
+    }
+    manifest.close();
+
+    // Readers see either old or complete new entry
+    fs::remove_all(entry);
+    std::error_code error;
+    fs::rename(temporary, entry, error);
+    if (error) {
+      // Entry was stored by a concurrent run
+      fs::remove_all(temporary);
+    }
+  } catch (const fs::filesystem_error &e) {
+    std::error_code error;
+    fs::remove_all(temporary, error);
+    throw CacheError(fmt::format("Can't store results: {}", e.what()));
+  }
+
+  evict();
+}
+
+void ResultCache::evict() const {
+  struct Entry {
+    fs::path path;
+    fs::file_time_type used;
+    std::uintmax_t size;
+  };
+
+  auto now = fs::file_time_type::clock::now();
+  std::vector<Entry> entries;
+  std::uintmax_t total = 0;
+
+  std::error_code error;
+  for (const auto &item : fs::directory_iterator{_directory, error}) {
+    if (!item.is_directory(error)) {
+      continue;
+    }
+
+    auto used = item.last_write_time(error);
+    if (item.path().filename().string().rfind('.', 0) == 0) {
+      if (now - used > stale_temporary) {
+        fs::remove_all(item.path(), error);
+      }
+      continue;
+    }
+
+    auto size = entry_size(item.path());
+    total += size;
+    entries.push_back({item.path(), used, size});
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](const auto &lhs, const auto &rhs) {
+              return lhs.used < rhs.used;
+            });
+  for (const auto &entry : entries) {
+    if (total <= _max_bytes) {
+      break;
+    }
+    fs::remove_all(entry.path, error);
+    total -= entry.size;
+  }
+}
+
+}  // namespace cache
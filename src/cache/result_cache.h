@@ -0,0 +1,94 @@
+#ifndef __RESULT_CACHE_H_H5ZB9PL3XQ6M__
+#define __RESULT_CACHE_H_H5ZB9PL3XQ6M__
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace parser {
+struct ModelDescription;
+}
+
+namespace cache {
+
+class CacheError : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Build IDs of the executable and loaded libraries
+ *
+ * GNU build ID notes identify binaries of ns-3 and the simulator, so a
+ * rebuilt or upgraded library changes the result. Objects without the
+ * note are identified by path, size and modification time.
+ */
+auto build_id() -> std::string;
+
+/**
+ * @brief Output files of previous runs stored in local directory
+ *
+ * Entry of run is a directory named by hash of its key with copies of
+ * written files and manifest of their paths. Paths inside working
+ * directory are stored relative to it, so results are restored to the
+ * working directory of the next run. Least recently used entries are
+ * removed when total size exceeds the limit.
+ */
+class ResultCache {
+ public:
+  /**
+   * @brief Identity of run
+   *
+   */
+  struct Key {
+    // Canonical description, seed and run of RNG and build ID
+    std::string text;
+    // Hex FNV-1a hash of text, name of entry directory
+    std::string hash;
+  };
+
+  /**
+   * @brief Open cache directory, it is created if absent
+   *
+   * @param directory
+   * @param max_bytes limit of total size of stored files
+   * @throws CacheError if directory can't be created
+   */
+  ResultCache(std::filesystem::path directory, std::uintmax_t max_bytes);
+
+  /**
+   * @brief Key of run of description with current RNG seed and run
+   *
+   */
+  static auto key(const parser::ModelDescription &description) -> Key;
+
+  /**
+   * @brief Copy files of run with the key to their places
+   *
+   * @return std::optional<std::vector<std::filesystem::path>> restored
+   * files, empty on miss
+   */
+  auto restore(const Key &key) const
+      -> std::optional<std::vector<std::filesystem::path>>;
+
+  /**
+   * @brief Store files written by run with the key and evict old entries
+   *
+   * @param key
+   * @param files written files, absolute paths
+   */
+  void store(const Key &key, const std::vector<std::filesystem::path> &files);
+
+ private:
+  void evict() const;
+
+  std::filesystem::path _directory;
+  std::uintmax_t _max_bytes;
+};
+
+}  // namespace cache
+
+#endif  // __RESULT_CACHE_H_H5ZB9PL3XQ6M__
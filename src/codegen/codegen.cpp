@@ -0,0 +1,820 @@
+#include "codegen.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ns3/address.h>
+#include <ns3/attribute.h>
+#include <ns3/boolean.h>
+#include <ns3/csma-channel.h>
+#include <ns3/csma-net-device.h>
+#include <ns3/data-rate.h>
+#include <ns3/double.h>
+#include <ns3/enum.h>
+#include <ns3/inet-socket-address.h>
+#include <ns3/integer.h>
+#include <ns3/ipv4-address.h>
+#include <ns3/ipv6-address.h>
+#include <ns3/mac48-address.h>
+#include <ns3/nstime.h>
+#include <ns3/point-to-point-channel.h>
+#include <ns3/point-to-point-net-device.h>
+#include <ns3/simple-net-device.h>
+#include <ns3/string.h>
+#include <ns3/type-id.h>
+#include <ns3/uinteger.h>
+
+#include <fmt/core.h>
+
+#include "model/application.h"
+#include "model/channel.h"
+#include "model/device.h"
+#include "model/ideal_channel.h"
+#include "parser/parser.h"
+#include "utils/address.h"
+
+namespace codegen {
+
+namespace {
+// Nodes, connections, registrators, pollers or flows added by one generated
+// function
+constexpr std::size_t chunk_size = 256;
+
+template <typename T>
+constexpr std::string_view enum_name{};
+template <>
+constexpr std::string_view enum_name<ns3::Time::Unit> = "ns3::Time::Unit";
+template <>
+constexpr std::string_view enum_name<model::device_type> =
+    "model::device_type";
+template <>
+constexpr std::string_view enum_name<model::channel_type> =
+    "model::channel_type";
+template <>
+constexpr std::string_view enum_name<model::background_mode> =
+    "model::background_mode";
+template <>
+constexpr std::string_view enum_name<stats::capture_protocol> =
+    "stats::capture_protocol";
+template <>
+constexpr std::string_view enum_name<stats::output_format> =
+    "stats::output_format";
+template <>
+constexpr std::string_view enum_name<stats::overflow_policy> =
+    "stats::overflow_policy";
+template <>
+constexpr std::string_view enum_name<stats::compression> =
+    "stats::compression";
+template <>
+constexpr std::string_view enum_name<stats::statistic_kind> =
+    "stats::statistic_kind";
+
+auto join(const std::vector<std::string> &values) -> std::string {
+  std::string out;
+  for (const auto &value : values) {
+    if (!out.empty()) {
+      out += ", ";
+    }
+    out += value;
+  }
+  return out;
+}
+
+// Containers of structures are written before the structures
+auto literal(const stats::Statistic &statistic) -> std::string;
+auto literal(const parser::PolledValueDescription &value) -> std::string;
+auto literal(const address::network_v4 &network) -> std::string;
+auto literal(const address::network_v6 &network) -> std::string;
+
+/**
+ * @brief C++ expressions of description values
+ *
+ * Structures are written as aggregate initializers with fields in order of
+ * declaration.
+ */
+auto literal(std::string_view value) -> std::string {
+  constexpr unsigned char first_printable = 0x20;
+  constexpr unsigned char last_printable = 0x7e;
+
+  std::string out = "\"";
+  for (auto symbol : value) {
+    auto code = static_cast<unsigned char>(symbol);
+    if (symbol == '"' || symbol == '\\') {
+      out += '\\';
+      out += symbol;
+    } else if (code < first_printable || code > last_printable) {
+      // Octal escape has at most 3 digits, so it can't absorb next symbol
+      out += fmt::format("\\{:03o}", code);
+    } else {
+      out += symbol;
+    }
+  }
+  out += '"';
+  return out;
+}
+
+auto literal(const std::string &value) -> std::string {
+  return literal(std::string_view{value});
+}
+
+template <typename T, std::enable_if_t<std::is_arithmetic_v<T> ||
+                                           std::is_enum_v<T>,
+                                       bool> = true>
+auto literal(T value) -> std::string {
+  if constexpr (std::is_same_v<T, bool>) {
+    return value ? "true" : "false";
+  } else if constexpr (std::is_enum_v<T>) {
+    static_assert(!enum_name<T>.empty(), "Unknown enum of description");
+    return fmt::format("static_cast<{}>({})", enum_name<T>,
+                       static_cast<std::int64_t>(value));
+  } else if constexpr (std::is_floating_point_v<T>) {
+    // Shortest form which is read back to the same value
+    return fmt::format("{}", value);
+  } else {
+    return fmt::format("{}", +value);
+  }
+}
+
+auto literal(const address::address_v4 &address) -> std::string {
+  return fmt::format("address::address_v4{{{:#010x}U}}", address.to_uint());
+}
+
+template <typename T>
+auto literal(const std::optional<T> &value) -> std::string {
+  return value.has_value() ? literal(*value) : "std::nullopt";
+}
+
+template <typename T>
+auto literal(const std::vector<T> &values) -> std::string {
+  std::vector<std::string> items;
+  items.reserve(values.size());
+  for (const auto &value : values) {
+    items.push_back(literal(value));
+  }
+  return fmt::format("{{{}}}", join(items));
+}
+
+template <typename... Fields>
+auto fields(const Fields &...values) -> std::string {
+  return fmt::format("{{{}}}", join({literal(values)...}));
+}
+
+auto literal(const stats::Statistic &statistic) -> std::string {
+  return fields(statistic.kind, statistic.quantile, statistic.name);
+}
+
+auto literal(const parser::RegistratorDescription &registrator)
+    -> std::string {
+  return fields(registrator.source, registrator.type, registrator.sink,
+                registrator.value_name, registrator.file,
+                registrator.start_time, registrator.end_time,
+                registrator.format, registrator.window,
+                registrator.statistics, registrator.decimate,
+                registrator.min_interval, registrator.compress);
+}
+
+auto literal(const parser::PolledValueDescription &value) -> std::string {
+  return fields(value.name, value.object, value.attribute, value.getter);
+}
+
+auto literal(const parser::PollerDescription &poller) -> std::string {
+  return fields(poller.file, poller.period, poller.start_time,
+                poller.end_time, poller.format, poller.compress,
+                poller.values);
+}
+
+auto literal(const parser::StatisticsDescription &statistics)
+    -> std::string {
+  return "parser::StatisticsDescription" +
+         fields(statistics.async, statistics.queue_size, statistics.overflow,
+                statistics.container, statistics.compress, statistics.live,
+                statistics.live_capacity);
+}
+
+auto literal(const parser::BackgroundFlowDescription &flow) -> std::string {
+  return fields(flow.name, flow.source, flow.destination, flow.rate,
+                flow.packet_size, flow.start_time, flow.end_time);
+}
+
+auto literal(const parser::CaptureDescription &capture) -> std::string {
+  return "parser::CaptureDescription" +
+         fields(capture.file, capture.protocol, capture.port, capture.sample,
+                capture.snap_length);
+}
+
+auto literal(const ns3::Ipv4Address &address) -> std::string {
+  return fmt::format("ns3::Ipv4Address{{{:#010x}U}}", address.Get());
+}
+
+auto literal(const address::network_v4 &network) -> std::string {
+  return fmt::format(
+      "ns3::Ipv4InterfaceAddress{{{}, ns3::Ipv4Mask{{{:#010x}U}}}}",
+      literal(address::to_ns3_v4(network.address())),
+      network.netmask().to_uint());
+}
+
+auto literal(const address::network_v6 &network) -> std::string {
+  return fmt::format(
+      "ns3::Ipv6InterfaceAddress{{ns3::Ipv6Address{{{}}}, "
+      "ns3::Ipv6Prefix{{{}}}}}",
+      literal(network.address().to_string()), network.prefix_length());
+}
+
+/**
+ * @brief C++ expression of attribute value of its own type
+ *
+ * Values of other types, e.g. queues and socket factories, are written as
+ * StringValue and parsed by ns-3 in the generated program.
+ *
+ * @throws CodegenError if attribute is unknown or value is invalid
+ */
+auto attribute_value(const ns3::TypeId &type, const std::string &name,
+                     const std::string &value, const std::string &owner)
+    -> std::string {
+  ns3::TypeId::AttributeInformation info;
+  ns3::Ptr<ns3::AttributeValue> parsed;
+  if (type.LookupAttributeByName(name, &info)) {
+    parsed = info.checker->CreateValidValue(ns3::StringValue{value});
+  }
+
+  if (parsed == nullptr) {
+    throw CodegenError(
+        fmt::format(R"(Bad attribute "{}" with value "{}" of "{}")", name,
+                    value, owner));
+  }
+
+  if (auto typed = ns3::DynamicCast<ns3::UintegerValue>(parsed);
+      typed != nullptr) {
+    return fmt::format("ns3::UintegerValue{{{}U}}", typed->Get());
+  }
+
+  if (auto typed = ns3::DynamicCast<ns3::IntegerValue>(parsed);
+      typed != nullptr) {
+    return fmt::format("ns3::IntegerValue{{{}}}", typed->Get());
+  }
+
+  if (auto typed = ns3::DynamicCast<ns3::DoubleValue>(parsed);
+      typed != nullptr && std::isfinite(typed->Get())) {
+    return fmt::format("ns3::DoubleValue{{{}}}", literal(typed->Get()));
+  }
+
+  if (auto typed = ns3::DynamicCast<ns3::BooleanValue>(parsed);
+      typed != nullptr) {
+    return fmt::format("ns3::BooleanValue{{{}}}", literal(typed->Get()));
+  }
+
+  if (auto typed = ns3::DynamicCast<ns3::EnumValue>(parsed);
+      typed != nullptr) {
+    return fmt::format("ns3::EnumValue{{{}}}", typed->Get());
+  }
+
+  // Steps are written with the resolution they were parsed with, so they
+  // don't depend on resolution of the generated program
+  if (auto typed = ns3::DynamicCast<ns3::TimeValue>(parsed);
+      typed != nullptr) {
+    return fmt::format("ns3::TimeValue{{ns3::Time::From({}, {})}}",
+                       typed->Get().GetTimeStep(),
+                       literal(ns3::Time::GetResolution()));
+  }
+
+  if (auto typed = ns3::DynamicCast<ns3::DataRateValue>(parsed);
+      typed != nullptr) {
+    return fmt::format("ns3::DataRateValue{{ns3::DataRate{{{}U}}}}",
+                       typed->Get().GetBitRate());
+  }
+
+  if (auto typed = ns3::DynamicCast<ns3::Ipv4AddressValue>(parsed);
+      typed != nullptr) {
+    return fmt::format("ns3::Ipv4AddressValue{{{}}}", literal(typed->Get()));
+  }
+
+  if (auto typed = ns3::DynamicCast<ns3::Mac48AddressValue>(parsed);
+      typed != nullptr) {
+    return fmt::format("ns3::Mac48AddressValue{{ns3::Mac48Address{{{}}}}}",
+                       literal(typed->SerializeToString(info.checker)));
+  }
+
+  if (auto typed = ns3::DynamicCast<ns3::AddressValue>(parsed);
+      typed != nullptr) {
+    const auto &address = typed->Get();
+    if (ns3::Ipv4Address::IsMatchingType(address)) {
+      return fmt::format("ns3::AddressValue{{{}}}",
+                         literal(ns3::Ipv4Address::ConvertFrom(address)));
+    }
+
+    // Socket addresses with type of service keep the string form
+    if (ns3::InetSocketAddress::IsMatchingType(address)) {
+      auto socket = ns3::InetSocketAddress::ConvertFrom(address);
+      if (socket.GetTos() == 0) {
+        return fmt::format(
+            "ns3::AddressValue{{ns3::InetSocketAddress{{{}, {}}}}}",
+            literal(socket.GetIpv4()), socket.GetPort());
+      }
+    }
+  }
+
+  return fmt::format("ns3::StringValue{{{}}}", literal(value));
+}
+
+/**
+ * @brief Check errors which the generated program would report on build
+ *
+ * Attributes and connections are checked while their code is written.
+ */
+void check(const parser::ModelDescription &description) {
+  for (const auto &node : description.nodes) {
+    for (const auto &device : node.devices) {
+      if (!model::device_type_from_string(device.type).has_value()) {
+        throw CodegenError(fmt::format(R"(Invalid type "{}" of device "{}/{}")",
+                                       device.type, node.name, device.name));
+      }
+    }
+
+    for (const auto &application : node.applications) {
+      if (!model::Application::is_application(application.type)) {
+        throw CodegenError(
+            fmt::format(R"(Type "{}" of application "{}/{}" is unknown)",
+                        application.type, node.name, application.name));
+      }
+    }
+  }
+}
+
+/**
+ * @brief Writes functions, which add items of a list one by one
+ *
+ * @param parameter parameter of written functions
+ * @param write writes code adding one item
+ * @return names of written functions
+ */
+template <typename T, typename Write>
+auto write_chunks(std::ostream &out, std::string_view name,
+                  std::string_view parameter, const std::vector<T> &items,
+                  Write write) -> std::vector<std::string> {
+  std::vector<std::string> functions;
+  for (std::size_t first = 0; first < items.size(); first += chunk_size) {
+    auto function = fmt::format("add_{}_{}", name, functions.size());
+    out << fmt::format("void {}({}) {{\n", function, parameter);
+
+    auto last = std::min(items.size(), first + chunk_size);
+    for (auto i = first; i < last; ++i) {
+      write(out, items[i]);
+    }
+
+    out << "}\n\n";
+    functions.push_back(std::move(function));
+  }
+  return functions;
+}
+
+/**
+ * @brief Writes functions adding items of description list
+ *
+ */
+template <typename T>
+auto write_chunks(std::ostream &out, std::string_view name,
+                  std::string_view member, const std::vector<T> &items)
+    -> std::vector<std::string> {
+  return write_chunks(out, name, "parser::ModelDescription &description",
+                      items, [member](std::ostream &stream, const T &item) {
+                        stream << fmt::format(
+                            "  description.{}.push_back({});\n", member,
+                            literal(item));
+                      });
+}
+
+// Class of created objects, TypeId of the class has the same name
+struct Class {
+  std::string_view name;
+  std::string_view header;
+  ns3::TypeId (*type_id)();
+};
+
+auto device_class(model::device_type type) -> Class {
+  switch (type) {
+    case model::device_type::CSMA:
+      return {"ns3::CsmaNetDevice", "ns3/csma-net-device.h",
+              &ns3::CsmaNetDevice::GetTypeId};
+    case model::device_type::PPP:
+      return {"ns3::PointToPointNetDevice", "ns3/point-to-point-net-device.h",
+              &ns3::PointToPointNetDevice::GetTypeId};
+    default:
+      return {"ns3::SimpleNetDevice", "ns3/simple-net-device.h",
+              &ns3::SimpleNetDevice::GetTypeId};
+  }
+}
+
+auto channel_class(const parser::ConnectionDescription &connection)
+    -> Class {
+  switch (connection.type) {
+    case model::channel_type::CSMA:
+      return {"ns3::CsmaChannel", "ns3/csma-channel.h",
+              &ns3::CsmaChannel::GetTypeId};
+    case model::channel_type::PPP:
+      return {"ns3::PointToPointChannel", "ns3/point-to-point-channel.h",
+              &ns3::PointToPointChannel::GetTypeId};
+    case model::channel_type::Ideal:
+      return {"model::IdealChannel", "model/ideal_channel.h",
+              &model::IdealChannel::GetTypeId};
+    default:
+      throw CodegenError(fmt::format(R"(Invalid type of connection "{}")",
+                                     connection.name));
+  }
+}
+
+bool is_compatible(model::device_type device,
+                   model::channel_type channel) noexcept {
+  return (device == model::device_type::CSMA &&
+          channel == model::channel_type::CSMA) ||
+         (device == model::device_type::PPP &&
+          channel == model::channel_type::PPP) ||
+         (device == model::device_type::Ideal &&
+          channel == model::channel_type::Ideal);
+}
+
+// Headers of applications created by class, other applications are created
+// by ObjectFactory
+const std::map<std::string, std::string_view> application_headers = {
+    {"applications::BurstSource", "applications/burst_source.h"},
+    {"applications::LatencySink", "applications/latency_sink.h"},
+    {"ns3::BulkSendApplication", "ns3/bulk-send-application.h"},
+    {"ns3::OnOffApplication", "ns3/onoff-application.h"},
+    {"ns3::PacketSink", "ns3/packet-sink.h"},
+    {"ns3::UdpClient", "ns3/udp-client.h"},
+    {"ns3::UdpEchoClient", "ns3/udp-echo-client.h"},
+    {"ns3::UdpEchoServer", "ns3/udp-echo-server.h"},
+    {"ns3::UdpServer", "ns3/udp-server.h"},
+};
+
+/**
+ * @brief Writes functions, which create nodes and connections with typed
+ * ns-3 calls
+ *
+ * Objects are created in order of the description, as `--xml` does, so MAC
+ * addresses and indices of nodes are the same. Devices of connections are
+ * referred to by indices of nodes and devices.
+ */
+class ModelWriter {
+ public:
+  explicit ModelWriter(const parser::ModelDescription &description)
+      : _description{description} {
+    for (std::size_t i = 0; i < description.nodes.size(); ++i) {
+      _node_index.emplace(description.nodes[i].name, i);
+    }
+  }
+
+  auto write_nodes(std::ostream &out) -> std::vector<std::string> {
+    return write_chunks(out, "nodes", "model::Model &model",
+                        _description.nodes,
+                        [this](std::ostream &stream, const auto &node) {
+                          write(stream, node);
+                        });
+  }
+
+  /**
+   * @brief Write functions connecting devices of nodes added before
+   *
+   * @throws CodegenError on unknown or incompatible device
+   */
+  auto write_connections(std::ostream &out) -> std::vector<std::string> {
+    return write_chunks(out, "connections", "model::Model &model",
+                        _description.connections,
+                        [this](std::ostream &stream, const auto &connection) {
+                          write(stream, connection);
+                        });
+  }
+
+  /**
+   * @brief Headers of created classes, relative to include directories
+   *
+   */
+  auto headers() const -> const std::set<std::string> & { return _headers; }
+
+ private:
+  void write(std::ostream &out, const parser::NodeDescription &node) {
+    out << "  {\n";
+    out << fmt::format("    auto node = model::Node::create_empty({});\n",
+                       literal(node.name));
+
+    for (std::size_t i = 0; i < node.devices.size(); ++i) {
+      write(out, node, node.devices[i], i);
+    }
+
+    for (std::size_t i = 0; i < node.applications.size(); ++i) {
+      write(out, node, node.applications[i], i);
+    }
+
+    if (!node.routing.ipv4.empty()) {
+      out << "    auto ipv4_routing = ns3::Ipv4StaticRoutingHelper{}"
+             ".GetStaticRouting(node->ipv4());\n";
+    }
+    for (const auto &route : node.routing.ipv4) {
+      out << fmt::format(
+          "    ipv4_routing->AddNetworkRouteTo({}, ns3::Ipv4Mask{{{:#010x}U}}, "
+          "node->ipv4()->GetInterfaceForDevice({}), {});\n",
+          literal(address::to_ns3_v4(route.network.network())),
+          route.network.netmask().to_uint(),
+          device_variable(node, route.interface), route.metric);
+    }
+
+    if (!node.routing.ipv6.empty()) {
+      out << "    auto ipv6_routing = ns3::Ipv6StaticRoutingHelper{}"
+             ".GetStaticRouting(node->ipv6());\n";
+    }
+    for (const auto &route : node.routing.ipv6) {
+      out << fmt::format(
+          "    ipv6_routing->AddNetworkRouteTo(ns3::Ipv6Address{{{}}}, "
+          "ns3::Ipv6Prefix{{{}}}, "
+          "node->ipv6()->GetInterfaceForDevice({}), {});\n",
+          literal(route.network.address().to_string()),
+          route.network.prefix_length(),
+          device_variable(node, route.interface), route.metric);
+    }
+
+    out << "    model.add_node(std::move(node));\n"
+           "  }\n";
+  }
+
+  void write(std::ostream &out, const parser::NodeDescription &node,
+             const parser::DeviceDescription &device, std::size_t index) {
+    auto type = *model::device_type_from_string(device.type);
+    auto created = device_class(type);
+    _headers.emplace(created.header);
+
+    auto variable = fmt::format("device_{}", index);
+    out << fmt::format("    auto {} = ns3::CreateObject<{}>();\n", variable,
+                       created.name);
+    out << fmt::format("    {}->SetAddress(ns3::Mac48Address::Allocate());\n",
+                       variable);
+    write_attributes(out, variable, created.type_id(), device.attributes,
+                     node.name + "/" + device.name);
+
+    out << fmt::format("    model::Device model_{}{{{}, {}, {}, {}, {}}};\n",
+                       variable, variable, literal(device.name),
+                       literal(type), literal(device.ipv4_addresses),
+                       literal(device.ipv6_addresses));
+    if (device.capture.has_value()) {
+      out << fmt::format("    model_{}.enable_capture({});\n", variable,
+                         literal(*device.capture));
+    }
+    out << fmt::format("    node->attach(std::move(model_{}));\n", variable);
+  }
+
+  void write(std::ostream &out, const parser::NodeDescription &node,
+             const parser::ApplicationDescription &application,
+             std::size_t index) {
+    auto variable = fmt::format("application_{}", index);
+    if (auto it = application_headers.find(application.type);
+        it != application_headers.end()) {
+      _headers.emplace(it->second);
+      out << fmt::format("    auto {} = ns3::CreateObject<{}>();\n", variable,
+                         application.type);
+    } else {
+      out << fmt::format(
+          "    auto {} = "
+          "ns3::ObjectFactory{{{}}}.Create<ns3::Application>();\n",
+          variable, literal(application.type));
+    }
+
+    write_attributes(out, variable,
+                     ns3::TypeId::LookupByName(application.type),
+                     application.attributes,
+                     node.name + "/" + application.name);
+
+    out << fmt::format("    node->attach(model::Application{{{}, {}}});\n",
+                       variable, literal(application.name));
+  }
+
+  void write(std::ostream &out,
+             const parser::ConnectionDescription &connection) {
+    auto created = channel_class(connection);
+    _headers.emplace(created.header);
+
+    out << "  {\n";
+    out << fmt::format("    auto channel = ns3::CreateObject<{}>();\n",
+                       created.name);
+    write_attributes(out, "channel", created.type_id(),
+                     connection.attributes, connection.name);
+    out << fmt::format(
+        "    auto connection = model::Channel::create(channel, {}, {});\n",
+        literal(connection.name), literal(connection.type));
+
+    for (const auto &interface : connection.interfaces) {
+      // interface format is {node_name}/{interface_name}
+      auto separator = interface.find_first_of('/');
+      auto node_name = interface.substr(0, separator);
+      auto interface_name = interface.substr(separator + 1);
+
+      auto node_it = _node_index.find(node_name);
+      if (node_it == _node_index.end()) {
+        throw CodegenError(fmt::format(
+            "Failed create connection: Unknown node with name \"{}\"",
+            node_name));
+      }
+
+      const auto &devices = _description.nodes[node_it->second].devices;
+      auto device = std::find_if(
+          devices.begin(), devices.end(),
+          [&](const auto &candidate) {
+            return candidate.name == interface_name;
+          });
+      if (device == devices.end()) {
+        throw CodegenError(fmt::format(
+            R"(Failed create connection: Unknown interface of "{}" with name "{}")",
+            node_name, interface_name));
+      }
+
+      if (!is_compatible(*model::device_type_from_string(device->type),
+                         connection.type)) {
+        throw CodegenError(
+            fmt::format(R"(Can't attach channel "{}" to device "{}")",
+                        connection.name, interface_name));
+      }
+
+      if (auto [it, added] = _channel_per_device.emplace(interface,
+                                                         connection.name);
+          !added) {
+        throw CodegenError(
+            fmt::format(R"(Device "{}" already has channel "{}")",
+                        interface_name, it->second));
+      }
+
+      out << fmt::format(
+          "    model.nodes()[{}]->get_device({}).attach(connection);\n",
+          node_it->second, device - devices.begin());
+    }
+
+    out << "  }\n";
+  }
+
+  static void write_attributes(std::ostream &out, std::string_view object,
+                               const ns3::TypeId &type,
+                               const parser::Attributes &attributes,
+                               const std::string &owner) {
+    for (const auto &[name, value] : attributes) {
+      out << fmt::format("    {}->SetAttribute({}, {});\n", object,
+                         literal(name),
+                         attribute_value(type, name, value, owner));
+    }
+  }
+
+  static auto device_variable(const parser::NodeDescription &node,
+                              const std::string &name) -> std::string {
+    auto device = std::find_if(
+        node.devices.begin(), node.devices.end(),
+        [&name](const auto &candidate) { return candidate.name == name; });
+    if (device == node.devices.end()) {
+      throw CodegenError(fmt::format(
+          R"(Can't find interface "{}" for route of node "{}")", name,
+          node.name));
+    }
+    return fmt::format("device_{}", device - node.devices.begin());
+  }
+
+  const parser::ModelDescription &_description;
+  std::unordered_map<std::string, std::size_t> _node_index;
+  // Interfaces attached by written connections
+  std::unordered_map<std::string, std::string> _channel_per_device;
+  std::set<std::string> _headers;
+};
+}  // namespace
+
+void generate(const parser::ModelDescription &description, std::ostream &out) {
+  check(description);
+
+  // Headers depend on classes of created objects, so objects are written
+  // first
+  ModelWriter model{description};
+  std::ostringstream objects;
+  auto builders = model.write_nodes(objects);
+  auto connections = model.write_connections(objects);
+  builders.insert(builders.end(), connections.begin(), connections.end());
+
+  std::set<std::string> headers = {
+      "model/channel.h",
+      "model/device.h",
+      "model/model.h",
+      "model/node.h",
+      "ns3/address.h",
+      "ns3/boolean.h",
+      "ns3/data-rate.h",
+      "ns3/double.h",
+      "ns3/enum.h",
+      "ns3/inet-socket-address.h",
+      "ns3/integer.h",
+      "ns3/ipv4-address.h",
+      "ns3/ipv4-interface-address.h",
+      "ns3/ipv4-static-routing-helper.h",
+      "ns3/ipv4-static-routing.h",
+      "ns3/ipv6-address.h",
+      "ns3/ipv6-interface-address.h",
+      "ns3/ipv6-static-routing-helper.h",
+      "ns3/ipv6-static-routing.h",
+      "ns3/mac48-address.h",
+      "ns3/nstime.h",
+      "ns3/object-factory.h",
+      "ns3/string.h",
+      "ns3/uinteger.h",
+      "parser/parser.h"};
+  headers.insert(model.headers().begin(), model.headers().end());
+
+  out << fmt::format(
+      "// Generated by `simulation --codegen` from model {}, don't edit\n"
+      "\n"
+      "#include <csignal>\n"
+      "#include <exception>\n"
+      "#include <iostream>\n"
+      "#include <optional>\n"
+      "#include <utility>\n"
+      "\n",
+      literal(description.model_name));
+  for (const auto &header : headers) {
+    if (header.rfind("ns3/", 0) == 0) {
+      out << fmt::format("#include <{}>\n", header);
+    }
+  }
+  out << "\n";
+  for (const auto &header : headers) {
+    if (header.rfind("ns3/", 0) != 0) {
+      out << fmt::format("#include \"{}\"\n", header);
+    }
+  }
+  out << "\n"
+         "namespace {\n"
+         "model::Model *running = nullptr;  // NOLINT\n"
+         "\n"
+         "void stop(int /*sig*/) {\n"
+         "  if (running != nullptr) {\n"
+         "    running->stop();\n"
+         "  }\n"
+         "}\n"
+         "\n";
+
+  out << objects.str();
+
+  std::vector<std::string> functions;
+  auto add = [&](auto name, auto member, const auto &items) {
+    auto written = write_chunks(out, name, member, items);
+    functions.insert(functions.end(), written.begin(), written.end());
+  };
+  add("registrators", "registrators", description.registrators);
+  add("pollers", "pollers", description.pollers);
+  add("flows", "background.flows", description.background.flows);
+
+  out << "auto make_description() -> parser::ModelDescription {\n"
+         "  parser::ModelDescription description;\n";
+  out << fmt::format("  description.model_name = {};\n",
+                     literal(description.model_name));
+  out << fmt::format("  description.polulate_tables = {};\n",
+                     literal(description.polulate_tables));
+  out << fmt::format("  description.populate_neighbor_cache = {};\n",
+                     literal(description.populate_neighbor_cache));
+  out << fmt::format("  description.end_time = {};\n",
+                     literal(description.end_time));
+  out << fmt::format("  description.time_precision = {};\n",
+                     literal(description.time_precision));
+  out << fmt::format("  description.statistics = {};\n",
+                     literal(description.statistics));
+  out << fmt::format("  description.background.mode = {};\n",
+                     literal(description.background.mode));
+  for (const auto &function : functions) {
+    out << fmt::format("  {}(description);\n", function);
+  }
+  out << "  return description;\n"
+         "}\n"
+         "}  // namespace\n"
+         "\n"
+         "int main() {\n"
+         "  try {\n"
+         "    model::Model model;\n";
+  for (const auto &builder : builders) {
+    out << fmt::format("    {}(model);\n", builder);
+  }
+  out << "    model.build_from_nodes(make_description());\n"
+         "\n"
+         "    running = &model;\n"
+         "    std::signal(SIGTERM, stop);  // NOLINT\n"
+         "    model.start();\n"
+         "    running = nullptr;\n"
+         "  } catch (std::exception &e) {\n"
+         "    std::cerr << \"Error: \" << e.what() << std::endl;\n"
+         "    return 1;\n"
+         "  }\n"
+         "\n"
+         "  return 0;\n"
+         "}\n";
+}
+
+}  // namespace codegen
@@ -0,0 +1,39 @@
+#ifndef __CODEGEN_H_W3FN8QD5LK2C__
+#define __CODEGEN_H_W3FN8QD5LK2C__
+
+#include <ostream>
+#include <stdexcept>
+
+namespace parser {
+struct ModelDescription;
+}
+
+namespace codegen {
+
+class CodegenError : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Write C++ source of program running the model
+ *
+ * Program creates nodes, devices, applications and channels with
+ * ns3::CreateObject of their classes, sets attributes by values of their own
+ * types, e.g. DataRateValue and TimeValue, and attaches devices to channels
+ * by indices, so it doesn't look up TypeIds, parse attribute strings or
+ * resolve names of interfaces on build. Attributes of other value types are
+ * set from strings. The rest of the model is built from description by
+ * model::Model::build_from_nodes, so the program behaves the same as
+ * `simulation --xml`. Types, attributes and connections are checked before
+ * the source is written, so these errors are reported by code generation.
+ *
+ * @param description
+ * @param out
+ * @throws CodegenError on unknown type, bad attribute or connection
+ */
+void generate(const parser::ModelDescription &description, std::ostream &out);
+
+}  // namespace codegen
+
+#endif  // __CODEGEN_H_W3FN8QD5LK2C__
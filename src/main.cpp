@@ -1,13 +1,31 @@
+#include <algorithm>
+#include <chrono>
 #include <csignal>
+#include <cstddef>
 #include <exception>
+#include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <optional>
+#include <ostream>
+#include <sstream>
 #include <string>
+#include <vector>
+
+#include <fmt/core.h>
 
 #include "app_config.h"
+#include "cache/output_files.h"
+#include "cache/result_cache.h"
+#include "codegen/codegen.h"
 #include "model/model.h"
 #include "parser/parser.h"
+#include "parser/prune.h"
+#include "profiling/alloc_counter.h"
+#include "profiling/build_profiler.h"
+#include "profiling/event_profiler.h"
+#include "server/server.h"
 
 namespace {
 std::function<void()> on_sigterm;  // NOLINT
@@ -17,6 +35,77 @@ void signal_handler(int /*sig*/) {
     on_sigterm();
   }
 }
+
+void print_names(const char *title, const std::vector<std::string> &names,
+                 std::ostream &out) {
+  constexpr std::size_t max_printed = 10;
+
+  if (names.empty()) {
+    return;
+  }
+
+  out << fmt::format("  {} ({}):", title, names.size());
+  for (std::size_t i = 0; i < std::min(names.size(), max_printed); ++i) {
+    out << ' ' << names[i];
+  }
+  if (names.size() > max_printed) {
+    out << " ...";
+  }
+  out << '\n';
+}
+
+/**
+ * @brief Print pruned parts and memory saved on them
+ *
+ * Memory is estimated from bytes allocated while building kept nodes.
+ */
+void print_prune_report(const parser::PruneReport &report,
+                        std::size_t built_nodes, std::ostream &out) {
+  if (report.endpoints == 0) {
+    out << "Prune: model has no application endpoints, nothing pruned\n";
+    return;
+  }
+
+  out << fmt::format(
+      "Prune: {} nodes, {} devices, {} connections can't carry traffic "
+      "between {} endpoints\n",
+      report.nodes.size(), report.devices.size(), report.connections.size(),
+      report.endpoints);
+  print_names("nodes", report.nodes, out);
+  print_names("devices", report.devices, out);
+  print_names("connections", report.connections, out);
+
+  for (const auto &[name, stats] :
+       profiling::BuildProfiler::instance().phases()) {
+    if (name != "build/nodes" || built_nodes == 0) {
+      continue;
+    }
+
+    auto per_node = stats.allocated_bytes / built_nodes;
+    out << fmt::format(
+        "  estimated memory saved: {:.1f} MiB ({} bytes allocated per built "
+        "node)\n",
+        static_cast<double>(per_node * report.nodes.size()) / (1 << 20),
+        per_node);
+  }
+}
+
+/**
+ * @brief Print restored or stored files of result cache
+ *
+ */
+void print_cached_files(const char *action,
+                        const std::vector<std::filesystem::path> &files,
+                        std::ostream &out) {
+  std::vector<std::string> names;
+  names.reserve(files.size());
+  for (const auto &file : files) {
+    names.push_back(file.filename().string());
+  }
+
+  out << fmt::format("Cache: {} {} files\n", action, files.size());
+  print_names("files", names, out);
+}
 }  // namespace
 
 inline std::string read_xml(const std::string &path) noexcept {
@@ -32,22 +121,126 @@ int main(int argc, char *argv[]) {
     return 1;
   }
 
+  if (!config.serve_socket.empty()) {
+    try {
+      server::Server server{config.serve_socket, config.serve_workers};
+      server.run();
+    } catch (server::ServerError &e) {
+      std::cerr << "Error: " << e.what() << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+
   std::signal(SIGTERM, signal_handler); // NOLINT
 
+  auto &build_profiler = profiling::BuildProfiler::instance();
+  // Pruning report estimates memory from allocations of built nodes
+  if (config.profile_build || !config.build_profile_path.empty() ||
+      config.prune) {
+    build_profiler.enable();
+    profiling::alloc::enable();
+  }
+
+  if (config.track_allocations) {
+    profiling::alloc::enable();
+  }
+
   try {
+    ns3::Ptr<profiling::EventProfiler> profiler;
+    if (!config.event_profile_path.empty()) {
+      profiler = profiling::EventProfiler::install();
+    }
+
+    profiling::alloc::set_phase(profiling::alloc::phase::parse);
     auto model_description =
         parser::XmlParser().parse(read_xml(config.xml_model_path));
 
+    std::optional<parser::PruneReport> prune_report;
+    if (config.prune) {
+      prune_report = parser::prune(model_description);
+    }
+
+    if (!config.codegen_path.empty()) {
+      // Source is written at once, so failed generation leaves no file
+      std::ostringstream source;
+      codegen::generate(model_description, source);
+
+      std::ofstream out{config.codegen_path};
+      if (!(out << source.str())) {
+        throw codegen::CodegenError(
+            fmt::format(R"(Can't write "{}")", config.codegen_path));
+      }
+      std::cout << fmt::format("Codegen: model \"{}\" written to {}\n",
+                               model_description.model_name,
+                               config.codegen_path);
+      return 0;
+    }
+
+    // Live statistics are read while the model runs and printed summaries
+    // are not stored, so such runs can't be replayed
+    std::optional<cache::ResultCache> results;
+    std::optional<cache::ResultCache::Key> cache_key;
+    if (!config.cache_dir.empty() &&
+        !model_description.statistics.live.has_value() &&
+        !cache::prints_summary(model_description)) {
+      results.emplace(config.cache_dir, config.cache_size);
+      cache_key = cache::ResultCache::key(model_description);
+      if (auto files = results->restore(*cache_key); files.has_value()) {
+        print_cached_files("restored", *files, std::cout);
+        return 0;
+      }
+    }
+
+    // Modification time of files may be rounded down by filesystem
+    auto start = std::filesystem::file_time_type::clock::now() -
+                 std::chrono::seconds{1};
+
+    profiling::alloc::set_phase(profiling::alloc::phase::build);
     model::Model model;
     model.build_from_description(model_description);
 
+    if (prune_report.has_value()) {
+      print_prune_report(*prune_report, model.nodes().size(), std::cout);
+    }
+
+    if (config.profile_build) {
+      build_profiler.report(std::cout);
+    }
+
+    if (!config.build_profile_path.empty()) {
+      build_profiler.write_json(config.build_profile_path);
+    }
+
     on_sigterm = [&model] { model.stop(); };
 
+    profiling::alloc::set_phase(profiling::alloc::phase::run);
     model.start();
 
+    if (profiler != nullptr) {
+      profiler->report(model, std::cout, config.event_profile_top);
+      profiler->write_profile(model, config.event_profile_path);
+    }
+
+    // Outputs are flushed and closed on reset
+    model.reset();
+    if (results.has_value()) {
+      auto files = cache::written_files(model_description, start);
+      results->store(*cache_key, files);
+      print_cached_files("stored", files, std::cout);
+    }
+
     // TODO: extract exceptions (use fmt only in exception handler)
   } catch (std::exception &e) {
     std::cerr << "Error: " << e.what() << std::endl;
+    // Build systems running code generation check its status
+    if (!config.codegen_path.empty()) {
+      return 1;
+    }
+  }
+
+  if (config.track_allocations) {
+    profiling::alloc::report(std::cout);
   }
 
   return 0;
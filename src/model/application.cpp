@@ -7,6 +7,7 @@
 
 #include <fmt/core.h>
 
+#include "applications/applications.h"
 #include "model_build_error.h"
 #include "parser/parser.h"
 #include "utils/object.h"
@@ -43,6 +44,8 @@ auto Application::create(const parser::ApplicationDescription &description)
 }
 
 bool Application::is_application(const std::string &type) noexcept {
+  applications::register_types();
+
   ns3::TypeId app_type;
 
   if (!ns3::TypeId::LookupByNameFailSafe(type, &app_type)) {
@@ -14,17 +14,25 @@ namespace model {
 
 class Application {
  public:
+  /**
+   * @brief Wrap created application, which is not added to node yet
+   *
+   */
+  Application(const ns3::Ptr<ns3::Application>& app, std::string name);
+
   auto get() const -> ns3::Ptr<ns3::Application> { return _application; }
 
   auto name() const -> const std::string& { return _name; }
 
   static Application create(const parser::ApplicationDescription& description);
 
- private:
-  Application(const ns3::Ptr<ns3::Application>& app, std::string name);
-
-  static bool is_application(const std::string &type) noexcept;
+  /**
+   * @brief Check that type is registered and derived from ns3::Application
+   *
+   */
+  static bool is_application(const std::string& type) noexcept;
 
+ private:
   std::string _name;
   ns3::Ptr<ns3::Application> _application;
 };
@@ -0,0 +1,277 @@
+#include "background_traffic.h"
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <utility>
+
+#include <ns3/channel.h>
+#include <ns3/data-rate.h>
+#include <ns3/ipv4-address.h>
+#include <ns3/ipv4-header.h>
+#include <ns3/ipv4-route.h>
+#include <ns3/ipv4-routing-protocol.h>
+#include <ns3/ipv4.h>
+#include <ns3/nstime.h>
+#include <ns3/packet.h>
+#include <ns3/point-to-point-net-device.h>
+#include <ns3/simple-net-device.h>
+#include <ns3/simulator.h>
+#include <ns3/socket.h>
+
+#include <fmt/core.h>
+
+#include "model/channel.h"
+#include "model/device.h"
+#include "model/model_build_error.h"
+#include "model/node.h"
+#include "parser/parser.h"
+#include "utils/address.h"
+
+namespace model {
+
+namespace {
+// Routing loops are reported instead of hanging the build
+constexpr auto max_hops = 255;
+
+auto parse_rate(const std::string &rate, const std::string &flow_name)
+    -> ns3::DataRate {
+  ns3::DataRateValue value;
+  if (!value.DeserializeFromString(rate, ns3::MakeDataRateChecker())) {
+    throw ModelBuildError(fmt::format(
+        R"(Bad rate "{}" of background flow "{}")", rate, flow_name));
+  }
+  return value.Get();
+}
+
+auto owns(const ns3::Ptr<ns3::Node> &node, const ns3::Ipv4Address &address)
+    -> bool {
+  auto ipv4 = node->GetObject<ns3::Ipv4>();
+  return ipv4 != nullptr && ipv4->GetInterfaceForAddress(address) != -1;
+}
+}  // namespace
+
+BackgroundTraffic::BackgroundTraffic(
+    const parser::BackgroundDescription &description,
+    const std::vector<std::unique_ptr<Node>> &nodes)
+    : _mode{description.mode}, _nodes{nodes} {
+  for (const auto &flow_desc : description.flows) {
+    auto source = std::find_if(
+        nodes.begin(), nodes.end(),
+        [&](const auto &node) { return node->name() == flow_desc.source; });
+    if (source == nodes.end()) {
+      throw ModelBuildError(
+          fmt::format(R"(Unknown source node "{}" of background flow "{}")",
+                      flow_desc.source, flow_desc.name));
+    }
+
+    ns3::Time start{flow_desc.start_time};
+    std::optional<ns3::Time> end;
+    if (flow_desc.end_time.has_value()) {
+      end = ns3::Time{*flow_desc.end_time};
+      if (*end <= start) {
+        throw ModelBuildError(fmt::format(
+            R"(Background flow "{}" ends before it starts)", flow_desc.name));
+      }
+    }
+
+    Flow flow{
+        .name = flow_desc.name,
+        .rate_bps = static_cast<double>(
+            parse_rate(flow_desc.rate, flow_desc.name).GetBitRate()),
+        .packet_bits = flow_desc.packet_size * 8.0,
+        .start = start,
+        .end = end,
+        .path = route(**source, address::to_ns3_v4(flow_desc.destination),
+                      flow_desc.name)};
+
+    _flows.push_back(std::move(flow));
+  }
+
+  // One event per distinct time of flow start or end
+  std::map<ns3::Time, std::vector<std::pair<std::size_t, bool>>> changes;
+  for (std::size_t i = 0; i < _flows.size(); ++i) {
+    changes[_flows[i].start].emplace_back(i, true);
+    if (_flows[i].end.has_value()) {
+      changes[*_flows[i].end].emplace_back(i, false);
+    }
+  }
+
+  for (auto &[time, flows] : changes) {
+    ns3::Simulator::Schedule(time, [this, flows = std::move(flows)] {
+      for (auto [flow, active] : flows) {
+        set_active(flow, active);
+      }
+      apply();
+    });
+  }
+}
+
+auto BackgroundTraffic::busiest() const -> const Link * {
+  auto it = std::max_element(_links.begin(), _links.end(),
+                             [](const auto &lhs, const auto &rhs) {
+                               return lhs.utilization() < rhs.utilization();
+                             });
+  return it != _links.end() ? &*it : nullptr;
+}
+
+auto BackgroundTraffic::route(const Node &source,
+                              const ns3::Ipv4Address &destination,
+                              const std::string &flow_name)
+    -> std::vector<std::size_t> {
+  std::vector<std::size_t> path;
+
+  ns3::Ipv4Header header;
+  header.SetDestination(destination);
+
+  auto packet = ns3::Create<ns3::Packet>();
+  auto node = source.get();
+  while (!owns(node, destination)) {
+    if (path.size() == max_hops) {
+      throw ModelBuildError(fmt::format(
+          R"(Background flow "{}" exceeds {} hops)", flow_name, max_hops));
+    }
+
+    auto ipv4 = node->GetObject<ns3::Ipv4>();
+    ns3::Socket::SocketErrno error{};
+    auto route =
+        ipv4 != nullptr && ipv4->GetRoutingProtocol() != nullptr
+            ? ipv4->GetRoutingProtocol()->RouteOutput(packet, header, nullptr,
+                                                      error)
+            : nullptr;
+    if (route == nullptr) {
+      throw ModelBuildError(fmt::format(
+          R"(Background flow "{}" has no route to {} from node {})",
+          flow_name, address::address_v4{destination.Get()}.to_string(),
+          node->GetId()));
+    }
+
+    auto device = route->GetOutputDevice();
+    auto gateway = route->GetGateway();
+    auto next_hop = gateway == ns3::Ipv4Address::GetAny() ? destination
+                                                          : gateway;
+
+    path.push_back(link_of(device));
+
+    auto channel = device->GetChannel();
+    ns3::Ptr<ns3::Node> next;
+    for (std::size_t i = 0; channel != nullptr && i < channel->GetNDevices();
+         ++i) {
+      auto peer = channel->GetDevice(i)->GetNode();
+      if (peer != node && owns(peer, next_hop)) {
+        next = peer;
+        break;
+      }
+    }
+
+    if (next == nullptr) {
+      throw ModelBuildError(fmt::format(
+          R"(Background flow "{}": next hop {} is not on link of node {})",
+          flow_name, address::address_v4{next_hop.Get()}.to_string(),
+          node->GetId()));
+    }
+    node = next;
+  }
+
+  return path;
+}
+
+auto BackgroundTraffic::link_of(ns3::Ptr<ns3::NetDevice> device)
+    -> std::size_t {
+  // Point-to-point and ideal devices have own transmitters
+  auto own_rate = ns3::DynamicCast<ns3::PointToPointNetDevice>(device) !=
+                      nullptr ||
+                  ns3::DynamicCast<ns3::SimpleNetDevice>(device) != nullptr;
+  auto channel = device->GetChannel();
+
+  for (std::size_t i = 0; i < _links.size(); ++i) {
+    const auto &link = _links[i];
+    if (own_rate ? link.device == device : link.channel->get() == channel) {
+      return i;
+    }
+  }
+
+  std::shared_ptr<Channel> model_channel;
+  for (const auto &node : _nodes) {
+    for (std::size_t i = 0; i < node->devices_count(); ++i) {
+      if (node->get_device(i).get() == device) {
+        model_channel = node->get_device(i).channel();
+      }
+    }
+  }
+
+  if (model_channel == nullptr) {
+    throw ModelBuildError("Background flow is routed through unknown device");
+  }
+
+  Link link{.channel = model_channel};
+
+  ns3::DataRateValue rate;
+  ns3::TimeValue delay;
+  channel->GetAttribute("Delay", delay);
+  if (own_rate) {
+    link.device = device;
+    device->GetAttribute("DataRate", rate);
+  } else {
+    channel->GetAttribute("DataRate", rate);
+  }
+  link.capacity = rate.Get();
+  link.delay = delay.Get();
+
+  _links.push_back(std::move(link));
+  return _links.size() - 1;
+}
+
+void BackgroundTraffic::set_active(std::size_t flow, bool active) {
+  _flows[flow].active = active;
+}
+
+void BackgroundTraffic::apply() {
+  std::vector<double> packets_per_second(_links.size(), 0);
+  for (auto &link : _links) {
+    link.load_bps = 0;
+  }
+
+  for (const auto &flow : _flows) {
+    if (!flow.active) {
+      continue;
+    }
+    for (auto index : flow.path) {
+      _links[index].load_bps += flow.rate_bps;
+      packets_per_second[index] += flow.rate_bps / flow.packet_bits;
+    }
+  }
+
+  // Point-to-point channel has one delay for both directions, so it gets
+  // the larger queueing delay of its devices
+  std::map<ns3::Ptr<ns3::Channel>, ns3::Time> channel_delay;
+
+  for (std::size_t i = 0; i < _links.size(); ++i) {
+    auto &link = _links[i];
+    link.packet_bits = packets_per_second[i] > 0
+                           ? link.load_bps / packets_per_second[i]
+                           : 0;
+
+    auto capacity = static_cast<double>(link.capacity.GetBitRate());
+    if (_mode == background_mode::capacity) {
+      ns3::DataRateValue rate{ns3::DataRate{static_cast<std::uint64_t>(
+          fluid::residual_rate(link.load_bps, capacity))}};
+      if (link.device != nullptr) {
+        link.device->SetAttribute("DataRate", rate);
+      } else {
+        link.channel->get()->SetAttribute("DataRate", rate);
+      }
+    } else {
+      auto queueing = ns3::Seconds(
+          fluid::queueing_delay(link.load_bps, capacity, link.packet_bits));
+      auto &delay = channel_delay[link.channel->get()];
+      delay = std::max(delay, link.delay + queueing);
+    }
+  }
+
+  for (const auto &[channel, delay] : channel_delay) {
+    channel->SetAttribute("Delay", ns3::TimeValue(delay));
+  }
+}
+
+}  // namespace model
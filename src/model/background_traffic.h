@@ -0,0 +1,183 @@
+#ifndef __BACKGROUND_TRAFFIC_H_Q7HV2M5LXC8D__
+#define __BACKGROUND_TRAFFIC_H_Q7HV2M5LXC8D__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+#include <ns3/data-rate.h>
+#include <ns3/net-device.h>
+#include <ns3/nstime.h>
+#include <ns3/ptr.h>
+
+namespace parser {
+struct BackgroundDescription;
+}
+
+namespace model {
+
+class Channel;
+class Node;
+
+/**
+ * @brief How background load is fed to packet-level simulation
+ *
+ * capacity - link rate is reduced by background load
+ * delay - link keeps its rate, mean queueing delay of background load is
+ * added to propagation delay
+ */
+enum class background_mode { capacity, delay };
+
+inline auto background_mode_from_string(const std::string &str) noexcept
+    -> std::optional<background_mode> {
+  auto mode = boost::algorithm::to_lower_copy(str);
+  if (mode == "capacity") {
+    return background_mode::capacity;
+  }
+
+  if (mode == "delay") {
+    return background_mode::delay;
+  }
+
+  return {};
+}
+
+namespace fluid {
+
+// Background load never takes a link completely, so foreground packets
+// still pass through saturated links
+constexpr auto max_utilization = 0.99;
+
+/**
+ * @brief Share of link capacity taken by load, limited by max_utilization
+ *
+ */
+inline auto utilization(double load_bps, double capacity_bps) noexcept
+    -> double {
+  if (capacity_bps <= 0) {
+    return max_utilization;
+  }
+  return std::clamp(load_bps / capacity_bps, 0.0, max_utilization);
+}
+
+/**
+ * @brief Capacity left for foreground traffic
+ *
+ */
+inline auto residual_rate(double load_bps, double capacity_bps) noexcept
+    -> double {
+  return capacity_bps * (1 - utilization(load_bps, capacity_bps));
+}
+
+/**
+ * @brief Mean waiting time in M/M/1 queue with mean packet size of load
+ *
+ * @param load_bps background load
+ * @param capacity_bps link rate
+ * @param mean_packet_bits mean packet size of background load
+ * @return double seconds
+ */
+inline auto queueing_delay(double load_bps, double capacity_bps,
+                           double mean_packet_bits) noexcept -> double {
+  if (capacity_bps <= 0) {
+    return 0;
+  }
+  auto rho = utilization(load_bps, capacity_bps);
+  auto service_time = mean_packet_bits / capacity_bps;
+  return rho / (1 - rho) * service_time;
+}
+
+}  // namespace fluid
+
+/**
+ * @brief Flow-level background load over the routed topology
+ *
+ * Every flow is routed hop by hop with routing protocols of nodes, its rate
+ * is added to the load of each traversed link. Load is applied to link
+ * attributes only when a flow starts or ends, so background traffic costs
+ * no per-packet events.
+ */
+class BackgroundTraffic {
+ public:
+  /**
+   * @brief Load of one link
+   *
+   * Point-to-point and ideal devices have own transmitter and are loaded
+   * separately, CSMA devices share transmitter of the channel.
+   */
+  struct Link {
+    std::shared_ptr<Channel> channel;
+    // Transmitting device, null for CSMA channel
+    ns3::Ptr<ns3::NetDevice> device;
+    ns3::DataRate capacity;
+    ns3::Time delay;
+
+    double load_bps = 0;
+    double packet_bits = 0;
+
+    auto utilization() const noexcept -> double {
+      return fluid::utilization(load_bps,
+                                static_cast<double>(capacity.GetBitRate()));
+    }
+  };
+
+  /**
+   * @brief Route flows of description and schedule their start and end
+   *
+   * Must be created after routing tables are populated.
+   *
+   * @param description
+   * @param nodes nodes of the model
+   * @throws ModelBuildError on unknown source node, bad rate or time and
+   * unroutable destination
+   */
+  BackgroundTraffic(const parser::BackgroundDescription &description,
+                    const std::vector<std::unique_ptr<Node>> &nodes);
+
+  auto links() const -> const std::vector<Link> & { return _links; }
+
+  auto flows_count() const -> std::size_t { return _flows.size(); }
+
+  /**
+   * @brief Link with highest utilization, null without links
+   *
+   */
+  auto busiest() const -> const Link *;
+
+ private:
+  struct Flow {
+    std::string name;
+    double rate_bps;
+    double packet_bits;
+    ns3::Time start;
+    std::optional<ns3::Time> end;
+    // Indices of traversed links
+    std::vector<std::size_t> path;
+    bool active = false;
+  };
+
+  auto route(const Node &source, const ns3::Ipv4Address &destination,
+             const std::string &flow_name) -> std::vector<std::size_t>;
+
+  auto link_of(ns3::Ptr<ns3::NetDevice> device) -> std::size_t;
+
+  void set_active(std::size_t flow, bool active);
+
+  void apply();
+
+  background_mode _mode;
+  const std::vector<std::unique_ptr<Node>> &_nodes;
+
+  std::vector<Link> _links;
+  std::vector<Flow> _flows;
+};
+
+}  // namespace model
+
+#endif  // __BACKGROUND_TRAFFIC_H_Q7HV2M5LXC8D__
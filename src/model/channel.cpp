@@ -5,6 +5,7 @@
 
 #include <fmt/core.h>
 
+#include "model/ideal_channel.h"
 #include "model/model_build_error.h"
 #include "model/name_service.h"
 #include "parser/parser.h"
@@ -23,6 +24,11 @@ auto create(channel_type type, const parser::Attributes &attributes)
       return utils::create<ns3::Channel>("ns3::PointToPointChannel",
                                          attributes);
 
+    case model::channel_type::Ideal:
+      // Registers TypeId, which is not linked from static library otherwise
+      return utils::create<ns3::Channel>(IdealChannel::GetTypeId().GetName(),
+                                         attributes);
+
     default:
       return nullptr;
   }
@@ -34,9 +40,7 @@ auto Channel::create(const parser::ConnectionDescription &description)
   try {
     auto channel =
         channel_factory::create(description.type, description.attributes);
-    names::add(channel, description.name);
-    return std::make_shared<Channel>(channel, description.name,
-                                     description.type);
+    return create(channel, description.name, description.type);
   } catch (utils::BadTypeId &bad_type) {
     throw ModelBuildError(
         fmt::format("Can't create channel of type \"{}\"", bad_type.type));
@@ -49,4 +53,11 @@ auto Channel::create(const parser::ConnectionDescription &description)
   // TODO: Not all paths returns value
 }
 
+auto Channel::create(const ns3::Ptr<ns3::Channel> &channel,
+                     const std::string &name, channel_type type)
+    -> std::shared_ptr<Channel> {
+  names::add(channel, name);
+  return std::make_shared<Channel>(channel, name, type);
+}
+
 }  // namespace model
\ No newline at end of file
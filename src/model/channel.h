@@ -18,7 +18,7 @@ struct ConnectionDescription;
 
 namespace model {
 
-enum class channel_type { Undefined, CSMA, PPP };
+enum class channel_type { Undefined, CSMA, PPP, Ideal };
 
 class Channel {
  public:
@@ -29,6 +29,18 @@ class Channel {
   static auto create(const parser::ConnectionDescription &description)
       -> std::shared_ptr<Channel>;
 
+  /**
+   * @brief Wrap created channel and register its name
+   *
+   * @param channel
+   * @param name
+   * @param type
+   * @return std::shared_ptr<Channel>
+   */
+  static auto create(const ns3::Ptr<ns3::Channel> &channel,
+                     const std::string &name, channel_type type)
+      -> std::shared_ptr<Channel>;
+
   auto get() const -> ns3::Ptr<ns3::Channel> { return _channel; }
 
   auto type() const -> channel_type { return _type; }
@@ -52,6 +64,10 @@ inline auto channel_from_string(const std::string& str) noexcept
     return channel_type::PPP;
   }
 
+  if (type == "ideal") {
+    return channel_type::Ideal;
+  }
+
   return {};
 }
 
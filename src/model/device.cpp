@@ -12,10 +12,13 @@
 #include <ns3/object.h>
 #include <ns3/point-to-point-channel.h>
 #include <ns3/point-to-point-net-device.h>
+#include <ns3/simple-net-device.h>
 
 #include <fmt/core.h>
 
 #include "model/channel.h"
+#include "model/device_capture.h"
+#include "model/ideal_channel.h"
 #include "model_build_error.h"
 #include "parser/parser.h"
 #include "utils/address.h"
@@ -30,6 +33,8 @@ auto create(model::device_type type) -> ns3::Ptr<ns3::NetDevice> {
       return utils::create<ns3::NetDevice>("ns3::CsmaNetDevice");
     case device_type::PPP:
       return utils::create<ns3::NetDevice>("ns3::PointToPointNetDevice");
+    case device_type::Ideal:
+      return utils::create<ns3::NetDevice>("ns3::SimpleNetDevice");
     default:
       return nullptr;
   }
@@ -72,7 +77,20 @@ Device Device::create(const parser::DeviceDescription &description) {
     ipv6.emplace_back(address::to_ns3_v6(ip));
   }
 
-  return {device, description.name, *type, std::move(ipv4), std::move(ipv6)};
+  Device result{device, description.name, *type, std::move(ipv4),
+                std::move(ipv6)};
+
+  if (description.capture.has_value()) {
+    result.enable_capture(*description.capture);
+  }
+
+  return result;
+}
+
+void Device::enable_capture(const parser::CaptureDescription &description) {
+  auto link = _type == device_type::PPP ? stats::link_type::ppp
+                                        : stats::link_type::ethernet;
+  _capture = std::make_shared<DeviceCapture>(description, _name, _device, link);
 }
 
 void Device::attach(const std::shared_ptr<Channel> &channel) {
@@ -91,6 +109,11 @@ void Device::attach(const std::shared_ptr<Channel> &channel) {
     auto ppp_device = _device->GetObject<ns3::PointToPointNetDevice>();
     auto ppp_channel = channel->get()->GetObject<ns3::PointToPointChannel>();
     ppp_device->Attach(ppp_channel);
+  } else if (_type == device_type::Ideal &&
+             channel->type() == channel_type::Ideal) {
+    auto simple_device = _device->GetObject<ns3::SimpleNetDevice>();
+    auto ideal_channel = channel->get()->GetObject<IdealChannel>();
+    simple_device->SetChannel(ideal_channel);
   } else {
     throw ModelBuildError(fmt::format(
         R"(Can't attach channel "{}" to device "{}")", channel->name(), _name));
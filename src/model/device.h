@@ -17,14 +17,16 @@
 // IWYU pragma: no_include <boost/iterator/iterator_facade.hpp>
 
 namespace parser {
+struct CaptureDescription;
 struct DeviceDescription;
-}
+}  // namespace parser
 
 namespace model {
 
 class Channel;
+class DeviceCapture;
 
-enum class device_type { Undedined, CSMA, PPP };
+enum class device_type { Undedined, CSMA, PPP, Ideal };
 
 /**
  * @brief ns3::NetDevice wrapper
@@ -32,6 +34,14 @@ enum class device_type { Undedined, CSMA, PPP };
  */
 class Device {
  public:
+  /**
+   * @brief Wrap created device, which is not added to node yet
+   *
+   */
+  Device(const ns3::Ptr<ns3::NetDevice>& device, std::string name,
+         device_type type, std::vector<ns3::Ipv4InterfaceAddress> ipv4,
+         std::vector<ns3::Ipv6InterfaceAddress> ipv6);
+
   static Device create(const parser::DeviceDescription& description);
 
   /**
@@ -62,11 +72,20 @@ class Device {
 
   bool has_channel() const;
 
- private:
-  Device(const ns3::Ptr<ns3::NetDevice>& device, std::string name,
-         device_type type, std::vector<ns3::Ipv4InterfaceAddress> ipv4,
-         std::vector<ns3::Ipv6InterfaceAddress> ipv6);
+  /**
+   * @brief Packet capture of device, null if not configured
+   *
+   */
+  auto capture() const -> std::shared_ptr<DeviceCapture> { return _capture; }
 
+  /**
+   * @brief Capture packets of device into pcapng file
+   *
+   * @param description
+   */
+  void enable_capture(const parser::CaptureDescription& description);
+
+ private:
   std::string _name;
   device_type _type;
   ns3::Ptr<ns3::NetDevice> _device;
@@ -75,6 +94,8 @@ class Device {
 
   std::vector<ns3::Ipv4InterfaceAddress> _ipv4_addresses;
   std::vector<ns3::Ipv6InterfaceAddress> _ipv6_addresses;
+
+  std::shared_ptr<DeviceCapture> _capture;
 };
 
 inline auto device_type_from_string(const std::string& str) noexcept
@@ -88,6 +109,10 @@ inline auto device_type_from_string(const std::string& str) noexcept
     return device_type::PPP;
   }
 
+  if (type == "ideal") {
+    return device_type::Ideal;
+  }
+
   return {};
 }
 
@@ -0,0 +1,73 @@
+#include "device_capture.h"
+
+#include <algorithm>
+
+#include <ns3/callback.h>
+#include <ns3/simulator.h>
+
+#include <fmt/core.h>
+
+#include "model/model_build_error.h"
+#include "stats/writer.h"
+
+namespace model {
+
+namespace {
+auto open_writer(const parser::CaptureDescription &descr,
+                 const std::string &device_name, stats::link_type link)
+    -> stats::PcapngWriter {
+  try {
+    return {descr.file + ".pcapng", link, descr.snap_length, device_name};
+  } catch (stats::OutputError &e) {
+    throw ModelBuildError(fmt::format(R"(Can't create capture of "{}": {})",
+                                      device_name, e.what()));
+  }
+}
+}  // namespace
+
+DeviceCapture::DeviceCapture(const parser::CaptureDescription &descr,
+                             const std::string &device_name,
+                             const ns3::Ptr<ns3::NetDevice> &device,
+                             stats::link_type link)
+    : _file{descr.file},
+      _snap_length{descr.snap_length},
+      _filter{link, descr.protocol, descr.port},
+      _sampler{descr.sample, 0},
+      _writer{open_writer(descr, device_name, link)},
+      _buffer(std::max<std::size_t>(_snap_length,
+                                    stats::PacketFilter::header_bytes)) {
+  if (!device->TraceConnectWithoutContext(
+          "Sniffer", ns3::MakeCallback(&DeviceCapture::on_packet, this))) {
+    throw ModelBuildError(fmt::format(
+        R"(Device "{}" doesn't support packet capture)", device_name));
+  }
+}
+
+void DeviceCapture::on_packet(ns3::Ptr<const ns3::Packet> packet) {
+  auto size = packet->GetSize();
+
+  // Most packets are dropped by the filter or the sampler, only headers are
+  // copied for them
+  auto copied = packet->CopyData(
+      _buffer.data(), static_cast<std::uint32_t>(std::min<std::size_t>(
+                          size, stats::PacketFilter::header_bytes)));
+
+  if (!_filter.match(_buffer.data(), copied)) {
+    return;
+  }
+
+  auto now = ns3::Simulator::Now();
+  if (!_sampler.accept(now.GetTimeStep())) {
+    return;
+  }
+
+  auto snapped = std::min(size, _snap_length);
+  if (snapped > copied) {
+    copied = packet->CopyData(_buffer.data(), snapped);
+  }
+
+  _writer.write(static_cast<std::uint64_t>(now.GetNanoSeconds()),
+                _buffer.data(), std::min(copied, snapped), size);
+}
+
+}  // namespace model
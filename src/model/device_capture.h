@@ -0,0 +1,68 @@
+#ifndef __DEVICE_CAPTURE_H_P6C1HX9WAZ4L__
+#define __DEVICE_CAPTURE_H_P6C1HX9WAZ4L__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <ns3/net-device.h>
+#include <ns3/packet.h>
+#include <ns3/ptr.h>
+
+#include "parser/parser.h"
+#include "stats/packet_filter.h"
+#include "stats/pcapng_writer.h"
+#include "stats/sample_filter.h"
+
+namespace model {
+
+/**
+ * @brief Sampled packet capture of one device to pcapng file
+ *
+ * Packets of the device sniffer trace are matched by filter, every N-th
+ * matching packet is written truncated to snap length. Only the header bytes
+ * needed by filter are copied out of every packet, snap length bytes are
+ * copied only out of written ones.
+ */
+class DeviceCapture {
+ public:
+  /**
+   * @brief Create capture file and connect to device
+   *
+   * @param descr
+   * @param device_name name of interface in capture file
+   * @param device
+   * @param link link layer of device frames
+   * @throws ModelBuildError if file can't be created or device has no sniffer
+   */
+  DeviceCapture(const parser::CaptureDescription &descr,
+                const std::string &device_name,
+                const ns3::Ptr<ns3::NetDevice> &device, stats::link_type link);
+
+  DeviceCapture(const DeviceCapture &) = delete;
+  DeviceCapture &operator=(const DeviceCapture &) = delete;
+
+  void flush() { _writer.flush(); }
+
+  auto file() const -> const std::string & { return _file; }
+
+  /**
+   * @brief Counters of matching packets written and skipped by sampling
+   *
+   */
+  auto sampler() const -> const stats::SampleFilter & { return _sampler; }
+
+ private:
+  void on_packet(ns3::Ptr<const ns3::Packet> packet);
+
+  std::string _file;
+  std::uint32_t _snap_length;
+  stats::PacketFilter _filter;
+  stats::SampleFilter _sampler;
+  stats::PcapngWriter _writer;
+  std::vector<std::uint8_t> _buffer;
+};
+
+}  // namespace model
+
+#endif  // __DEVICE_CAPTURE_H_P6C1HX9WAZ4L__
@@ -0,0 +1,87 @@
+#include "ideal_channel.h"
+
+#include <array>
+
+#include <ns3/node.h>
+#include <ns3/nstime.h>
+#include <ns3/simulator.h>
+
+namespace model {
+
+NS_OBJECT_ENSURE_REGISTERED(IdealChannel);
+
+namespace {
+auto address_key(const ns3::Mac48Address &address) -> std::uint64_t {
+  std::array<std::uint8_t, 6> bytes{};
+  address.CopyTo(bytes.data());
+
+  std::uint64_t key = 0;
+  for (auto byte : bytes) {
+    key = (key << 8) | byte;
+  }
+  return key;
+}
+}  // namespace
+
+auto IdealChannel::GetTypeId() -> ns3::TypeId {
+  static ns3::TypeId tid = ns3::TypeId("model::IdealChannel")
+                               .SetParent<ns3::SimpleChannel>()
+                               .SetGroupName("Network")
+                               .AddConstructor<IdealChannel>();
+  return tid;
+}
+
+IdealChannel::IdealChannel() {
+  ns3::TypeId::AttributeInformation delay;
+  GetTypeId().LookupAttributeByName("Delay", &delay);
+  _delay_accessor = delay.accessor;
+}
+
+void IdealChannel::Send(ns3::Ptr<ns3::Packet> packet, std::uint16_t protocol,
+                        ns3::Mac48Address to, ns3::Mac48Address from,
+                        ns3::Ptr<ns3::SimpleNetDevice> sender) {
+  ns3::TimeValue delay;
+  _delay_accessor->Get(this, delay);
+
+  if (!to.IsGroup()) {
+    auto it = _device_per_address.find(address_key(to));
+    if (it != _device_per_address.end() && it->second != sender) {
+      Deliver(it->second, packet, protocol, to, from, delay.Get());
+    }
+    return;
+  }
+
+  // Context of every receiver must be its node, so group frames can't be
+  // delivered to all devices by one event
+  for (const auto &device : _devices) {
+    if (device != sender) {
+      Deliver(device, packet, protocol, to, from, delay.Get());
+    }
+  }
+}
+
+void IdealChannel::Deliver(const ns3::Ptr<ns3::SimpleNetDevice> &receiver,
+                           const ns3::Ptr<ns3::Packet> &packet,
+                           std::uint16_t protocol, ns3::Mac48Address to,
+                           ns3::Mac48Address from,
+                           const ns3::Time &delay) const {
+  ns3::Simulator::ScheduleWithContext(
+      receiver->GetNode()->GetId(), delay, &ns3::SimpleNetDevice::Receive,
+      receiver, packet->Copy(), protocol, to, from);
+}
+
+void IdealChannel::Add(ns3::Ptr<ns3::SimpleNetDevice> device) {
+  _devices.push_back(device);
+  _device_per_address[address_key(
+      ns3::Mac48Address::ConvertFrom(device->GetAddress()))] = device;
+}
+
+auto IdealChannel::GetNDevices() const -> std::size_t {
+  return _devices.size();
+}
+
+auto IdealChannel::GetDevice(std::size_t i) const -> ns3::Ptr<ns3::NetDevice> {
+  return _devices[i];
+}
+
+}  // namespace model
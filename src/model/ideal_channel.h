@@ -0,0 +1,62 @@
+#ifndef __IDEAL_CHANNEL_H_J4W8NZ2RFP6B__
+#define __IDEAL_CHANNEL_H_J4W8NZ2RFP6B__
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <ns3/attribute.h>
+#include <ns3/mac48-address.h>
+#include <ns3/net-device.h>
+#include <ns3/nstime.h>
+#include <ns3/packet.h>
+#include <ns3/ptr.h>
+#include <ns3/simple-channel.h>
+#include <ns3/simple-net-device.h>
+#include <ns3/type-id.h>
+
+namespace model {
+
+/**
+ * @brief Channel with fixed delay and no medium access
+ *
+ * Unicast frames are delivered only to the owner of the destination MAC,
+ * found by hash lookup, instead of every attached device as in
+ * ns3::SimpleChannel. Group frames are delivered to every other device.
+ * Rate is limited by the "DataRate" of attached ns3::SimpleNetDevice.
+ */
+class IdealChannel final : public ns3::SimpleChannel {
+ public:
+  static auto GetTypeId() -> ns3::TypeId;
+
+  IdealChannel();
+
+  void Send(ns3::Ptr<ns3::Packet> packet, std::uint16_t protocol,
+            ns3::Mac48Address to, ns3::Mac48Address from,
+            ns3::Ptr<ns3::SimpleNetDevice> sender) override;
+
+  void Add(ns3::Ptr<ns3::SimpleNetDevice> device) override;
+
+  auto GetNDevices() const -> std::size_t override;
+
+  auto GetDevice(std::size_t i) const -> ns3::Ptr<ns3::NetDevice> override;
+
+ private:
+  void Deliver(const ns3::Ptr<ns3::SimpleNetDevice> &receiver,
+               const ns3::Ptr<ns3::Packet> &packet, std::uint16_t protocol,
+               ns3::Mac48Address to, ns3::Mac48Address from,
+               const ns3::Time &delay) const;
+
+  // "Delay" is declared by ns3::SimpleChannel, its accessor is resolved
+  // once instead of lookup by name on every frame
+  ns3::Ptr<const ns3::AttributeAccessor> _delay_accessor;
+
+  std::vector<ns3::Ptr<ns3::SimpleNetDevice>> _devices;
+  std::unordered_map<std::uint64_t, ns3::Ptr<ns3::SimpleNetDevice>>
+      _device_per_address;
+};
+
+}  // namespace model
+
+#endif  // __IDEAL_CHANNEL_H_J4W8NZ2RFP6B__
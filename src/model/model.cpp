@@ -1,41 +1,125 @@
 #include "model.h"
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <utility>
 
 #include <ns3/ipv4-global-routing-helper.h>
+#include <ns3/mac48-address.h>
+#include <ns3/neighbor-cache-helper.h>
 #include <ns3/nstime.h>
+#include <ns3/rng-seed-manager.h>
 #include <ns3/show-progress.h>
 #include <ns3/simulator.h>
 
 #include <fmt/core.h>
 
+#include "applications/latency_sink.h"
 #include "device.h"
 #include "model/channel.h"
+#include "model/device_capture.h"
 #include "model/model_build_error.h"
+#include "model/name_service.h"
 #include "model/node.h"
+#include "model/polling_registrator.h"
 #include "model/registrator.h"
 #include "parser/parser.h"
+#include "profiling/alloc_counter.h"
+#include "profiling/build_profiler.h"
 
 namespace model {
 
 void Model::build_from_description(
     const parser::ModelDescription &description) {
+  profiling::ScopedPhase phase{"build"};
+
+  build_nodes(description.nodes);
+  build_connections(description.connections);
+
+  // Description is validated by building of nodes and connections
+  if (_topology_enabled) {
+    profiling::ScopedPhase topology_phase{"build/topology"};
+    _topology = std::make_unique<Topology>(Topology::build(description));
+  }
+
+  build_environment(description);
+}
+
+void Model::add_node(std::unique_ptr<Node> node) {
+  _node_per_name[node->name()] = node.get();
+  _nodes.push_back(std::move(node));
+}
+
+void Model::build_from_nodes(const parser::ModelDescription &description) {
+  profiling::ScopedPhase phase{"build"};
+
+  build_environment(description);
+}
+
+void Model::build_environment(const parser::ModelDescription &description) {
   _end_time = ns3::Time{description.end_time};
 
-  // TODO: extract methods
+  // Addresses are assigned on node creation, so all peers are known here
+  if (description.populate_neighbor_cache) {
+    profiling::ScopedPhase neighbor_phase{"build/neighbor-cache"};
+    ns3::NeighborCacheHelper{}.PopulateNeighborCache();
+  }
+
+  const auto &statistics = description.statistics;
+  auto has_registrators =
+      !description.registrators.empty() || !description.pollers.empty();
+
+  if (statistics.async && has_registrators) {
+    _pipeline = std::make_unique<stats::AsyncPipeline>(statistics.queue_size,
+                                                       statistics.overflow);
+    _output.pipeline = _pipeline.get();
+  }
 
-  // Create nodes
-  for (const auto &node_desc : description.nodes) {
-    auto node = Node::create(node_desc);
-    _node_per_name[node->name()] = node.get();
-    _nodes.push_back(std::move(node));
+  if (statistics.container.has_value() && has_registrators) {
+    _output.container =
+        std::make_shared<stats::ContainerFile>(*statistics.container);
   }
 
-  // Create connections
-  for (const auto &connection : description.connections) {
+  _output.compress = statistics.compress;
+  if (statistics.live.has_value()) {
+    _output.live = *statistics.live;
+    _output.live_capacity = statistics.live_capacity;
+  }
+
+  build_registrators(description.registrators);
+  build_pollers(description.pollers);
+
+  if (description.polulate_tables) {
+    profiling::ScopedPhase routing_phase{"build/routing"};
+    profiling::alloc::PhaseScope alloc_phase{profiling::alloc::phase::routing};
+    ns3::Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+  }
+
+  // Flows are routed over complete routing tables
+  if (!description.background.flows.empty()) {
+    profiling::ScopedPhase background_phase{"build/background"};
+    _background = std::make_unique<BackgroundTraffic>(description.background,
+                                                      _nodes);
+  }
+
+  time_resolution = description.time_precision;
+}
+
+void Model::build_nodes(const std::vector<parser::NodeDescription> &nodes) {
+  profiling::ScopedPhase phase{"build/nodes"};
+
+  for (const auto &node_desc : nodes) {
+    add_node(Node::create(node_desc));
+  }
+}
+
+void Model::build_connections(
+    const std::vector<parser::ConnectionDescription> &connections) {
+  profiling::ScopedPhase phase{"build/connections"};
+
+  for (const auto &connection : connections) {
     auto channel = Channel::create(connection);
 
     for (const auto &interface : connection.interfaces) {
@@ -61,19 +145,49 @@ void Model::build_from_description(
       }
     }
   }
+}
 
-  // Create registrators
-  for (const auto &desc : description.registrators) {
-    auto registrator = Registrator::create(desc);
+void Model::build_registrators(
+    const std::vector<parser::RegistratorDescription> &registrators) {
+  profiling::ScopedPhase phase{"build/registrators"};
+
+  for (const auto &desc : registrators) {
+    auto registrator = Registrator::create(
+        desc, make_output_context(desc.file, desc.compress));
     registrator->shedule_init();
     _registrators.push_back(std::move(registrator));
   }
+}
 
-  if (description.polulate_tables) {
-    ns3::Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+void Model::build_pollers(
+    const std::vector<parser::PollerDescription> &pollers) {
+  profiling::ScopedPhase phase{"build/pollers"};
+
+  for (const auto &desc : pollers) {
+    auto poller = std::make_shared<PollingRegistrator>(
+        desc, _end_time, make_output_context(desc.file, desc.compress));
+    poller->shedule_init();
+    _pollers.push_back(std::move(poller));
   }
+}
 
-  time_resolution = description.time_precision;
+auto Model::make_output_context(const std::string &name,
+                                std::optional<stats::compression> compress)
+    const -> stats::OutputContext {
+  auto output = _output;
+  if (compress.has_value()) {
+    output.compress = *compress;
+  }
+
+  // Container is not a plain stream, so it can't be read after compression
+  // by standard tools
+  if (output.container != nullptr &&
+      output.compress != stats::compression::none) {
+    throw ModelBuildError(fmt::format(
+        R"(Output "{}" can't be compressed when written to container)", name));
+  }
+
+  return output;
 }
 
 Node *Model::find_node(const std::string &name) const {
@@ -95,10 +209,92 @@ void Model::start() {
   }
 
   ns3::Simulator::Run();
+
+  finish_statistics();
+}
+
+void Model::finish_statistics() {
+  for (const auto &registrator : _registrators) {
+    registrator->flush();
+
+    if (registrator->filtered()) {
+      std::cout << fmt::format(
+          "Registrator \"{}\": {} of {} samples dropped by decimation\n",
+          registrator->name(), registrator->samples_dropped(),
+          registrator->samples_seen());
+    }
+  }
+
+  for (const auto &poller : _pollers) {
+    poller->flush();
+  }
+
+  for (const auto &node : _nodes) {
+    for (const auto &app : node->applications()) {
+      if (auto sink = ns3::DynamicCast<applications::LatencySink>(app.get());
+          sink != nullptr) {
+        sink->Report();
+      }
+    }
+
+    for (std::size_t i = 0; i < node->devices_count(); ++i) {
+      auto capture = node->get_device(i).capture();
+      if (capture == nullptr) {
+        continue;
+      }
+
+      capture->flush();
+
+      const auto &sampler = capture->sampler();
+      std::cout << fmt::format(
+          "Capture \"{}\": {} of {} matching packets written\n",
+          capture->file(), sampler.accepted(), sampler.seen());
+    }
+  }
+
+  if (_pipeline != nullptr) {
+    _pipeline->stop();
+    if (auto dropped = _pipeline->dropped(); dropped != 0) {
+      std::cerr << fmt::format(
+          "Warning: {} statistics samples dropped on full queue\n", dropped);
+    }
+  }
+
+  if (_output.container != nullptr) {
+    _output.container->close();
+  }
 }
 
 void Model::stop() { ns3::Simulator::Stop(); }
 
+Model::~Model() { reset(); }
+
+void Model::reset() {
+  // Writers of registrators and pollers use channels of the pipeline
+  _registrators.clear();
+  _pollers.clear();
+  _pipeline.reset();
+  _output = {};
+
+  _background.reset();
+  _topology.reset();
+  _node_per_name.clear();
+  _nodes.clear();
+
+  // Runs destroy events of NodeList and ChannelList, which dispose objects
+  // and remove lists themselves
+  ns3::Simulator::Destroy();
+  names::cleanup();
+
+  // Automatically assigned random streams and MAC addresses start over, so
+  // the next model gets the same ones as in a new process
+  ns3::RngSeedManager::ResetNextStreamIndex();
+  ns3::Mac48Address::ResetAllocationIndex();
+
+  _end_time = {};
+  time_resolution = ns3::Time::NS;
+}
+
 void Model::set_resulution(ns3::Time::Unit resulution) {
   ns3::Time::SetResolution(resulution);
 }
@@ -3,42 +3,169 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include <ns3/nstime.h>
 
+#include "background_traffic.h"
 #include "node.h"
+#include "stats/async_writer.h"
+#include "stats/compression.h"
+#include "stats/output.h"
+#include "topology.h"
 
 namespace parser {
 struct ModelDescription;
-}
+struct NodeDescription;
+struct ConnectionDescription;
+struct RegistratorDescription;
+struct PollerDescription;
+}  // namespace parser
 
 namespace model {
 
 class Registrator;
+class PollingRegistrator;
 
 class Model {
  public:
+  Model() = default;
+
+  Model(const Model &) = delete;
+  Model &operator=(const Model &) = delete;
+
+  /**
+   * @brief Release ns-3 state of the model, see reset()
+   *
+   */
+  ~Model();
+
   void build_from_description(const parser::ModelDescription &description);
 
+  /**
+   * @brief Add node created and connected outside of the model, e.g. by
+   * generated code
+   *
+   * @param node
+   */
+  void add_node(std::unique_ptr<Node> node);
+
+  /**
+   * @brief Build statistics, routing and background traffic of description
+   * over nodes added by add_node()
+   *
+   * Nodes and connections of description are not built, topology is not
+   * built even if enabled.
+   *
+   * @param description
+   */
+  void build_from_nodes(const parser::ModelDescription &description);
+
   Node *find_node(const std::string &name) const;
 
+  auto nodes() const -> const std::vector<std::unique_ptr<Node>> & {
+    return _nodes;
+  }
+
   void start();
 
   void stop();
 
+  /**
+   * @brief Destroy simulation and global ns-3 state of the model
+   *
+   * Destroys simulator, which disposes nodes and channels and empties
+   * NodeList and ChannelList, clears registered names and resets counters
+   * of random variable streams and MAC addresses, so the next model in the
+   * same process starts with node and channel indices from 0 and runs as in
+   * a new process.
+   * Model can be built from another description afterwards.
+   */
+  void reset();
+
   auto get_registrators() const
       -> const std::vector<std::shared_ptr<Registrator>> & {
     return _registrators;
   }
 
+  auto get_pollers() const
+      -> const std::vector<std::shared_ptr<PollingRegistrator>> & {
+    return _pollers;
+  }
+
+  /**
+   * @brief Flow-level background load, null if model has no flows
+   *
+   */
+  auto background() const -> const BackgroundTraffic * {
+    return _background.get();
+  }
+
+  /**
+   * @brief Build topology graph with the model, it is not built by default
+   *
+   */
+  void enable_topology() { _topology_enabled = true; }
+
+  /**
+   * @brief Graph of nodes and connections for analysis without ns-3 objects,
+   * null unless enabled before build
+   *
+   */
+  auto topology() const -> const Topology * { return _topology.get(); }
+
   void set_resulution(ns3::Time::Unit resulution);
 
  private:
+  void build_nodes(const std::vector<parser::NodeDescription> &nodes);
+
+  void build_connections(
+      const std::vector<parser::ConnectionDescription> &connections);
+
+  void build_registrators(
+      const std::vector<parser::RegistratorDescription> &registrators);
+
+  void build_pollers(const std::vector<parser::PollerDescription> &pollers);
+
+  /**
+   * @brief Build everything of description except nodes, connections and
+   * topology
+   *
+   */
+  void build_environment(const parser::ModelDescription &description);
+
+  /**
+   * @brief Shared outputs with own compression of registrator or poller
+   *
+   * @param name file name of registrator or poller
+   * @param compress overrides compression of statistics settings if set
+   * @throws ModelBuildError if compressed output is written to container
+   */
+  auto make_output_context(const std::string &name,
+                           std::optional<stats::compression> compress) const
+      -> stats::OutputContext;
+
+  /**
+   * @brief Flush registrators, report latency sinks and stop asynchronous
+   * output
+   *
+   */
+  void finish_statistics();
+
   std::vector<std::unique_ptr<Node>> _nodes;
   std::map<std::string, Node *> _node_per_name;
+  bool _topology_enabled = false;
+  std::unique_ptr<Topology> _topology;
+
+  // Declared before registrators, so it outlives their writers
+  std::unique_ptr<stats::AsyncPipeline> _pipeline;
+  stats::OutputContext _output;
   std::vector<std::shared_ptr<Registrator>> _registrators;
+  std::vector<std::shared_ptr<PollingRegistrator>> _pollers;
+
+  std::unique_ptr<BackgroundTraffic> _background;
 
   ns3::Time _end_time{};
   ns3::Time::Unit time_resolution = ns3::Time::NS;
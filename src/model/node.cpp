@@ -26,6 +26,7 @@
 #include "model/model_build_error.h"
 #include "name_service.h"
 #include "parser/parser.h"
+#include "profiling/build_profiler.h"
 #include "utils/address.h"
 
 namespace model {
@@ -98,22 +99,31 @@ void Node::attach(Application &&app) {
 
 auto Node::create(const parser::NodeDescription &description)
     -> std::unique_ptr<Node> {
-  auto node = create_ns3_node();
-  names::add(node, description.name);
-
-  auto ret = std::make_unique<Node>(node, description.name);
+  auto ret = create_empty(description.name);
 
   ret->create_devices(description.devices);
 
   ret->create_applications(description.applications);
 
-  ret->add_ipv4_routes(description.routing.ipv4);
-  ret->add_ipv6_routes(description.routing.ipv6);
+  {
+    profiling::ScopedPhase phase{"build/nodes/routes"};
+    ret->add_ipv4_routes(description.routing.ipv4);
+    ret->add_ipv6_routes(description.routing.ipv6);
+  }
 
   return ret;
 }
 
+auto Node::create_empty(const std::string &name) -> std::unique_ptr<Node> {
+  auto node = create_ns3_node();
+  names::add(node, name);
+
+  return std::make_unique<Node>(node, name);
+}
+
 auto Node::create_ns3_node() -> ns3::Ptr<ns3::Node> {
+  profiling::ScopedPhase phase{"build/nodes/stack"};
+
   auto node = ns3::CreateObject<ns3::Node>();
   ns3::InternetStackHelper stack;
   stack.Install(node);
@@ -122,6 +132,8 @@ auto Node::create_ns3_node() -> ns3::Ptr<ns3::Node> {
 
 void Node::create_devices(
     const std::vector<parser::DeviceDescription> &devices) {
+  profiling::ScopedPhase phase{"build/nodes/devices"};
+
   for (const auto &device_desc : devices) {
     this->attach(Device::create(device_desc));
   }
@@ -129,6 +141,8 @@ void Node::create_devices(
 
 void Node::create_applications(
     const std::vector<parser::ApplicationDescription> &applications) {
+  profiling::ScopedPhase phase{"build/nodes/applications"};
+
   for (const auto &app : applications) {
     this->attach(Application::create(app));
   }
@@ -47,6 +47,8 @@ class Node {
     return _devices.at(index);
   }
 
+  auto get_device(std::size_t index) -> Device & { return _devices.at(index); }
+
   auto devices_count() const -> std::size_t { return _devices.size(); }
 
   /**
@@ -83,6 +85,15 @@ class Node {
   static auto create(const parser::NodeDescription &description)
       -> std::unique_ptr<Node>;
 
+  /**
+   * @brief Create named node with internet stack, devices and applications
+   * are attached afterwards
+   *
+   * @param name
+   * @return std::unique_ptr<Node>
+   */
+  static auto create_empty(const std::string &name) -> std::unique_ptr<Node>;
+
   /**
    * @brief Get the device by name object
    *
@@ -106,13 +117,25 @@ class Node {
    */
   void create_devices(const std::vector<parser::DeviceDescription> &devices);
 
- private:
+  /**
+   * @brief Add device to node and set up its interfaces and addresses
+   *
+   * @param device
+   * @throws ModelBuildError if address can't be assigned
+   */
   void attach(Device &&device);
-  void setup_ipv4_interface(const Device &device);
-  void setup_ipv6_interface(const Device &device);
 
+  /**
+   * @brief Add application to node
+   *
+   * @param app
+   */
   void attach(Application &&app);
 
+ private:
+  void setup_ipv4_interface(const Device &device);
+  void setup_ipv6_interface(const Device &device);
+
   void add_ipv4_routes(const std::vector<parser::Ipv4Route> &routes);
   void add_ipv6_routes(const std::vector<parser::Ipv6Route> &routes);
 
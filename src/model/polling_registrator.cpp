@@ -0,0 +1,202 @@
+#include "polling_registrator.h"
+
+#include <optional>
+#include <utility>
+
+#include <ns3/boolean.h>
+#include <ns3/double.h>
+#include <ns3/enum.h>
+#include <ns3/integer.h>
+#include <ns3/names.h>
+#include <ns3/packet-sink.h>
+#include <ns3/pointer.h>
+#include <ns3/queue.h>
+#include <ns3/simulator.h>
+#include <ns3/uinteger.h>
+
+#include <fmt/core.h>
+
+#include "applications/latency_sink.h"
+#include "model/model_build_error.h"
+#include "stats/output.h"
+
+namespace model {
+
+namespace {
+using Reader = std::function<double()>;
+
+auto find_object(const std::string &path) -> ns3::Ptr<ns3::Object> {
+  auto full_path = path.rfind("/Names/", 0) == 0 ? path : "/Names/" + path;
+  auto object = ns3::Names::Find<ns3::Object>(full_path);
+  if (object == nullptr) {
+    throw ModelBuildError(fmt::format(R"(Unknown object "{}")", path));
+  }
+  return object;
+}
+
+template <typename ValueType>
+auto typed_reader(const std::function<void()> &read,
+                  const ns3::Ptr<ns3::AttributeValue> &value)
+    -> std::optional<Reader> {
+  auto typed = ns3::DynamicCast<ValueType>(value);
+  if (typed == nullptr) {
+    return {};
+  }
+
+  return [read, typed] {
+    read();
+    return static_cast<double>(typed->Get());
+  };
+}
+
+auto attribute_reader(const ns3::Ptr<ns3::Object> &object,
+                      const parser::PolledValueDescription &descr) -> Reader {
+  ns3::TypeId::AttributeInformation info;
+  if (!object->GetInstanceTypeId().LookupAttributeByName(descr.attribute,
+                                                         &info) ||
+      (info.flags & ns3::TypeId::ATTR_GET) == 0 ||
+      !info.accessor->HasGetter()) {
+    throw ModelBuildError(fmt::format(R"(Can't read attribute "{}" of "{}")",
+                                      descr.attribute, descr.object));
+  }
+
+  // Value is created once and refilled on every read
+  ns3::Ptr<ns3::AttributeValue> value = info.checker->Create();
+  auto read = [object, accessor = info.accessor, value] {
+    accessor->Get(ns3::PeekPointer(object), *value);
+  };
+
+  if (auto time = ns3::DynamicCast<ns3::TimeValue>(value); time != nullptr) {
+    return [read, time] {
+      read();
+      return time->Get().GetSeconds();
+    };
+  }
+
+  for (const auto &reader :
+       {typed_reader<ns3::DoubleValue>(read, value),
+        typed_reader<ns3::UintegerValue>(read, value),
+        typed_reader<ns3::IntegerValue>(read, value),
+        typed_reader<ns3::BooleanValue>(read, value),
+        typed_reader<ns3::EnumValue>(read, value)}) {
+    if (reader.has_value()) {
+      return *reader;
+    }
+  }
+
+  throw ModelBuildError(fmt::format(
+      R"(Attribute "{}" of "{}" is not numeric)", descr.attribute,
+      descr.object));
+}
+
+// Queue itself or transmit queue of the device
+auto find_queue(const ns3::Ptr<ns3::Object> &object)
+    -> ns3::Ptr<ns3::QueueBase> {
+  if (auto queue = ns3::DynamicCast<ns3::QueueBase>(object);
+      queue != nullptr) {
+    return queue;
+  }
+
+  ns3::PointerValue pointer;
+  if (object->GetAttributeFailSafe("TxQueue", pointer)) {
+    return pointer.Get<ns3::QueueBase>();
+  }
+
+  return nullptr;
+}
+
+auto getter_reader(const ns3::Ptr<ns3::Object> &object,
+                   const parser::PolledValueDescription &descr) -> Reader {
+  if (descr.getter == "TotalRx") {
+    if (auto sink = ns3::DynamicCast<ns3::PacketSink>(object);
+        sink != nullptr) {
+      return [sink] { return static_cast<double>(sink->GetTotalRx()); };
+    }
+    if (auto sink = ns3::DynamicCast<applications::LatencySink>(object);
+        sink != nullptr) {
+      return [sink] { return static_cast<double>(sink->GetTotalRx()); };
+    }
+  } else if (descr.getter == "NPackets" || descr.getter == "NBytes") {
+    if (auto queue = find_queue(object); queue != nullptr) {
+      if (descr.getter == "NPackets") {
+        return [queue] { return static_cast<double>(queue->GetNPackets()); };
+      }
+      return [queue] { return static_cast<double>(queue->GetNBytes()); };
+    }
+  } else {
+    throw ModelBuildError(
+        fmt::format(R"(Unknown getter "{}" of "{}")", descr.getter,
+                    descr.object));
+  }
+
+  throw ModelBuildError(
+      fmt::format(R"(Object "{}" of type "{}" has no getter "{}")",
+                  descr.object, object->GetInstanceTypeId().GetName(),
+                  descr.getter));
+}
+}  // namespace
+
+PollingRegistrator::PollingRegistrator(const parser::PollerDescription &descr,
+                                       const ns3::Time &model_end_time,
+                                       stats::OutputContext output)
+    : _file_name{descr.file},
+      _format{descr.format},
+      _output{std::move(output)},
+      _period{descr.period},
+      _init_time{descr.start_time},
+      _end_time{descr.end_time.has_value() ? ns3::Time{*descr.end_time}
+                                           : model_end_time} {
+  if (!_period.IsStrictlyPositive()) {
+    throw ModelBuildError(fmt::format(
+        R"(Polling period of registrator "{}" must be positive)", _file_name));
+  }
+
+  // Polling is rescheduled forever without end time
+  if (!_end_time.IsStrictlyPositive()) {
+    throw ModelBuildError(fmt::format(
+        R"(Polling registrator "{}" requires end time or model duration)",
+        _file_name));
+  }
+
+  for (const auto &value : descr.values) {
+    auto object = find_object(value.object);
+    _readers.push_back(value.attribute.empty()
+                           ? getter_reader(object, value)
+                           : attribute_reader(object, value));
+    _columns.push_back(value.name);
+  }
+  _row.resize(_readers.size());
+}
+
+void PollingRegistrator::shedule_init() {
+  _event = ns3::Simulator::Schedule(_init_time,
+                                    &PollingRegistrator::initialize, this);
+}
+
+void PollingRegistrator::flush() {
+  if (_writer != nullptr) {
+    _writer->flush();
+  }
+}
+
+void PollingRegistrator::initialize() {
+  _writer = stats::make_output(_format, _file_name, _columns,
+                               ns3::TimeStep(1).GetSeconds(), _output);
+  poll();
+}
+
+void PollingRegistrator::poll() {
+  for (std::size_t i = 0; i < _readers.size(); ++i) {
+    _row[i] = _readers[i]();
+  }
+
+  auto now = ns3::Simulator::Now();
+  _writer->write(now.GetTimeStep(), _row.data());
+
+  if (now + _period <= _end_time) {
+    _event =
+        ns3::Simulator::Schedule(_period, &PollingRegistrator::poll, this);
+  }
+}
+
+}  // namespace model
@@ -0,0 +1,72 @@
+#ifndef __POLLING_REGISTRATOR_H_J6N3TD0WKP8F__
+#define __POLLING_REGISTRATOR_H_J6N3TD0WKP8F__
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ns3/event-id.h>
+#include <ns3/nstime.h>
+
+#include "parser/parser.h"
+#include "stats/output.h"
+#include "stats/writer.h"
+
+namespace model {
+
+/**
+ * @brief Samples values of model objects with fixed period
+ *
+ * Objects are resolved once through the name registry, then one event per
+ * period reads all values and writes them as one row.
+ */
+class PollingRegistrator {
+ public:
+  /**
+   * @brief Construct polling registrator
+   *
+   * @param descr
+   * @param model_end_time end of polling if not set by description
+   * @param output shared outputs, samples are written to own file on the
+   * simulation thread by default
+   * @throws ModelBuildError if object or value can't be resolved
+   */
+  PollingRegistrator(const parser::PollerDescription &descr,
+                     const ns3::Time &model_end_time,
+                     stats::OutputContext output = {});
+
+  void shedule_init();
+
+  auto name() const -> const std::string & { return _file_name; }
+
+  /**
+   * @brief Write buffered rows to the output file
+   *
+   */
+  void flush();
+
+ private:
+  void initialize();
+
+  void poll();
+
+  std::string _file_name;
+  stats::output_format _format;
+  stats::OutputContext _output;
+
+  ns3::Time _period;
+  ns3::Time _init_time;
+  ns3::Time _end_time;
+
+  std::vector<std::string> _columns;
+  std::vector<std::function<double()>> _readers;
+  std::vector<double> _row;
+
+  ns3::EventId _event;
+  std::unique_ptr<stats::Writer> _writer;
+};
+
+}  // namespace model
+
+#endif  // __POLLING_REGISTRATOR_H_J6N3TD0WKP8F__
@@ -0,0 +1,330 @@
+#include "registrator.h"
+
+#include <fnmatch.h>
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <ns3/callback.h>
+#include <ns3/config.h>
+#include <ns3/file-aggregator.h>
+#include <ns3/names.h>
+#include <ns3/node-list.h>
+#include <ns3/simulator.h>
+
+#include <fmt/core.h>
+
+#include "model/model_build_error.h"
+#include "stats/output.h"
+#include "utils/object.h"
+
+namespace model {
+
+namespace {
+enum class sink_type { Double, Boolean, Uinteger8, Uinteger16, Uinteger32 };
+
+// Types of probe sinks, the same as used by ns3::FileHelper
+auto probe_sink_type(const std::string &probe_type) noexcept
+    -> std::optional<sink_type> {
+  static const std::map<std::string, sink_type> sink_types = {
+      {"ns3::DoubleProbe", sink_type::Double},
+      {"ns3::TimeProbe", sink_type::Double},
+      {"ns3::BooleanProbe", sink_type::Boolean},
+      {"ns3::Uinteger8Probe", sink_type::Uinteger8},
+      {"ns3::Uinteger16Probe", sink_type::Uinteger16},
+      {"ns3::Uinteger32Probe", sink_type::Uinteger32},
+      {"ns3::PacketProbe", sink_type::Uinteger32},
+      {"ns3::ApplicationPacketProbe", sink_type::Uinteger32},
+      {"ns3::Ipv4PacketProbe", sink_type::Uinteger32},
+      {"ns3::Ipv6PacketProbe", sink_type::Uinteger32},
+  };
+
+  if (auto it = sink_types.find(probe_type); it != sink_types.end()) {
+    return it->second;
+  }
+  return {};
+}
+
+constexpr std::string_view names_prefix = "/Names/";
+
+// Config path wildcards and node name patterns
+bool is_wildcard(const std::string &path) noexcept {
+  return path.find_first_of("*?[|") != std::string::npos;
+}
+
+// Replace node name pattern "/Names/server-*/..." by paths of matching nodes
+auto expand_node_names(const std::string &path) -> std::vector<std::string> {
+  if (path.rfind(names_prefix, 0) != 0) {
+    return {path};
+  }
+
+  auto name_end = path.find('/', names_prefix.size());
+  auto pattern =
+      path.substr(names_prefix.size(), name_end - names_prefix.size());
+  if (pattern.find_first_of("*?[") == std::string::npos) {
+    return {path};
+  }
+
+  auto rest = name_end == std::string::npos ? "" : path.substr(name_end);
+
+  std::vector<std::string> paths;
+  for (auto it = ns3::NodeList::Begin(); it != ns3::NodeList::End(); ++it) {
+    auto name = ns3::Names::FindName(*it);
+    if (!name.empty() && fnmatch(pattern.c_str(), name.c_str(), 0) == 0) {
+      paths.push_back(fmt::format("{}{}{}", names_prefix, name, rest));
+    }
+  }
+  return paths;
+}
+}  // namespace
+
+Registrator::Registrator(const parser::RegistratorDescription &descr,
+                         stats::OutputContext output)
+    : _probe_type{descr.type},
+      _file_name{descr.file},
+      _trace{descr.source},
+      _wildcard{is_wildcard(descr.source)},
+      _sink{descr.sink},
+      _value_name{descr.value_name},
+      _format{descr.format},
+      _output{std::move(output)},
+      _statistics{descr.statistics},
+      _decimate{descr.decimate},
+      _init_time{descr.start_time},
+      _end_time{descr.end_time.has_value() ? descr.end_time.value() : "0s"} {
+  if (descr.window.has_value()) {
+    _window = ns3::Time{*descr.window};
+    if (!_window->IsStrictlyPositive()) {
+      throw ModelBuildError(fmt::format(
+          R"(Aggregation window of registrator "{}" must be positive)",
+          _file_name));
+    }
+  }
+
+  if (descr.min_interval.has_value()) {
+    _min_interval = ns3::Time{*descr.min_interval};
+  }
+
+  if (streamed() && !probe_sink_type(_probe_type).has_value()) {
+    throw ModelBuildError(fmt::format(
+        R"(Unsupported probe type "{}" of registrator "{}")", _probe_type,
+        _file_name));
+  }
+}
+
+void Registrator::shedule_init() {
+  // NOLINTNEXTLINE
+  _init_event =
+      ns3::Simulator::Schedule(_init_time, [self = this->weak_from_this()]() {
+        if (!self.expired()) {
+          self.lock()->initialize();
+        }
+      });
+}
+
+void Registrator::flush() {
+  if (_writer != nullptr) {
+    _writer->flush();
+  }
+}
+
+void Registrator::initialize() {
+  if (!streamed()) {
+    initialize_file_helper();
+  } else {
+    initialize_stream();
+  }
+}
+
+void Registrator::initialize_file_helper() {
+  _file_helper.ConfigureFile(_file_name, ns3::FileAggregator::COMMA_SEPARATED);
+  _file_helper.SetHeading(fmt::format("Time,{}", _value_name));
+
+  // TODO: check probe type, _trace ans sink
+  _file_helper.WriteProbe(_probe_type, _trace, _sink);
+
+  auto probe = _file_helper.GetProbe("FileProbe-1");
+  probe->SetAttribute("Stop", ns3::TimeValue(_end_time));
+}
+
+void Registrator::initialize_stream() {
+  _filter = stats::SampleFilter{
+      _decimate, _min_interval.has_value() ? _min_interval->GetTimeStep() : 0};
+
+  if (_wildcard) {
+    initialize_matches();
+    return;
+  }
+
+  _writer = make_writer(false);
+
+  auto probe = utils::create<ns3::Probe>(_probe_type);
+  probe->SetAttribute("Stop", ns3::TimeValue(_end_time));
+  probe->ConnectByPath(_trace);
+  connect(probe, std::nullopt);
+  _probes.push_back(probe);
+}
+
+void Registrator::initialize_matches() {
+  // Aggregated windows summarize samples of all objects
+  auto object_column = !_window.has_value();
+  _writer = make_writer(object_column);
+  _row.resize(object_column ? 2 : 1);
+
+  std::ofstream objects{_file_name + ".objects.txt"};
+  objects << "object,path\n";
+
+  std::uint32_t index = 0;
+  for (const auto &path : expand_node_names(_trace)) {
+    auto trace_begin = path.rfind('/');
+    auto trace_source = path.substr(trace_begin + 1);
+
+    auto matches = ns3::Config::LookupMatches(path.substr(0, trace_begin));
+    for (std::size_t i = 0; i < matches.GetN(); ++i, ++index) {
+      auto probe = utils::create<ns3::Probe>(_probe_type);
+      probe->SetAttribute("Stop", ns3::TimeValue(_end_time));
+
+      if (!probe->ConnectByObject(trace_source, matches.Get(i))) {
+        throw ModelBuildError(fmt::format(
+            R"(Can't connect probe "{}" to "{}/{}")", _probe_type,
+            matches.GetMatchedPath(i), trace_source));
+      }
+      connect(probe, index);
+      _probes.push_back(probe);
+
+      objects << index << ',' << matches.GetMatchedPath(i) << '/'
+              << trace_source << '\n';
+    }
+  }
+
+  _object_filters.assign(index, _filter);
+
+  if (index == 0) {
+    std::cerr << fmt::format(
+        "Warning: registrator \"{}\" has no objects matching \"{}\"\n",
+        _file_name, _trace);
+  }
+}
+
+auto Registrator::make_writer(bool object_column)
+    -> std::unique_ptr<stats::Writer> {
+  std::vector<std::string> columns;
+  if (_window.has_value()) {
+    columns = stats::WindowAggregator::columns(_value_name, _statistics);
+  } else {
+    if (object_column) {
+      columns.emplace_back("object");
+    }
+    columns.push_back(_value_name);
+  }
+
+  auto writer = stats::make_output(_format, _file_name, std::move(columns),
+                                   ns3::TimeStep(1).GetSeconds(), _output);
+
+  // Windows are summarized on the simulation thread, so only summaries are
+  // passed to the output
+  if (_window.has_value()) {
+    writer = std::make_unique<stats::WindowAggregator>(
+        _window->GetTimeStep(), _statistics, std::move(writer));
+  }
+
+  return writer;
+}
+
+void Registrator::connect(const ns3::Ptr<ns3::Probe> &probe,
+                          std::optional<std::uint32_t> object) {
+  bool connected = false;
+  switch (*probe_sink_type(_probe_type)) {
+    case sink_type::Double:
+      connected = connect_sink<double>(probe, object);
+      break;
+    case sink_type::Boolean:
+      connected = connect_sink<bool>(probe, object);
+      break;
+    case sink_type::Uinteger8:
+      connected = connect_sink<uint8_t>(probe, object);
+      break;
+    case sink_type::Uinteger16:
+      connected = connect_sink<uint16_t>(probe, object);
+      break;
+    case sink_type::Uinteger32:
+      connected = connect_sink<uint32_t>(probe, object);
+      break;
+  }
+
+  if (!connected) {
+    throw ModelBuildError(fmt::format(
+        R"(Can't connect to sink "{}" of probe "{}")", _sink, _probe_type));
+  }
+}
+
+template <typename T>
+bool Registrator::connect_sink(const ns3::Ptr<ns3::Probe> &probe,
+                               std::optional<std::uint32_t> object) {
+  if (!object.has_value()) {
+    return probe->TraceConnectWithoutContext(
+        _sink, ns3::MakeCallback(&Registrator::on_value<T>, this));
+  }
+
+  return probe->TraceConnectWithoutContext(
+      _sink,
+      ns3::MakeBoundCallback(&Registrator::on_object_value<T>, this, *object));
+}
+
+auto Registrator::samples_seen() const noexcept -> std::uint64_t {
+  auto seen = _filter.seen();
+  for (const auto &filter : _object_filters) {
+    seen += filter.seen();
+  }
+  return seen;
+}
+
+auto Registrator::samples_dropped() const noexcept -> std::uint64_t {
+  auto dropped = _filter.dropped();
+  for (const auto &filter : _object_filters) {
+    dropped += filter.dropped();
+  }
+  return dropped;
+}
+
+bool Registrator::streamed() const noexcept {
+  return _format != stats::output_format::csv ||
+         _output.pipeline != nullptr || _output.container != nullptr ||
+         _output.compress != stats::compression::none ||
+         !_output.live.empty() || _window.has_value() || _decimate > 1 ||
+         _min_interval.has_value() || _wildcard;
+}
+
+template <typename T>
+void Registrator::on_value(T /*old_value*/, T new_value) {
+  auto time = ns3::Simulator::Now().GetTimeStep();
+  if (!_filter.accept(time)) {
+    return;
+  }
+
+  auto value = static_cast<double>(new_value);
+  _writer->write(time, &value);
+}
+
+template <typename T>
+void Registrator::on_object_value(Registrator *self, std::uint32_t object,
+                                  T /*old_value*/, T new_value) {
+  auto time = ns3::Simulator::Now().GetTimeStep();
+  if (!self->_object_filters[object].accept(time)) {
+    return;
+  }
+
+  auto &row = self->_row;
+  if (row.size() == 2) {
+    row[0] = static_cast<double>(object);
+  }
+  row.back() = static_cast<double>(new_value);
+  self->_writer->write(time, row.data());
+}
+
+}  // namespace model
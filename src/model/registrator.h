@@ -1,73 +1,145 @@
 #ifndef __REGISTRATOR_H_RNBREI3Y1PHL__
 #define __REGISTRATOR_H_RNBREI3Y1PHL__
 
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
-#include <ns3/config.h>
 #include <ns3/event-id.h>
-#include <ns3/file-aggregator.h>
 #include <ns3/file-helper.h>
 #include <ns3/nstime.h>
-#include <ns3/simulator.h>
-
-#include <fmt/core.h>
+#include <ns3/probe.h>
+#include <ns3/ptr.h>
 
 #include "parser/parser.h"
+#include "stats/output.h"
+#include "stats/sample_filter.h"
+#include "stats/window_aggregator.h"
+#include "stats/writer.h"
 
 namespace model {
 
 class Registrator : public std::enable_shared_from_this<Registrator> {
  public:
-  explicit Registrator(const parser::RegistratorDescription &descr)
-      : _probe_type{descr.type},
-        _file_name{descr.file},
-        _trace{descr.source},
-        _sink{descr.sink},
-        _value_name{descr.value_name},
-        _init_time{descr.start_time},
-        _end_time{descr.end_time.has_value() ? descr.end_time.value() : "0s"} {}
+  /**
+   * @brief Construct registrator
+   *
+   * @param descr
+   * @param output shared outputs, samples are written to own file on the
+   * simulation thread by default
+   */
+  explicit Registrator(const parser::RegistratorDescription &descr,
+                       stats::OutputContext output = {});
 
   static std::shared_ptr<Registrator> create(
-      const parser::RegistratorDescription &descr) {
-    return std::make_shared<Registrator>(descr);
+      const parser::RegistratorDescription &descr,
+      stats::OutputContext output = {}) {
+    return std::make_shared<Registrator>(descr, std::move(output));
   }
 
-  void shedule_init() {
-    // NOLINTNEXTLINE
-    _init_event =
-        ns3::Simulator::Schedule(_init_time, [self = this->weak_from_this()]() {
-          if (!self.expired()) {
-            self.lock()->initialize();
-          }
-        });
-  }
+  void shedule_init();
 
   auto get_event_id() const -> ns3::EventId { return _init_event; }
 
- private:
-  void initialize() {
-    _file_helper.ConfigureFile(_file_name,
-                               ns3::FileAggregator::COMMA_SEPARATED);
-    _file_helper.SetHeading(fmt::format("Time,{}", _value_name));
+  /**
+   * @brief Write buffered samples to the output file
+   *
+   */
+  void flush();
 
-    // TODO: check probe type, _trace ans sink
-    _file_helper.WriteProbe(_probe_type, _trace, _sink);
+  auto name() const -> const std::string & { return _file_name; }
 
-    auto probe = _file_helper.GetProbe("FileProbe-1");
-    probe->SetAttribute("Stop", ns3::TimeValue(_end_time));
-  }
+  /**
+   * @brief Whether samples are decimated or rate limited
+   *
+   */
+  bool filtered() const noexcept { return _filter.enabled(); }
+
+  /**
+   * @brief Samples of all matched objects passed to decimation
+   *
+   */
+  auto samples_seen() const noexcept -> std::uint64_t;
+
+  /**
+   * @brief Samples of all matched objects dropped by decimation
+   *
+   */
+  auto samples_dropped() const noexcept -> std::uint64_t;
+
+ private:
+  void initialize();
+
+  /**
+   * @brief Whether samples go through own writer instead of ns3::FileHelper
+   *
+   */
+  bool streamed() const noexcept;
+
+  /**
+   * @brief Write samples in CSV by ns3::FileHelper
+   *
+   */
+  void initialize_file_helper();
+
+  /**
+   * @brief Connect probe directly to own statistics writer
+   *
+   */
+  void initialize_stream();
+
+  /**
+   * @brief Connect own probe to each object matching wildcard source
+   *
+   * Matches are resolved once, samples of all matches are written to one
+   * output with object index column. Each match is decimated separately.
+   */
+  void initialize_matches();
+
+  auto make_writer(bool object_column) -> std::unique_ptr<stats::Writer>;
+
+  void connect(const ns3::Ptr<ns3::Probe> &probe,
+               std::optional<std::uint32_t> object);
+
+  template <typename T>
+  bool connect_sink(const ns3::Ptr<ns3::Probe> &probe,
+                    std::optional<std::uint32_t> object);
+
+  template <typename T>
+  void on_value(T old_value, T new_value);
+
+  template <typename T>
+  static void on_object_value(Registrator *self, std::uint32_t object,
+                              T old_value, T new_value);
 
   std::string _probe_type;
   std::string _file_name;
   std::string _trace;
+  bool _wildcard;
   std::string _sink;
   std::string _value_name;
+  stats::output_format _format;
+  stats::OutputContext _output;
+  std::optional<ns3::Time> _window;
+  std::vector<stats::Statistic> _statistics;
+  std::uint32_t _decimate;
+  std::optional<ns3::Time> _min_interval;
+  stats::SampleFilter _filter;
+  // Filters of wildcard matches by object index
+  std::vector<stats::SampleFilter> _object_filters;
 
   ns3::Time _init_time;
   ns3::Time _end_time;
 
   ns3::FileHelper _file_helper;
   ns3::EventId _init_event;
+
+  std::vector<ns3::Ptr<ns3::Probe>> _probes;
+  std::unique_ptr<stats::Writer> _writer;
+  std::vector<double> _row;
 };
 
 }  // namespace model
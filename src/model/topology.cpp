@@ -0,0 +1,350 @@
+#include "topology.h"
+
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <ns3/attribute.h>
+#include <ns3/data-rate.h>
+#include <ns3/nstime.h>
+#include <ns3/type-id.h>
+
+#include <fmt/core.h>
+
+#include "model/device.h"
+#include "model/ideal_channel.h"
+#include "model/model_build_error.h"
+#include "parser/parser.h"
+
+namespace model {
+
+namespace {
+constexpr auto rate_attribute = "DataRate";
+constexpr auto delay_attribute = "Delay";
+
+auto type_name(device_type type) -> std::string {
+  switch (type) {
+    case device_type::CSMA:
+      return "ns3::CsmaNetDevice";
+    case device_type::PPP:
+      return "ns3::PointToPointNetDevice";
+    case device_type::Ideal:
+      return "ns3::SimpleNetDevice";
+    default:
+      return {};
+  }
+}
+
+auto type_name(channel_type type) -> std::string {
+  switch (type) {
+    case channel_type::CSMA:
+      return "ns3::CsmaChannel";
+    case channel_type::PPP:
+      return "ns3::PointToPointChannel";
+    case channel_type::Ideal:
+      return IdealChannel::GetTypeId().GetName();
+    default:
+      return {};
+  }
+}
+
+/**
+ * @brief Parses rate and delay attributes, caching repeated values
+ *
+ * Generated topologies use a few distinct values, so each of them is parsed
+ * by ns-3 once.
+ */
+class LinkAttributes {
+ public:
+  /**
+   * @brief Rate of attributes or default rate of type
+   *
+   * @return std::optional<std::uint64_t> empty if type has no rate
+   */
+  auto rate(const parser::Attributes &attributes, const std::string &type)
+      -> std::optional<std::uint64_t> {
+    return value<ns3::DataRateValue>(attributes, type, rate_attribute,
+                                     _rates, _default_rates);
+  }
+
+  auto delay(const parser::Attributes &attributes, const std::string &type)
+      -> std::int64_t {
+    return value<ns3::TimeValue>(attributes, type, delay_attribute, _delays,
+                                 _default_delays)
+        .value_or(0);
+  }
+
+ private:
+  // Initial values per type, empty if type has no such attribute
+  template <typename T>
+  using Defaults = std::unordered_map<std::string, std::optional<T>>;
+
+  template <typename Value, typename T>
+  static auto convert(const Value &value) -> T {
+    if constexpr (std::is_same_v<Value, ns3::DataRateValue>) {
+      return value.Get().GetBitRate();
+    } else {
+      return value.Get().GetNanoSeconds();
+    }
+  }
+
+  template <typename Value>
+  static auto checker() -> ns3::Ptr<const ns3::AttributeChecker> {
+    if constexpr (std::is_same_v<Value, ns3::DataRateValue>) {
+      return ns3::MakeDataRateChecker();
+    } else {
+      return ns3::MakeTimeChecker();
+    }
+  }
+
+  template <typename Value, typename T>
+  auto value(const parser::Attributes &attributes, const std::string &type,
+             const char *name, std::unordered_map<std::string, T> &cache,
+             Defaults<T> &defaults) -> std::optional<T> {
+    auto attribute = attributes.find(name);
+    if (attribute == attributes.end()) {
+      auto it = defaults.find(type);
+      if (it == defaults.end()) {
+        it = defaults.emplace(type, default_value<Value, T>(type, name)).first;
+      }
+      return it->second;
+    }
+
+    const auto &str = attribute->second;
+    if (auto it = cache.find(str); it != cache.end()) {
+      return it->second;
+    }
+
+    Value value;
+    if (!value.DeserializeFromString(str, checker<Value>())) {
+      throw ModelBuildError(
+          fmt::format(R"(Bad value "{}" of attribute "{}")", str, name));
+    }
+    auto result = convert<Value, T>(value);
+    cache.emplace(str, result);
+    return result;
+  }
+
+  template <typename Value, typename T>
+  static auto default_value(const std::string &type, const char *name)
+      -> std::optional<T> {
+    ns3::TypeId::AttributeInformation info;
+    if (!ns3::TypeId::LookupByName(type).LookupAttributeByName(name, &info)) {
+      return {};
+    }
+
+    const auto *value = dynamic_cast<const Value *>(
+        ns3::PeekPointer(info.initialValue));
+    if (value == nullptr) {
+      return {};
+    }
+
+    return convert<Value, T>(*value);
+  }
+
+  std::unordered_map<std::string, std::uint64_t> _rates;
+  std::unordered_map<std::string, std::int64_t> _delays;
+  Defaults<std::uint64_t> _default_rates;
+  Defaults<std::int64_t> _default_delays;
+};
+}  // namespace
+
+auto Topology::find_device(const std::vector<parser::NodeDescription> &nodes,
+                           const Topology &topology,
+                           const std::string &interface) -> id {
+  auto separator = interface.find('/');
+  if (separator == std::string::npos) {
+    return invalid;
+  }
+
+  auto node = topology.find_node(interface.substr(0, separator));
+  if (!node.has_value()) {
+    return invalid;
+  }
+
+  // Nodes have a few devices, scan is cheaper than map of all interfaces
+  std::string_view name{interface};
+  name.remove_prefix(separator + 1);
+  const auto &devices = nodes[*node].devices;
+  for (std::size_t i = 0; i < devices.size(); ++i) {
+    if (devices[i].name == name) {
+      return topology._device_offsets[*node] + static_cast<id>(i);
+    }
+  }
+  return invalid;
+}
+
+auto Topology::build(const parser::ModelDescription &description)
+    -> Topology {
+  Topology topology;
+  LinkAttributes attributes;
+
+  const auto &nodes = description.nodes;
+  const auto &connections = description.connections;
+
+  std::size_t devices = 0;
+  for (const auto &node : nodes) {
+    devices += node.devices.size();
+  }
+
+  topology._node_names.reserve(nodes.size());
+  topology._node_per_name.reserve(nodes.size());
+  topology._device_offsets.reserve(nodes.size() + 1);
+  topology._device_node.reserve(devices);
+  topology._device_channel.assign(devices, invalid);
+  topology._device_rate.reserve(devices);
+
+  // Device rate is empty for devices sharing rate of channel
+  std::vector<std::optional<std::uint64_t>> own_rate;
+  own_rate.reserve(devices);
+
+  topology._device_offsets.push_back(0);
+  for (const auto &node : nodes) {
+    auto node_id = static_cast<id>(topology._node_names.size());
+    topology._node_names.push_back(node.name);
+    topology._node_per_name.emplace(node.name, node_id);
+
+    for (const auto &device : node.devices) {
+      topology._device_node.push_back(node_id);
+
+      auto type = device_type_from_string(device.type);
+      auto rate = type.has_value()
+                      ? attributes.rate(device.attributes, type_name(*type))
+                      : std::nullopt;
+      own_rate.push_back(rate);
+      topology._device_rate.push_back(rate.value_or(0));
+    }
+    topology._device_offsets.push_back(
+        static_cast<id>(topology._device_node.size()));
+  }
+
+  // Channel rate of devices without own rate, and edges count of each vertex
+  std::vector<std::size_t> edges_per_vertex(
+      nodes.size() + connections.size() + 1, 0);
+  topology._channel_offsets.reserve(connections.size() + 1);
+  topology._channel_offsets.push_back(0);
+  for (const auto &connection : connections) {
+    auto channel_id = static_cast<id>(topology._channel_names.size());
+    auto type = type_name(connection.type);
+    topology._channel_names.push_back(connection.name);
+    topology._channel_types.push_back(connection.type);
+    topology._channel_delay.push_back(
+        attributes.delay(connection.attributes, type));
+    auto channel_rate = attributes.rate(connection.attributes, type);
+
+    for (const auto &interface : connection.interfaces) {
+      auto device = find_device(nodes, topology, interface);
+      if (device == invalid) {
+        throw ModelBuildError(
+            fmt::format(R"(Unknown interface "{}" of connection "{}")",
+                        interface, connection.name));
+      }
+
+      topology._device_channel[device] = channel_id;
+      topology._channel_devices.push_back(device);
+      if (!own_rate[device].has_value()) {
+        topology._device_rate[device] = channel_rate.value_or(0);
+      }
+      ++edges_per_vertex[topology._device_node[device] + 1];
+      ++edges_per_vertex[nodes.size() + channel_id + 1];
+    }
+    topology._channel_offsets.push_back(
+        static_cast<id>(topology._channel_devices.size()));
+  }
+
+  // Edge offsets are prefix sums of counts, then edges are placed by cursor
+  for (std::size_t i = 1; i < edges_per_vertex.size(); ++i) {
+    edges_per_vertex[i] += edges_per_vertex[i - 1];
+  }
+  topology._edge_offsets = edges_per_vertex;
+  topology._edges.resize(edges_per_vertex.back());
+
+  auto &cursor = edges_per_vertex;
+  for (id channel = 0; channel < topology._channel_names.size(); ++channel) {
+    auto vertex = topology.channel_vertex(channel);
+    auto delay = topology._channel_delay[channel];
+    for (auto device : topology.channel_devices(channel)) {
+      auto node = topology._device_node[device];
+      auto rate = topology._device_rate[device];
+      topology._edges[cursor[node]++] = Edge{.vertex = vertex,
+                                             .device = device,
+                                             .delay_ns = delay,
+                                             .rate_bps = rate};
+      topology._edges[cursor[vertex]++] = Edge{.vertex = node,
+                                               .device = device,
+                                               .delay_ns = delay,
+                                               .rate_bps = rate};
+    }
+  }
+
+  return topology;
+}
+
+auto Topology::find_node(const std::string &name) const -> std::optional<id> {
+  if (auto it = _node_per_name.find(name); it != _node_per_name.end()) {
+    return it->second;
+  }
+  return {};
+}
+
+auto Topology::bfs(id source) const -> std::vector<id> {
+  std::vector<id> distance(vertices_count(), invalid);
+  std::vector<id> queue;
+  queue.reserve(vertices_count());
+
+  distance[source] = 0;
+  queue.push_back(source);
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    auto vertex = queue[head];
+    for (const auto &edge : neighbors(vertex)) {
+      if (distance[edge.vertex] == invalid) {
+        distance[edge.vertex] = distance[vertex] + 1;
+        queue.push_back(edge.vertex);
+      }
+    }
+  }
+
+  // Every hop between nodes passes a channel vertex
+  distance.resize(nodes_count());
+  for (auto &hops : distance) {
+    if (hops != invalid) {
+      hops /= 2;
+    }
+  }
+  return distance;
+}
+
+auto Topology::components(std::size_t *count) const -> std::vector<id> {
+  std::vector<id> component(vertices_count(), invalid);
+  std::vector<id> stack;
+  id next = 0;
+
+  for (id root = 0; root < nodes_count(); ++root) {
+    if (component[root] != invalid) {
+      continue;
+    }
+
+    component[root] = next;
+    stack.push_back(root);
+    while (!stack.empty()) {
+      auto vertex = stack.back();
+      stack.pop_back();
+      for (const auto &edge : neighbors(vertex)) {
+        if (component[edge.vertex] == invalid) {
+          component[edge.vertex] = next;
+          stack.push_back(edge.vertex);
+        }
+      }
+    }
+    ++next;
+  }
+
+  if (count != nullptr) {
+    *count = next;
+  }
+  component.resize(nodes_count());
+  return component;
+}
+
+}  // namespace model
@@ -0,0 +1,185 @@
+#ifndef __TOPOLOGY_H_R2KD7VX9PE4G__
+#define __TOPOLOGY_H_R2KD7VX9PE4G__
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "model/channel.h"
+
+namespace parser {
+struct ModelDescription;
+struct NodeDescription;
+}  // namespace parser
+
+namespace model {
+
+/**
+ * @brief Compressed sparse row graph of nodes, devices and channels
+ *
+ * Identifiers are indices in order of description, so node identifiers are
+ * the indices of ns3::NodeList for models built from one description.
+ * Devices are numbered node by node, devices of a node form a contiguous
+ * range. Channels are vertices too, following the nodes: every connected
+ * device gives an edge from its node to the channel and back, so a shared
+ * segment of k devices costs 2 * k edges instead of k * (k - 1).
+ */
+class Topology {
+ public:
+  using id = std::uint32_t;
+
+  static constexpr auto invalid = std::numeric_limits<id>::max();
+
+  /**
+   * @brief Directed edge between node and channel vertices
+   *
+   */
+  struct Edge {
+    // Channel vertex for edges of nodes, node vertex for edges of channels
+    id vertex;
+    // Device attaching the node to the channel
+    id device;
+    // Delay of the channel
+    std::int64_t delay_ns;
+    // Transmission rate of the device, 0 means unlimited rate
+    std::uint64_t rate_bps;
+  };
+
+  template <typename T>
+  struct Range {
+    const T *first;
+    const T *last;
+
+    auto begin() const -> const T * { return first; }
+    auto end() const -> const T * { return last; }
+    auto size() const -> std::size_t { return last - first; }
+  };
+
+  /**
+   * @brief Build graph in one pass over nodes and connections
+   *
+   * Rate and delay are taken from attributes of devices and connections,
+   * defaults of ns-3 types are used for absent attributes.
+   *
+   * @param description
+   * @return Topology
+   * @throws ModelBuildError on unknown interface in connection or bad value
+   * of rate or delay
+   */
+  static auto build(const parser::ModelDescription &description) -> Topology;
+
+  auto nodes_count() const -> std::size_t { return _node_names.size(); }
+
+  auto devices_count() const -> std::size_t { return _device_node.size(); }
+
+  auto channels_count() const -> std::size_t { return _channel_names.size(); }
+
+  auto vertices_count() const -> std::size_t {
+    return nodes_count() + channels_count();
+  }
+
+  auto edges_count() const -> std::size_t { return _edges.size(); }
+
+  auto channel_vertex(id channel) const -> id {
+    return static_cast<id>(nodes_count()) + channel;
+  }
+
+  auto is_channel(id vertex) const -> bool { return vertex >= nodes_count(); }
+
+  auto node_name(id node) const -> const std::string & {
+    return _node_names[node];
+  }
+
+  auto channel_name(id channel) const -> const std::string & {
+    return _channel_names[channel];
+  }
+
+  auto channel_type(id channel) const -> model::channel_type {
+    return _channel_types[channel];
+  }
+
+  auto find_node(const std::string &name) const -> std::optional<id>;
+
+  /**
+   * @brief Devices of node as range of identifiers
+   *
+   */
+  auto devices(id node) const -> std::pair<id, id> {
+    return {_device_offsets[node], _device_offsets[node + 1]};
+  }
+
+  auto device_node(id device) const -> id { return _device_node[device]; }
+
+  /**
+   * @brief Channel of device, invalid if device is not connected
+   *
+   */
+  auto device_channel(id device) const -> id { return _device_channel[device]; }
+
+  auto channel_devices(id channel) const -> Range<id> {
+    return {_channel_devices.data() + _channel_offsets[channel],
+            _channel_devices.data() + _channel_offsets[channel + 1]};
+  }
+
+  /**
+   * @brief Channels of node vertex or nodes of channel vertex
+   *
+   */
+  auto neighbors(id vertex) const -> Range<Edge> {
+    return {_edges.data() + _edge_offsets[vertex],
+            _edges.data() + _edge_offsets[vertex + 1]};
+  }
+
+  /**
+   * @brief Node to node hop distances from source node, invalid for
+   * unreachable nodes
+   *
+   */
+  auto bfs(id source) const -> std::vector<id>;
+
+  /**
+   * @brief Component index of every node, components are numbered from 0
+   *
+   * Channels without devices are not counted.
+   *
+   * @param count number of components
+   */
+  auto components(std::size_t *count = nullptr) const -> std::vector<id>;
+
+ private:
+  /**
+   * @brief Device of interface in "{node}/{device}" format, invalid if absent
+   *
+   */
+  static auto find_device(const std::vector<parser::NodeDescription> &nodes,
+                          const Topology &topology,
+                          const std::string &interface) -> id;
+
+  std::vector<std::string> _node_names;
+  std::unordered_map<std::string, id> _node_per_name;
+
+  // Devices of node i are [_device_offsets[i], _device_offsets[i + 1])
+  std::vector<id> _device_offsets;
+  std::vector<id> _device_node;
+  std::vector<id> _device_channel;
+  std::vector<std::uint64_t> _device_rate;
+
+  std::vector<std::string> _channel_names;
+  std::vector<model::channel_type> _channel_types;
+  std::vector<std::int64_t> _channel_delay;
+  std::vector<id> _channel_offsets;
+  std::vector<id> _channel_devices;
+
+  // Edges of vertex v are [_edge_offsets[v], _edge_offsets[v + 1])
+  std::vector<std::size_t> _edge_offsets;
+  std::vector<Edge> _edges;
+};
+
+}  // namespace model
+
+#endif  // __TOPOLOGY_H_R2KD7VX9PE4G__
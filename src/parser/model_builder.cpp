@@ -0,0 +1,208 @@
+#include "model_builder.h"
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <fmt/core.h>
+
+#include "utils/address.h"
+
+namespace parser {
+
+auto NodeBuilder::node() const -> NodeDescription & {
+  return _model._description.nodes[_index];
+}
+
+auto NodeBuilder::last_device() const -> DeviceDescription & {
+  auto &devices = node().devices;
+  if (devices.empty()) {
+    throw ParseError(fmt::format(R"(Node "{}" has no devices)", node().name));
+  }
+  return devices.back();
+}
+
+auto NodeBuilder::device(std::string name, std::string type,
+                         Attributes attributes) -> NodeBuilder & {
+  auto &devices = node().devices;
+  auto same_name = [&name](const auto &device) { return device.name == name; };
+  if (std::any_of(devices.begin(), devices.end(), same_name)) {
+    throw ParseError(fmt::format(R"(Node "{}" already has device "{}")",
+                                 node().name, name));
+  }
+
+  devices.push_back({.name = std::move(name),
+                     .type = std::move(type),
+                     .attributes = std::move(attributes)});
+  return *this;
+}
+
+auto NodeBuilder::address(std::string_view address, std::string_view netmask)
+    -> NodeBuilder & {
+  auto &device = last_device();
+  auto network = address::from_string_v4(address, netmask);
+  if (!network.has_value()) {
+    throw ParseError(fmt::format(R"(Bad IPv4 address "{}/{}" of "{}/{}")",
+                                 address, netmask, node().name, device.name));
+  }
+  device.ipv4_addresses.push_back(*network);
+  return *this;
+}
+
+auto NodeBuilder::address(std::string_view address, std::uint8_t prefix)
+    -> NodeBuilder & {
+  constexpr std::uint8_t max_prefix = 128;
+
+  auto &device = last_device();
+  auto network = prefix <= max_prefix
+                     ? address::from_string_v6(address, prefix)
+                     : std::nullopt;
+  if (!network.has_value()) {
+    throw ParseError(fmt::format(R"(Bad IPv6 address "{}/{}" of "{}/{}")",
+                                 address, prefix, node().name, device.name));
+  }
+  device.ipv6_addresses.push_back(*network);
+  return *this;
+}
+
+auto NodeBuilder::capture(CaptureDescription capture) -> NodeBuilder & {
+  last_device().capture = std::move(capture);
+  return *this;
+}
+
+auto NodeBuilder::application(std::string name, std::string type,
+                              Attributes attributes) -> NodeBuilder & {
+  node().applications.push_back({.name = std::move(name),
+                                 .type = std::move(type),
+                                 .attributes = std::move(attributes)});
+  return *this;
+}
+
+auto NodeBuilder::route(Ipv4Route route) -> NodeBuilder & {
+  node().routing.ipv4.push_back(std::move(route));
+  return *this;
+}
+
+auto NodeBuilder::route(Ipv6Route route) -> NodeBuilder & {
+  node().routing.ipv6.push_back(std::move(route));
+  return *this;
+}
+
+ModelBuilder::ModelBuilder(std::string model_name) {
+  _description.model_name = std::move(model_name);
+}
+
+auto ModelBuilder::duration(std::string end_time) -> ModelBuilder & {
+  _description.end_time = std::move(end_time);
+  return *this;
+}
+
+auto ModelBuilder::precision(ns3::Time::Unit unit) -> ModelBuilder & {
+  _description.time_precision = unit;
+  return *this;
+}
+
+auto ModelBuilder::populate_routing_tables(bool populate) -> ModelBuilder & {
+  _description.polulate_tables = populate;
+  return *this;
+}
+
+auto ModelBuilder::populate_neighbor_cache(bool populate) -> ModelBuilder & {
+  _description.populate_neighbor_cache = populate;
+  return *this;
+}
+
+auto ModelBuilder::node(std::string name) -> NodeBuilder {
+  auto index = _description.nodes.size();
+  if (!_node_per_name.emplace(name, index).second) {
+    throw ParseError(fmt::format(R"(Node "{}" already exists)", name));
+  }
+
+  _description.nodes.push_back({.name = std::move(name)});
+  return NodeBuilder{*this, index};
+}
+
+auto ModelBuilder::connect(std::string name, model::channel_type type,
+                           std::vector<std::string> interfaces,
+                           Attributes attributes) -> ModelBuilder & {
+  if (_connection_names.count(name) != 0) {
+    throw ParseError(fmt::format(R"(Connection "{}" already exists)", name));
+  }
+
+  for (const auto &interface : interfaces) {
+    auto separator = interface.find('/');
+    auto node = _node_per_name.find(interface.substr(0, separator));
+    if (separator == std::string::npos || node == _node_per_name.end()) {
+      throw ParseError(fmt::format(
+          R"(Unknown interface "{}" in connection "{}")", interface, name));
+    }
+
+    const auto &devices = _description.nodes[node->second].devices;
+    auto device = interface.substr(separator + 1);
+    auto same_name = [&device](const auto &desc) {
+      return desc.name == device;
+    };
+    if (std::none_of(devices.begin(), devices.end(), same_name)) {
+      throw ParseError(fmt::format(
+          R"(Unknown interface "{}" in connection "{}")", interface, name));
+    }
+
+    if (_connected.count(interface) != 0) {
+      throw ParseError(fmt::format(
+          R"(Interface "{}" of connection "{}" is already connected)",
+          interface, name));
+    }
+  }
+
+  _connection_names.insert(name);
+  _connected.insert(interfaces.begin(), interfaces.end());
+  _description.connections.push_back({.name = std::move(name),
+                                      .type = type,
+                                      .interfaces = std::move(interfaces),
+                                      .attributes = std::move(attributes)});
+  return *this;
+}
+
+auto ModelBuilder::registrator(RegistratorDescription registrator)
+    -> ModelBuilder & {
+  _description.registrators.push_back(std::move(registrator));
+  return *this;
+}
+
+auto ModelBuilder::poller(PollerDescription poller) -> ModelBuilder & {
+  _description.pollers.push_back(std::move(poller));
+  return *this;
+}
+
+auto ModelBuilder::statistics(StatisticsDescription statistics)
+    -> ModelBuilder & {
+  _description.statistics = std::move(statistics);
+  return *this;
+}
+
+auto ModelBuilder::background_flow(BackgroundFlowDescription flow)
+    -> ModelBuilder & {
+  if (_node_per_name.count(flow.source) == 0) {
+    throw ParseError(fmt::format(R"(Unknown source node "{}" of flow "{}")",
+                                 flow.source, flow.name));
+  }
+
+  _description.background.flows.push_back(std::move(flow));
+  return *this;
+}
+
+auto ModelBuilder::background_mode(model::background_mode mode)
+    -> ModelBuilder & {
+  _description.background.mode = mode;
+  return *this;
+}
+
+auto ModelBuilder::build() -> ModelDescription {
+  _node_per_name.clear();
+  _connection_names.clear();
+  _connected.clear();
+  return std::exchange(_description, {});
+}
+
+}  // namespace parser
@@ -0,0 +1,179 @@
+#ifndef __MODEL_BUILDER_H_Q7WN3ZK8TB1F__
+#define __MODEL_BUILDER_H_Q7WN3ZK8TB1F__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <ns3/nstime.h>
+
+#include "model/channel.h"
+#include "parser/parser.h"
+
+namespace parser {
+
+class ModelBuilder;
+
+/**
+ * @brief Adds devices, applications and routes to one node of ModelBuilder
+ *
+ * Addresses and capture are added to the last added device. Builder of node
+ * stays valid while its ModelBuilder is alive.
+ */
+class NodeBuilder {
+ public:
+  /**
+   * @brief Add device to node
+   *
+   * @param name unique name of device on node
+   * @param type device type: "Csma", "PPP" or "Ideal"
+   * @param attributes attributes of ns-3 device
+   * @throws ParseError if node already has device with the same name
+   */
+  auto device(std::string name, std::string type, Attributes attributes = {})
+      -> NodeBuilder &;
+
+  /**
+   * @brief Add IPv4 address to last device
+   *
+   * @throws ParseError if node has no devices or address is invalid
+   */
+  auto address(std::string_view address, std::string_view netmask)
+      -> NodeBuilder &;
+
+  /**
+   * @brief Add IPv6 address to last device
+   *
+   * @throws ParseError if node has no devices or address is invalid
+   */
+  auto address(std::string_view address, std::uint8_t prefix)
+      -> NodeBuilder &;
+
+  /**
+   * @brief Capture packets of last device
+   *
+   * @throws ParseError if node has no devices
+   */
+  auto capture(CaptureDescription capture) -> NodeBuilder &;
+
+  auto application(std::string name, std::string type,
+                   Attributes attributes = {}) -> NodeBuilder &;
+
+  auto route(Ipv4Route route) -> NodeBuilder &;
+
+  auto route(Ipv6Route route) -> NodeBuilder &;
+
+  /**
+   * @brief Builder of the model, to continue with next node or connections
+   *
+   */
+  auto end() const -> ModelBuilder & { return _model; }
+
+ private:
+  friend class ModelBuilder;
+
+  NodeBuilder(ModelBuilder &model, std::size_t index)
+      : _model(model), _index(index) {}
+
+  auto node() const -> NodeDescription &;
+
+  auto last_device() const -> DeviceDescription &;
+
+  ModelBuilder &_model;
+  // Index of node, descriptions of nodes are moved when new nodes are added
+  std::size_t _index;
+};
+
+/**
+ * @brief Builds ModelDescription in memory, without XML
+ *
+ * Checks the same references as XmlParser and Model do on build: names of
+ * nodes, devices and connections are unique and connections join existing
+ * unconnected devices, so errors are reported at the place they are made.
+ *
+ * @code
+ * parser::ModelBuilder builder{"udp_echo"};
+ * builder.duration("10s").populate_routing_tables();
+ * builder.node("client")
+ *     .device("eth0", "Csma")
+ *     .address("10.0.0.1", "255.255.255.0")
+ *     .application("client", "ns3::UdpEchoClient", {{"RemotePort", "9"}});
+ * builder.connect("lan", model::channel_type::CSMA, {"client/eth0", ...});
+ *
+ * model::Model model;
+ * model.build_from_description(builder.build());
+ * @endcode
+ */
+class ModelBuilder {
+ public:
+  explicit ModelBuilder(std::string model_name);
+
+  /**
+   * @brief Simulation end time in ns-3 format: "10s", "500ms"
+   *
+   */
+  auto duration(std::string end_time) -> ModelBuilder &;
+
+  auto precision(ns3::Time::Unit unit) -> ModelBuilder &;
+
+  auto populate_routing_tables(bool populate = true) -> ModelBuilder &;
+
+  auto populate_neighbor_cache(bool populate = true) -> ModelBuilder &;
+
+  /**
+   * @brief Add node
+   *
+   * @throws ParseError if node with the same name exists
+   */
+  auto node(std::string name) -> NodeBuilder;
+
+  /**
+   * @brief Connect devices with channel
+   *
+   * @param interfaces devices in "{node}/{device}" format
+   * @throws ParseError if connection name is not unique, interface is
+   * unknown or already connected
+   */
+  auto connect(std::string name, model::channel_type type,
+               std::vector<std::string> interfaces,
+               Attributes attributes = {}) -> ModelBuilder &;
+
+  auto registrator(RegistratorDescription registrator) -> ModelBuilder &;
+
+  auto poller(PollerDescription poller) -> ModelBuilder &;
+
+  auto statistics(StatisticsDescription statistics) -> ModelBuilder &;
+
+  /**
+   * @brief Add flow of background load
+   *
+   * @throws ParseError if source node is unknown
+   */
+  auto background_flow(BackgroundFlowDescription flow) -> ModelBuilder &;
+
+  auto background_mode(model::background_mode mode) -> ModelBuilder &;
+
+  auto description() const -> const ModelDescription & { return _description; }
+
+  /**
+   * @brief Take built description, builder is left empty
+   *
+   */
+  auto build() -> ModelDescription;
+
+ private:
+  friend class NodeBuilder;
+
+  ModelDescription _description;
+  std::unordered_map<std::string, std::size_t> _node_per_name;
+  std::unordered_set<std::string> _connection_names;
+  std::unordered_set<std::string> _connected;
+};
+
+}  // namespace parser
+
+#endif  // __MODEL_BUILDER_H_Q7WN3ZK8TB1F__
@@ -1,15 +1,25 @@
 #include "parser.h"
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
 
 #include <ns3/nstime.h>
 
 #include <tinyxml2.h>
 
+#include <fmt/core.h>
+
 #include "parser/parse_util.h"
+#include "profiling/build_profiler.h"
 #include "utils/address.h"
 
 using namespace std::literals;
@@ -18,10 +28,12 @@ namespace parser {
 
 constexpr auto model_tag = "model";
 constexpr auto populate_tag = "populate-routing-tables";
+constexpr auto neighbor_cache_tag = "populate-neighbor-cache";
 constexpr auto node_tag = "node";
 constexpr auto device_list_tag = "device-list";
 constexpr auto device_tag = "device";
 constexpr auto address_tag = "address";
+constexpr auto capture_tag = "capture";
 constexpr auto attributes_tag = "attributes";
 constexpr auto attribute_tag = "attribute";
 constexpr auto applications_tag = "applications";
@@ -34,8 +46,12 @@ constexpr auto interfaces_tag = "interfaces";
 constexpr auto interface_tag = "interface";
 constexpr auto statistics_tag = "statistics";
 constexpr auto registrator_tag = "registrator";
+constexpr auto poller_tag = "poller";
+constexpr auto polled_value_tag = "value";
 constexpr auto duration_tag = "duration";
 constexpr auto precision_tag = "precision";
+constexpr auto background_tag = "background";
+constexpr auto flow_tag = "flow";
 
 constexpr auto name_attr = "name";
 constexpr auto type_attr = "type";
@@ -53,17 +69,85 @@ constexpr auto start_attr = "start";
 constexpr auto end_attr = "end";
 constexpr auto value_name_attr = "value_name";
 constexpr auto sink_attr = "sink";
+constexpr auto format_attr = "format";
+constexpr auto window_attr = "window";
+constexpr auto stats_attr = "stats";
+constexpr auto decimate_attr = "decimate";
+constexpr auto min_interval_attr = "min-interval";
+constexpr auto period_attr = "period";
+constexpr auto object_attr = "object";
+constexpr auto attribute_attr = "attribute";
+constexpr auto getter_attr = "getter";
+constexpr auto async_attr = "async";
+constexpr auto queue_size_attr = "queue-size";
+constexpr auto overflow_attr = "overflow";
+constexpr auto container_attr = "container";
+constexpr auto compress_attr = "compress";
+constexpr auto live_attr = "live";
+constexpr auto live_capacity_attr = "live-capacity";
+constexpr auto protocol_attr = "protocol";
+constexpr auto port_attr = "port";
+constexpr auto sample_attr = "sample";
+constexpr auto snaplen_attr = "snaplen";
+constexpr auto mode_attr = "mode";
+constexpr auto destination_attr = "destination";
+constexpr auto rate_attr = "rate";
+constexpr auto packet_size_attr = "packet-size";
 
 using util::get_attribute;
 using util::xml_element_range;
 
+namespace {
+constexpr auto default_statistics = "count,mean,min,max";
+
+auto parse_statistic_list(const std::string &list,
+                          const tinyxml2::XMLElement *element)
+    -> std::vector<stats::Statistic> {
+  std::vector<std::string> names;
+  boost::algorithm::split(names, list, boost::algorithm::is_any_of(","));
+
+  std::vector<stats::Statistic> statistics;
+  for (auto &name : names) {
+    boost::algorithm::trim(name);
+
+    auto statistic = stats::statistic_from_string(name);
+    if (!statistic.has_value()) {
+      throw AttributeError(fmt::format(R"(Unknown statistic "{}")", name),
+                           stats_attr, element);
+    }
+    statistics.push_back(std::move(*statistic));
+  }
+
+  return statistics;
+}
+
+auto parse_compression(const tinyxml2::XMLElement *element)
+    -> std::optional<stats::compression> {
+  auto compress_str = get_attribute<std::string>(element, compress_attr, false);
+  if (compress_str.empty()) {
+    return {};
+  }
+
+  auto compress = stats::compression_from_string(compress_str);
+  if (!compress.has_value()) {
+    throw AttributeError("Unknown compression", compress_attr, element);
+  }
+  return compress;
+}
+}  // namespace
+
 ModelDescription XmlParser::parse(const std::string &xml) {
+  profiling::ScopedPhase phase{"parse"};
+
   ModelDescription description;
 
   tinyxml2::XMLDocument doc;
 
-  if (doc.Parse(xml.c_str()) != tinyxml2::XML_SUCCESS) {
-    throw ParseError(doc.ErrorStr());
+  {
+    profiling::ScopedPhase xml_phase{"parse/xml"};
+    if (doc.Parse(xml.c_str()) != tinyxml2::XML_SUCCESS) {
+      throw ParseError(doc.ErrorStr());
+    }
   }
 
   const auto *root = doc.RootElement();
@@ -76,6 +160,9 @@ ModelDescription XmlParser::parse(const std::string &xml) {
   description.nodes = parse_nodes(root);
   description.connections = parse_connections(root);
   description.registrators = parse_statistics(root);
+  description.pollers = parse_pollers(root);
+  description.statistics = parse_statistics_settings(root);
+  description.background = parse_background(root);
 
   return description;
 }
@@ -89,6 +176,11 @@ void XmlParser::parse_model_settings(const tinyxml2::XMLElement *root,
     populate->QueryBoolText(&description.polulate_tables);
   }
 
+  const auto *neighbor_cache = root->FirstChildElement(neighbor_cache_tag);
+  if (neighbor_cache != nullptr) {
+    neighbor_cache->QueryBoolText(&description.populate_neighbor_cache);
+  }
+
   const auto *duration = root->FirstChildElement(duration_tag);
   if (duration != nullptr) {
     description.end_time = duration->GetText();
@@ -109,6 +201,8 @@ void XmlParser::parse_model_settings(const tinyxml2::XMLElement *root,
 
 auto XmlParser::parse_nodes(const tinyxml2::XMLElement *root)
     -> std::vector<NodeDescription> {
+  profiling::ScopedPhase phase{"parse/nodes"};
+
   std::vector<NodeDescription> nodes;
   for (const auto &node : xml_element_range(root, node_tag)) {
     // NOTE: doesn't validate uint64 value
@@ -140,18 +234,63 @@ auto XmlParser::parse_devices(const tinyxml2::XMLElement *node)
       auto type = device.get_attribute<std::string>(type_attr);
       auto [ipv4, ipv6] = parse_addresses(device.element);
       auto attributes = parse_attributes(device.element);
+      auto capture = parse_capture(device.element);
 
       devices.push_back(DeviceDescription{.name = std::move(name),
                                           .type = std::move(type),
                                           .ipv4_addresses = std::move(ipv4),
                                           .ipv6_addresses = std::move(ipv6),
-                                          .attributes = std::move(attributes)});
+                                          .attributes = std::move(attributes),
+                                          .capture = std::move(capture)});
     }
   }
 
   return devices;
 }
 
+auto XmlParser::parse_capture(const tinyxml2::XMLElement *device)
+    -> std::optional<CaptureDescription> {
+  const auto *capture = device->FirstChildElement(capture_tag);
+  if (capture == nullptr) {
+    return {};
+  }
+
+  CaptureDescription description;
+  description.file = get_attribute<std::string>(capture, file_attr);
+
+  auto protocol_str =
+      get_attribute<std::string>(capture, protocol_attr, false, "any");
+  auto protocol = stats::capture_protocol_from_string(protocol_str);
+  if (!protocol.has_value()) {
+    throw AttributeError("Unknown protocol", protocol_attr, capture);
+  }
+  description.protocol = *protocol;
+
+  constexpr std::uint32_t no_port = UINT32_MAX;
+  auto port = get_attribute<std::uint32_t>(capture, port_attr, false, no_port);
+  if (port != no_port) {
+    if (port > UINT16_MAX) {
+      throw AttributeError("Port must be less than 65536", port_attr, capture);
+    }
+    description.port = static_cast<std::uint16_t>(port);
+  }
+
+  description.sample =
+      get_attribute<std::uint32_t>(capture, sample_attr, false, 1);
+  if (description.sample == 0) {
+    throw AttributeError("Sampling must be positive", sample_attr, capture);
+  }
+
+  description.snap_length = get_attribute<std::uint32_t>(
+      capture, snaplen_attr, false, description.snap_length);
+  if (description.snap_length == 0) {
+    throw AttributeError("Snap length must be positive", snaplen_attr,
+                         capture);
+  }
+
+  return description;
+}
+
 auto XmlParser::parse_addresses(const tinyxml2::XMLElement *device)
     -> std::pair<std::vector<address::network_v4>,
                  std::vector<address::network_v6>> {
@@ -270,6 +409,8 @@ auto XmlParser::parse_routing(const tinyxml2::XMLElement *node)
 
 auto XmlParser::parse_connections(const tinyxml2::XMLElement *model)
     -> std::vector<ConnectionDescription> {
+  profiling::ScopedPhase phase{"parse/connections"};
+
   std::vector<ConnectionDescription> connections;
 
   const auto *tag = model->FirstChildElement(connections_tag);
@@ -316,6 +457,8 @@ auto XmlParser::parse_interfaces(const tinyxml2::XMLElement *connection)
 
 auto XmlParser::parse_statistics(const tinyxml2::XMLElement *root)
     -> std::vector<RegistratorDescription> {
+  profiling::ScopedPhase phase{"parse/statistics"};
+
   std::vector<RegistratorDescription> registrators;
 
   const auto *statistics = root->FirstChildElement(statistics_tag);
@@ -339,6 +482,43 @@ auto XmlParser::parse_statistics(const tinyxml2::XMLElement *root)
     auto sink =
         registrator.get_attribute<std::string>(sink_attr, false, "Output");
 
+    auto format_str =
+        registrator.get_attribute<std::string>(format_attr, false, "csv");
+    auto format = stats::output_format_from_string(format_str);
+    if (!format.has_value()) {
+      throw AttributeError("Unknown output format", format_attr,
+                           registrator.element);
+    }
+
+    auto window_str =
+        registrator.get_attribute<std::string>(window_attr, false);
+    auto stats_str = registrator.get_attribute<std::string>(stats_attr, false);
+
+    std::optional<std::string> window;
+    std::vector<stats::Statistic> statistics;
+    if (!window_str.empty()) {
+      window = window_str;
+      statistics = parse_statistic_list(
+          stats_str.empty() ? default_statistics : stats_str,
+          registrator.element);
+    } else if (!stats_str.empty()) {
+      throw AttributeError("Statistics require aggregation window",
+                           stats_attr, registrator.element);
+    }
+
+    auto decimate =
+        registrator.get_attribute<std::uint32_t>(decimate_attr, false, 1);
+    if (decimate == 0) {
+      throw AttributeError("Decimation must be positive", decimate_attr,
+                           registrator.element);
+    }
+
+    auto min_interval_str =
+        registrator.get_attribute<std::string>(min_interval_attr, false);
+    std::optional<std::string> min_interval =
+        min_interval_str.empty() ? std::nullopt
+                                 : std::optional{min_interval_str};
+
     registrators.push_back(
         RegistratorDescription{.source = std::move(source),
                                .type = std::move(type),
@@ -346,10 +526,182 @@ auto XmlParser::parse_statistics(const tinyxml2::XMLElement *root)
                                .value_name = std::move(value_name),
                                .file = std::move(file),
                                .start_time = std::move(start_time),
-                               .end_time = end_time});
+                               .end_time = end_time,
+                               .format = *format,
+                               .window = std::move(window),
+                               .statistics = std::move(statistics),
+                               .decimate = decimate,
+                               .min_interval = std::move(min_interval),
+                               .compress = parse_compression(
+                                   registrator.element)});
   }
 
   return registrators;
 }
 
-}  // namespace parser
\ No newline at end of file
+auto XmlParser::parse_pollers(const tinyxml2::XMLElement *root)
+    -> std::vector<PollerDescription> {
+  std::vector<PollerDescription> pollers;
+
+  const auto *statistics = root->FirstChildElement(statistics_tag);
+  if (statistics == nullptr) {
+    return pollers;
+  }
+
+  for (const auto &poller : xml_element_range(statistics, poller_tag)) {
+    PollerDescription description;
+    description.file = poller.get_attribute<std::string>(file_attr);
+    description.period = poller.get_attribute<std::string>(period_attr);
+    description.start_time =
+        poller.get_attribute<std::string>(start_attr, false, "0s");
+
+    auto end_time = poller.get_attribute<std::string>(end_attr, false);
+    if (!end_time.empty()) {
+      description.end_time = std::move(end_time);
+    }
+
+    auto format_str =
+        poller.get_attribute<std::string>(format_attr, false, "csv");
+    auto format = stats::output_format_from_string(format_str);
+    if (!format.has_value()) {
+      throw AttributeError("Unknown output format", format_attr,
+                           poller.element);
+    }
+    description.format = *format;
+    description.compress = parse_compression(poller.element);
+
+    description.values = parse_polled_values(poller.element);
+    if (description.values.empty()) {
+      throw ParseError(fmt::format(R"(Poller "{}" has no values on line {})",
+                                   description.file,
+                                   poller->GetLineNum()));
+    }
+
+    pollers.push_back(std::move(description));
+  }
+
+  return pollers;
+}
+
+auto XmlParser::parse_polled_values(const tinyxml2::XMLElement *poller)
+    -> std::vector<PolledValueDescription> {
+  std::vector<PolledValueDescription> values;
+
+  for (const auto &value : xml_element_range(poller, polled_value_tag)) {
+    PolledValueDescription description;
+    description.name = value.get_attribute<std::string>(name_attr);
+    description.object = value.get_attribute<std::string>(object_attr);
+    description.attribute =
+        value.get_attribute<std::string>(attribute_attr, false);
+    description.getter = value.get_attribute<std::string>(getter_attr, false);
+
+    if (description.attribute.empty() == description.getter.empty()) {
+      throw AttributeError("Exactly one of attribute or getter is required",
+                           attribute_attr, value.element);
+    }
+
+    values.push_back(std::move(description));
+  }
+
+  return values;
+}
+
+auto XmlParser::parse_statistics_settings(const tinyxml2::XMLElement *root)
+    -> StatisticsDescription {
+  StatisticsDescription settings;
+
+  const auto *statistics = root->FirstChildElement(statistics_tag);
+  if (statistics == nullptr) {
+    return settings;
+  }
+
+  settings.async = get_attribute<bool>(statistics, async_attr, false, false);
+  settings.queue_size = get_attribute<std::uint32_t>(
+      statistics, queue_size_attr, false, settings.queue_size);
+  if (settings.queue_size == 0) {
+    throw AttributeError("Queue size must be positive", queue_size_attr,
+                         statistics);
+  }
+
+  auto overflow_str =
+      get_attribute<std::string>(statistics, overflow_attr, false, "block");
+  auto overflow = stats::overflow_policy_from_string(overflow_str);
+  if (!overflow.has_value()) {
+    throw AttributeError("Unknown overflow policy", overflow_attr, statistics);
+  }
+  settings.overflow = *overflow;
+
+  auto container =
+      get_attribute<std::string>(statistics, container_attr, false);
+  if (!container.empty()) {
+    settings.container = std::move(container);
+  }
+
+  settings.compress =
+      parse_compression(statistics).value_or(stats::compression::none);
+
+  auto live = get_attribute<std::string>(statistics, live_attr, false);
+  if (!live.empty()) {
+    settings.live = std::move(live);
+  }
+
+  settings.live_capacity = get_attribute<std::uint32_t>(
+      statistics, live_capacity_attr, false, settings.live_capacity);
+  if (settings.live_capacity == 0) {
+    throw AttributeError("Live capacity must be positive", live_capacity_attr,
+                         statistics);
+  }
+
+  return settings;
+}
+
+auto XmlParser::parse_background(const tinyxml2::XMLElement *root)
+    -> BackgroundDescription {
+  BackgroundDescription background;
+
+  const auto *tag = root->FirstChildElement(background_tag);
+  if (tag == nullptr) {
+    return background;
+  }
+
+  auto mode_str = get_attribute<std::string>(tag, mode_attr, false, "capacity");
+  auto mode = model::background_mode_from_string(mode_str);
+  if (!mode.has_value()) {
+    throw AttributeError("Unknown background mode", mode_attr, tag);
+  }
+  background.mode = *mode;
+
+  for (const auto &flow : xml_element_range(tag, flow_tag)) {
+    BackgroundFlowDescription description;
+    description.name = flow.get_attribute<std::string>(name_attr);
+    description.source = flow.get_attribute<std::string>(source_attr);
+
+    auto destination = address::from_string_v4(
+        flow.get_attribute<std::string>(destination_attr), "255.255.255.255");
+    if (!destination.has_value()) {
+      throw AttributeError("Bad IPv4 address", destination_attr, flow.element);
+    }
+    description.destination = destination->address();
+
+    description.rate = flow.get_attribute<std::string>(rate_attr);
+    description.packet_size = flow.get_attribute<std::uint32_t>(
+        packet_size_attr, false, description.packet_size);
+    if (description.packet_size == 0) {
+      throw AttributeError("Packet size must be positive", packet_size_attr,
+                           flow.element);
+    }
+
+    description.start_time =
+        flow.get_attribute<std::string>(start_attr, false, "0s");
+    auto end_time = flow.get_attribute<std::string>(end_attr, false);
+    if (!end_time.empty()) {
+      description.end_time = std::move(end_time);
+    }
+
+    background.flows.push_back(std::move(description));
+  }
+
+  return background;
+}
+
+}  // namespace parser
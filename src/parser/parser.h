@@ -12,7 +12,12 @@
 
 #include <ns3/nstime.h>
 
+#include "model/background_traffic.h"
 #include "model/channel.h"
+#include "stats/compression.h"
+#include "stats/packet_filter.h"
+#include "stats/window_aggregator.h"
+#include "stats/writer.h"
 #include "utils/address.h"
 
 namespace tinyxml2 {
@@ -23,6 +28,17 @@ namespace parser {
 
 using Attributes = std::map<std::string, std::string>;
 
+struct CaptureDescription {
+  // File name without ".pcapng" extension
+  std::string file;
+  stats::capture_protocol protocol = stats::capture_protocol::any;
+  // Source or destination port, any if not set
+  std::optional<std::uint16_t> port;
+  // Keep every N-th matching packet
+  std::uint32_t sample = 1;
+  std::uint32_t snap_length = 65535;
+};
+
 struct DeviceDescription {
   std::string name;
   std::string type;
@@ -31,6 +47,7 @@ struct DeviceDescription {
   std::vector<address::network_v6> ipv6_addresses;
 
   Attributes attributes;
+  std::optional<CaptureDescription> capture;
 };
 
 struct ApplicationDescription {
@@ -78,17 +95,85 @@ struct RegistratorDescription {
   std::string file;
   std::string start_time;
   std::optional<std::string> end_time;
+  stats::output_format format = stats::output_format::csv;
+  // Aggregation window, samples are written as is if not set
+  std::optional<std::string> window;
+  std::vector<stats::Statistic> statistics;
+  // Keep every N-th sample
+  std::uint32_t decimate = 1;
+  // Minimal interval between kept samples
+  std::optional<std::string> min_interval;
+  // Overrides compression of statistics settings
+  std::optional<stats::compression> compress;
+};
+
+struct PolledValueDescription {
+  // Column name
+  std::string name;
+  // Path of the object in the name registry: "node-a/eth0"
+  std::string object;
+  // Either attribute of the object or one of the known getters
+  std::string attribute;
+  std::string getter;
+};
+
+struct PollerDescription {
+  std::string file;
+  std::string period;
+  std::string start_time = "0s";
+  std::optional<std::string> end_time;
+  stats::output_format format = stats::output_format::csv;
+  // Overrides compression of statistics settings
+  std::optional<stats::compression> compress;
+  std::vector<PolledValueDescription> values;
+};
+
+struct StatisticsDescription {
+  // Write statistics on the background thread
+  bool async = false;
+  // Capacity of each registrator queue in samples
+  std::uint32_t queue_size = 1 << 16;
+  stats::overflow_policy overflow = stats::overflow_policy::block;
+  // Write all streams to one container file instead of file per registrator
+  std::optional<std::string> container;
+  // Compression of own files of registrators and pollers
+  stats::compression compress = stats::compression::none;
+  // Prefix of shared memory segments with live statistics
+  std::optional<std::string> live;
+  // Number of rows kept in each live segment
+  std::uint32_t live_capacity = 1 << 16;
+};
+
+struct BackgroundFlowDescription {
+  std::string name;
+  // Name of the node, where flow starts
+  std::string source;
+  address::address_v4 destination;
+  std::string rate;
+  std::uint32_t packet_size = 1500;
+  std::string start_time = "0s";
+  std::optional<std::string> end_time;
+};
+
+struct BackgroundDescription {
+  model::background_mode mode = model::background_mode::capacity;
+  std::vector<BackgroundFlowDescription> flows;
 };
 
 struct ModelDescription {
   std::string model_name;
   bool polulate_tables = false;
+  // Fill ARP and NDP caches with permanent entries of on-link peers
+  bool populate_neighbor_cache = false;
   std::string end_time = "0s";
   ns3::Time::Unit time_precision = ns3::Time::NS;
 
   std::vector<NodeDescription> nodes;
   std::vector<ConnectionDescription> connections;
   std::vector<RegistratorDescription> registrators;
+  std::vector<PollerDescription> pollers;
+  StatisticsDescription statistics;
+  BackgroundDescription background;
 };
 
 class ParseError : public std::runtime_error {
@@ -126,6 +211,9 @@ class XmlParser {
 
   auto parse_attributes(const tinyxml2::XMLElement *element) -> Attributes;
 
+  auto parse_capture(const tinyxml2::XMLElement *device)
+      -> std::optional<CaptureDescription>;
+
   auto parse_applications(const tinyxml2::XMLElement *node)
       -> std::vector<ApplicationDescription>;
 
@@ -139,6 +227,18 @@ class XmlParser {
 
   auto parse_statistics(const tinyxml2::XMLElement *root)
       -> std::vector<RegistratorDescription>;
+
+  auto parse_pollers(const tinyxml2::XMLElement *root)
+      -> std::vector<PollerDescription>;
+
+  auto parse_polled_values(const tinyxml2::XMLElement *poller)
+      -> std::vector<PolledValueDescription>;
+
+  auto parse_statistics_settings(const tinyxml2::XMLElement *root)
+      -> StatisticsDescription;
+
+  auto parse_background(const tinyxml2::XMLElement *root)
+      -> BackgroundDescription;
 };
 
 };  // namespace parser
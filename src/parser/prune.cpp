@@ -0,0 +1,534 @@
+#include "prune.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fnmatch.h>
+
+#include <boost/asio/ip/address.hpp>
+#include <boost/system/error_code.hpp>
+
+#include "parser/parser.h"
+#include "profiling/build_profiler.h"
+
+namespace parser {
+
+namespace {
+constexpr auto names_prefix = std::string_view{"/Names/"};
+constexpr auto node_list_prefix = std::string_view{"/NodeList/"};
+
+/**
+ * @brief Undirected graph of nodes and connections
+ *
+ * Connections are vertices too, so a CSMA segment joins its nodes without
+ * adding edges between every pair of them.
+ */
+class Graph {
+ public:
+  explicit Graph(std::size_t vertices) : _adjacent(vertices) {}
+
+  void add_edge(std::size_t lhs, std::size_t rhs) {
+    _adjacent[lhs].push_back(rhs);
+    _adjacent[rhs].push_back(lhs);
+  }
+
+  /**
+   * @brief Vertices of biconnected blocks, found by iterative Tarjan search
+   *
+   */
+  auto blocks() const -> std::vector<std::vector<std::size_t>>;
+
+ private:
+  std::vector<std::vector<std::size_t>> _adjacent;
+};
+
+auto Graph::blocks() const -> std::vector<std::vector<std::size_t>> {
+  constexpr auto undiscovered = std::size_t(-1);
+
+  struct Frame {
+    std::size_t vertex;
+    std::size_t parent;
+    std::size_t next = 0;
+  };
+
+  std::vector<std::vector<std::size_t>> result;
+  std::vector<std::size_t> discovered(_adjacent.size(), undiscovered);
+  std::vector<std::size_t> low(_adjacent.size(), 0);
+  std::vector<std::size_t> visited;
+  std::vector<Frame> frames;
+  std::size_t time = 0;
+
+  for (std::size_t root = 0; root < _adjacent.size(); ++root) {
+    if (discovered[root] != undiscovered) {
+      continue;
+    }
+
+    discovered[root] = low[root] = time++;
+    visited.push_back(root);
+    frames.push_back({.vertex = root, .parent = undiscovered});
+
+    while (!frames.empty()) {
+      auto &frame = frames.back();
+      auto vertex = frame.vertex;
+
+      if (frame.next < _adjacent[vertex].size()) {
+        auto next = _adjacent[vertex][frame.next++];
+        if (next == frame.parent) {
+          continue;
+        }
+
+        if (discovered[next] == undiscovered) {
+          discovered[next] = low[next] = time++;
+          visited.push_back(next);
+          frames.push_back({.vertex = next, .parent = vertex});
+        } else {
+          low[vertex] = std::min(low[vertex], discovered[next]);
+        }
+        continue;
+      }
+
+      frames.pop_back();
+      if (frames.empty()) {
+        visited.clear();
+        continue;
+      }
+
+      auto parent = frames.back().vertex;
+      low[parent] = std::min(low[parent], low[vertex]);
+      if (low[vertex] >= discovered[parent]) {
+        std::vector<std::size_t> block{parent};
+        std::size_t top = 0;
+        do {
+          top = visited.back();
+          visited.pop_back();
+          block.push_back(top);
+        } while (top != vertex);
+        result.push_back(std::move(block));
+      }
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Vertices on simple paths between terminals
+ *
+ * Keeps blocks of the block-cut tree spanning terminals, which join at
+ * least two terminals or branches leading to them.
+ */
+auto path_closure(const Graph &graph, std::size_t vertices,
+                  const std::vector<bool> &terminal) -> std::vector<bool> {
+  auto blocks = graph.blocks();
+
+  std::vector<std::vector<std::size_t>> blocks_of(vertices);
+  for (std::size_t block = 0; block < blocks.size(); ++block) {
+    for (auto vertex : blocks[block]) {
+      blocks_of[vertex].push_back(block);
+    }
+  }
+
+  // Block-cut tree: blocks are 0..B-1, cut vertices follow them
+  std::map<std::size_t, std::size_t> cut_index;
+  std::vector<std::vector<std::size_t>> tree(blocks.size());
+  for (std::size_t vertex = 0; vertex < vertices; ++vertex) {
+    if (blocks_of[vertex].size() < 2) {
+      continue;
+    }
+    auto index = tree.size();
+    cut_index[vertex] = index;
+    tree.emplace_back();
+    for (auto block : blocks_of[vertex]) {
+      tree[index].push_back(block);
+      tree[block].push_back(index);
+    }
+  }
+
+  std::vector<bool> required(tree.size(), false);
+  for (std::size_t vertex = 0; vertex < vertices; ++vertex) {
+    if (!terminal[vertex]) {
+      continue;
+    }
+    if (auto it = cut_index.find(vertex); it != cut_index.end()) {
+      required[it->second] = true;
+    } else if (!blocks_of[vertex].empty()) {
+      required[blocks_of[vertex].front()] = true;
+    }
+  }
+
+  // Steiner subtree of required tree nodes: strip other leaves
+  std::vector<std::size_t> degree(tree.size());
+  std::vector<bool> removed(tree.size(), false);
+  std::vector<std::size_t> leaves;
+  for (std::size_t node = 0; node < tree.size(); ++node) {
+    degree[node] = tree[node].size();
+    if (degree[node] <= 1 && !required[node]) {
+      leaves.push_back(node);
+    }
+  }
+
+  while (!leaves.empty()) {
+    auto leaf = leaves.back();
+    leaves.pop_back();
+    removed[leaf] = true;
+
+    for (auto next : tree[leaf]) {
+      if (!removed[next] && --degree[next] <= 1 && !required[next]) {
+        leaves.push_back(next);
+      }
+    }
+  }
+
+  auto result = terminal;
+  for (std::size_t block = 0; block < blocks.size(); ++block) {
+    if (removed[block]) {
+      continue;
+    }
+
+    std::size_t attachments = 0;
+    for (auto vertex : blocks[block]) {
+      auto cut = cut_index.find(vertex);
+      if (terminal[vertex] ||
+          (cut != cut_index.end() && !removed[cut->second] &&
+           degree[cut->second] >= 2)) {
+        ++attachments;
+      }
+    }
+
+    if (attachments >= 2) {
+      for (auto vertex : blocks[block]) {
+        result[vertex] = true;
+      }
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief IP address of serialized ns3::Address: "0-4-0A:01:16:02"
+ *
+ * Format is "{type}-{length}-{bytes}", addresses of 4 and 16 bytes are
+ * taken as IPv4 and IPv6, type is ignored as its value depends on order of
+ * registration. Socket addresses append port and TOS to the address:
+ * "0-7-0A:01:16:02:9a:02:00" is 10.1.22.2.
+ */
+auto parse_ns3_address(const std::string &value)
+    -> std::optional<boost::asio::ip::address> {
+  constexpr std::size_t ipv4_length = 4;
+  constexpr std::size_t ipv6_length = 16;
+  // Inet(6)SocketAddress: address, 2 bytes of port, optional TOS byte
+  constexpr std::size_t port_length = 2;
+  constexpr std::size_t tos_length = 1;
+  constexpr auto hex = 16;
+
+  auto type_end = value.find('-');
+  auto length_end = value.find('-', type_end + 1);
+  if (type_end == std::string::npos || length_end == std::string::npos) {
+    return {};
+  }
+
+  std::vector<unsigned char> bytes;
+  std::size_t begin = length_end + 1;
+  while (begin < value.size()) {
+    auto end = std::min(value.find(':', begin), value.size());
+    std::size_t parsed = 0;
+    try {
+      auto byte = std::stoul(value.substr(begin, end - begin), &parsed, hex);
+      if (parsed != end - begin || byte > UINT8_MAX) {
+        return {};
+      }
+      bytes.push_back(static_cast<unsigned char>(byte));
+    } catch (const std::exception &) {
+      return {};
+    }
+    begin = end + 1;
+  }
+
+  auto has_length = [&](std::size_t address_length) {
+    return bytes.size() == address_length ||
+           bytes.size() == address_length + port_length ||
+           bytes.size() == address_length + port_length + tos_length;
+  };
+
+  if (has_length(ipv4_length)) {
+    boost::asio::ip::address_v4::bytes_type v4;
+    std::copy_n(bytes.begin(), ipv4_length, v4.begin());
+    return boost::asio::ip::address_v4{v4};
+  }
+  if (has_length(ipv6_length)) {
+    boost::asio::ip::address_v6::bytes_type v6;
+    std::copy_n(bytes.begin(), ipv6_length, v6.begin());
+    return boost::asio::ip::address_v6{v6};
+  }
+  return {};
+}
+
+auto parse_ip(const std::string &value) -> std::optional<std::string> {
+  boost::system::error_code error;
+  auto address = boost::asio::ip::make_address(value, error);
+  if (!error) {
+    return address.to_string();
+  }
+
+  if (auto serialized = parse_ns3_address(value); serialized.has_value()) {
+    return serialized->to_string();
+  }
+  return {};
+}
+
+// Config path wildcards and alternatives
+bool is_pattern(std::string_view name) noexcept {
+  return name.find_first_of("*?[|") != std::string_view::npos;
+}
+
+// Name matches pattern element of Config path: "server-*" or "eth0|eth1"
+bool matches(const std::string &pattern, const std::string &name) {
+  if (!is_pattern(pattern)) {
+    return pattern == name;
+  }
+
+  std::size_t begin = 0;
+  while (begin <= pattern.size()) {
+    auto end = std::min(pattern.find('|', begin), pattern.size());
+    auto alternative = pattern.substr(begin, end - begin);
+    if (fnmatch(alternative.c_str(), name.c_str(), 0) == 0) {
+      return true;
+    }
+    begin = end + 1;
+  }
+  return false;
+}
+
+// First path element after prefix: "/Names/node-a/eth0" -> "node-a"
+auto element_after(std::string_view path, std::string_view prefix)
+    -> std::optional<std::string> {
+  if (path.substr(0, prefix.size()) != prefix) {
+    return {};
+  }
+  path.remove_prefix(prefix.size());
+  return std::string{path.substr(0, path.find('/'))};
+}
+}  // namespace
+
+auto prune(ModelDescription &description) -> PruneReport {
+  profiling::ScopedPhase phase{"parse/prune"};
+
+  PruneReport report;
+
+  auto &nodes = description.nodes;
+  auto &connections = description.connections;
+
+  // Owner of address as node index and "{node}/{device}"
+  std::map<std::string, std::pair<std::size_t, std::string>> address_owner;
+  std::map<std::string, std::size_t> node_index;
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    node_index[nodes[i].name] = i;
+    for (const auto &device : nodes[i].devices) {
+      auto path = nodes[i].name + "/" + device.name;
+      for (const auto &ip : device.ipv4_addresses) {
+        address_owner[ip.address().to_string()] = {i, path};
+      }
+      for (const auto &ip : device.ipv6_addresses) {
+        address_owner[ip.address().to_string()] = {i, path};
+      }
+    }
+  }
+
+  std::vector<bool> pinned(nodes.size(), false);
+  std::set<std::string> pinned_devices;
+
+  // Application endpoints
+  std::vector<bool> terminal(nodes.size() + connections.size(), false);
+  auto mark_address = [&](const std::string &value) {
+    if (auto ip = parse_ip(value); ip.has_value()) {
+      if (auto it = address_owner.find(*ip); it != address_owner.end()) {
+        terminal[it->second.first] = true;
+        pinned_devices.insert(it->second.second);
+      }
+    }
+  };
+
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    for (const auto &app : nodes[i].applications) {
+      terminal[i] = true;
+      for (const auto &[key, value] : app.attributes) {
+        mark_address(value);
+      }
+    }
+  }
+
+  for (const auto &flow : description.background.flows) {
+    if (auto it = node_index.find(flow.source); it != node_index.end()) {
+      terminal[it->second] = true;
+    }
+    mark_address(flow.destination.to_string());
+  }
+
+  report.endpoints = static_cast<std::size_t>(
+      std::count(terminal.begin(), terminal.end(), true));
+  if (report.endpoints == 0) {
+    return report;
+  }
+
+  // Nodes and devices observed by statistics
+  bool devices_by_index = false;
+
+  auto pin_path = [&](std::string_view path) {
+    // "{node}/{device}" or "/Names/{node}/{device}/..."
+    if (path.substr(0, names_prefix.size()) == names_prefix) {
+      path.remove_prefix(names_prefix.size());
+    }
+    auto node_end = path.find('/');
+    auto node_pattern = std::string{path.substr(0, node_end)};
+    std::optional<std::string> device_pattern;
+    if (node_end != std::string_view::npos) {
+      auto device = path.substr(node_end + 1);
+      device_pattern = std::string{device.substr(0, device.find('/'))};
+    }
+
+    // Patterns of registrator sources match names as in Config paths
+    for (auto &node : nodes) {
+      if (!matches(node_pattern, node.name)) {
+        continue;
+      }
+      pinned[node_index[node.name]] = true;
+      if (!device_pattern.has_value()) {
+        continue;
+      }
+      for (const auto &device : node.devices) {
+        if (matches(*device_pattern, device.name)) {
+          pinned_devices.insert(node.name + "/" + device.name);
+        }
+      }
+    }
+  };
+
+  for (const auto &registrator : description.registrators) {
+    const auto &source = registrator.source;
+    auto index = element_after(source, node_list_prefix);
+    if (index.has_value() && !index->empty() &&
+        std::all_of(index->begin(), index->end(),
+                    [](char c) { return c >= '0' && c <= '9'; })) {
+      // Nodes are numbered in order of description
+      auto last = std::min<std::size_t>(std::stoul(*index), nodes.size() - 1);
+      std::fill(pinned.begin(), pinned.begin() + last + 1, true);
+    } else if (index.has_value() && is_pattern(*index)) {
+      // Indices of "/NodeList/*" and "/NodeList/[0-3]" are not resolved
+      std::fill(pinned.begin(), pinned.end(), true);
+    } else if (source.rfind(names_prefix, 0) == 0) {
+      pin_path(source);
+    }
+
+    if (source.find("/DeviceList/") != std::string::npos ||
+        source.find("/InterfaceList/") != std::string::npos) {
+      devices_by_index = true;
+    }
+  }
+
+  for (const auto &poller : description.pollers) {
+    for (const auto &value : poller.values) {
+      pin_path(value.object);
+    }
+  }
+
+  for (const auto &node : nodes) {
+    for (const auto &device : node.devices) {
+      if (device.capture.has_value()) {
+        pinned[node_index[node.name]] = true;
+        pinned_devices.insert(node.name + "/" + device.name);
+      }
+    }
+  }
+
+  // Graph of nodes and connections
+  Graph graph{terminal.size()};
+  for (std::size_t i = 0; i < connections.size(); ++i) {
+    for (const auto &interface : connections[i].interfaces) {
+      auto node = interface.substr(0, interface.find('/'));
+      if (auto it = node_index.find(node); it != node_index.end()) {
+        graph.add_edge(it->second, nodes.size() + i);
+      }
+    }
+  }
+
+  auto kept = path_closure(graph, terminal.size(), terminal);
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    kept[i] = kept[i] || pinned[i];
+  }
+
+  // Connections keep interfaces of kept nodes, at least two of them
+  std::set<std::string> connected;
+  std::vector<ConnectionDescription> kept_connections;
+  for (auto &connection : connections) {
+    auto &interfaces = connection.interfaces;
+    interfaces.erase(
+        std::remove_if(interfaces.begin(), interfaces.end(),
+                       [&](const std::string &interface) {
+                         auto it = node_index.find(
+                             interface.substr(0, interface.find('/')));
+                         return it != node_index.end() && !kept[it->second];
+                       }),
+        interfaces.end());
+
+    if (interfaces.size() < 2) {
+      report.connections.push_back(connection.name);
+      continue;
+    }
+
+    connected.insert(interfaces.begin(), interfaces.end());
+    kept_connections.push_back(std::move(connection));
+  }
+  connections = std::move(kept_connections);
+
+  std::vector<NodeDescription> kept_nodes;
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    auto &node = nodes[i];
+    if (!kept[i]) {
+      report.nodes.push_back(node.name);
+      continue;
+    }
+
+    if (!devices_by_index) {
+      std::set<std::string> routed;
+      for (const auto &route : node.routing.ipv4) {
+        routed.insert(route.interface);
+      }
+      for (const auto &route : node.routing.ipv6) {
+        routed.insert(route.interface);
+      }
+
+      auto &devices = node.devices;
+      devices.erase(
+          std::remove_if(
+              devices.begin(), devices.end(),
+              [&](const DeviceDescription &device) {
+                auto path = node.name + "/" + device.name;
+                auto unused = connected.count(path) == 0 &&
+                              pinned_devices.count(path) == 0 &&
+                              routed.count(device.name) == 0;
+                if (unused) {
+                  report.devices.push_back(path);
+                }
+                return unused;
+              }),
+          devices.end());
+    }
+
+    kept_nodes.push_back(std::move(node));
+  }
+  nodes = std::move(kept_nodes);
+
+  return report;
+}
+
+}  // namespace parser
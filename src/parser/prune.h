@@ -0,0 +1,52 @@
+#ifndef __PRUNE_H_C5TX8WQ1MKE3__
+#define __PRUNE_H_C5TX8WQ1MKE3__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace parser {
+
+struct ModelDescription;
+
+/**
+ * @brief Parts of description removed by prune()
+ *
+ */
+struct PruneReport {
+  // Nodes of application endpoints, pruning is skipped without them
+  std::size_t endpoints = 0;
+  std::vector<std::string> nodes;
+  // Devices without connection in "{node}/{device}" format
+  std::vector<std::string> devices;
+  std::vector<std::string> connections;
+
+  auto empty() const noexcept -> bool {
+    return nodes.empty() && devices.empty() && connections.empty();
+  }
+};
+
+/**
+ * @brief Remove nodes that can't lie on a path between application endpoints
+ *
+ * Endpoints are nodes with applications, nodes owning addresses used in
+ * application attributes and source and destination nodes of background
+ * flows. A node is kept if it lies on a simple path between two endpoints
+ * in the graph of nodes and connections: all nodes of a biconnected block
+ * are kept when the block joins two endpoints or parts of the graph leading
+ * to them.
+ *
+ * Nodes referenced by statistics and packet captures are kept too, and so
+ * are nodes up to the highest index used in "/NodeList/{index}" paths, so
+ * indices are not shifted. Devices without connection are removed unless
+ * they are referenced by routes, statistics or captures, and are kept on
+ * all nodes if statistics address devices or interfaces by index.
+ *
+ * @param description parsed model, modified in place
+ * @return PruneReport
+ */
+auto prune(ModelDescription &description) -> PruneReport;
+
+}  // namespace parser
+
+#endif  // __PRUNE_H_C5TX8WQ1MKE3__
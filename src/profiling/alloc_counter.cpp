@@ -0,0 +1,128 @@
+#include "alloc_counter.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <ostream>
+
+#include <fmt/core.h>
+
+namespace profiling::alloc {
+
+namespace {
+struct AtomicCounters {
+  std::atomic<std::uint64_t> count{0};
+  std::atomic<std::uint64_t> bytes{0};
+  std::atomic<std::int64_t> peak{0};
+};
+
+constexpr auto phases_count = static_cast<std::size_t>(phase::count);
+
+std::atomic<bool> g_enabled{false};                    // NOLINT
+std::atomic<phase> g_phase{phase::none};               // NOLINT
+std::atomic<std::int64_t> g_live{0};                   // NOLINT
+AtomicCounters g_total;                                // NOLINT
+std::array<AtomicCounters, phases_count> g_per_phase;  // NOLINT
+
+void update_peak(std::atomic<std::int64_t> &peak, std::int64_t live) noexcept {
+  auto current = peak.load(std::memory_order_relaxed);
+  while (live > current && !peak.compare_exchange_weak(
+                               current, live, std::memory_order_relaxed)) {
+  }
+}
+
+auto load(const AtomicCounters &counters) noexcept -> Counters {
+  return {.count = counters.count.load(std::memory_order_relaxed),
+          .bytes = counters.bytes.load(std::memory_order_relaxed),
+          .peak = counters.peak.load(std::memory_order_relaxed)};
+}
+}  // namespace
+
+void enable() noexcept { g_enabled.store(true, std::memory_order_relaxed); }
+
+bool enabled() noexcept { return g_enabled.load(std::memory_order_relaxed); }
+
+void on_alloc(std::size_t size, std::size_t usable) noexcept {
+  if (!enabled()) {
+    return;
+  }
+
+  auto live = g_live.fetch_add(static_cast<std::int64_t>(usable),
+                               std::memory_order_relaxed) +
+              static_cast<std::int64_t>(usable);
+
+  auto &phase_counters =
+      g_per_phase[static_cast<std::size_t>(current_phase())];
+
+  for (auto *counters : {&g_total, &phase_counters}) {
+    counters->count.fetch_add(1, std::memory_order_relaxed);
+    counters->bytes.fetch_add(size, std::memory_order_relaxed);
+    update_peak(counters->peak, live);
+  }
+}
+
+void on_free(std::size_t usable) noexcept {
+  if (!enabled()) {
+    return;
+  }
+
+  // Blocks allocated before enable() were not counted, so live bytes are
+  // not decreased below zero
+  auto live = g_live.load(std::memory_order_relaxed);
+  while (live > 0 &&
+         !g_live.compare_exchange_weak(
+             live, std::max<std::int64_t>(
+                       live - static_cast<std::int64_t>(usable), 0),
+             std::memory_order_relaxed)) {
+  }
+}
+
+auto snapshot() noexcept -> Counters { return load(g_total); }
+
+auto snapshot(phase phase) noexcept -> Counters {
+  return load(g_per_phase[static_cast<std::size_t>(phase)]);
+}
+
+auto set_phase(phase phase) noexcept -> alloc::phase {
+  return g_phase.exchange(phase, std::memory_order_relaxed);
+}
+
+auto current_phase() noexcept -> phase {
+  return g_phase.load(std::memory_order_relaxed);
+}
+
+auto to_string(phase phase) noexcept -> const char * {
+  switch (phase) {
+    case phase::none:
+      return "none";
+    case phase::parse:
+      return "parse";
+    case phase::build:
+      return "build";
+    case phase::routing:
+      return "routing";
+    case phase::run:
+      return "run";
+    default:
+      return "unknown";
+  }
+}
+
+void report(std::ostream &out) {
+  out << fmt::format("{:<10} {:>12} {:>14} {:>12}\n", "phase", "allocs",
+                     "alloc, KiB", "peak, KiB");
+
+  for (std::size_t i = 0; i < phases_count; ++i) {
+    auto counters = load(g_per_phase[i]);
+    if (counters.count == 0) {
+      continue;
+    }
+
+    out << fmt::format("{:<10} {:>12} {:>14.1f} {:>12}\n",
+                       to_string(static_cast<phase>(i)), counters.count,
+                       static_cast<double>(counters.bytes) / 1024,
+                       counters.peak / 1024);
+  }
+}
+
+}  // namespace profiling::alloc
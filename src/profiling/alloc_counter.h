@@ -0,0 +1,107 @@
+#ifndef __ALLOC_COUNTER_H_3VZP8RKD1NQ6__
+#define __ALLOC_COUNTER_H_3VZP8RKD1NQ6__
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+/**
+ * @brief Heap allocation counters
+ *
+ * Counters are fed by global operator new/delete replacements linked into
+ * the `simulation` executable (see alloc_hooks.cpp). Without the hooks, or
+ * while counting is disabled, all counters stay zero.
+ */
+namespace profiling::alloc {
+
+/**
+ * @brief Program phase allocations are attributed to
+ *
+ */
+enum class phase : std::uint8_t { none, parse, build, routing, run, count };
+
+struct Counters {
+  std::uint64_t count = 0;
+  std::uint64_t bytes = 0;
+  // Maximum of live heap bytes observed, counted from enable()
+  std::int64_t peak = 0;
+};
+
+/**
+ * @brief Start counting allocations
+ *
+ */
+void enable() noexcept;
+
+bool enabled() noexcept;
+
+/**
+ * @brief Account allocation, called by allocation hooks
+ *
+ * @param size requested size
+ * @param usable size of allocated block
+ */
+void on_alloc(std::size_t size, std::size_t usable) noexcept;
+
+/**
+ * @brief Account deallocation, called by allocation hooks
+ *
+ * Live bytes don't go below zero on release of blocks allocated before
+ * enable().
+ *
+ * @param usable size of released block
+ */
+void on_free(std::size_t usable) noexcept;
+
+/**
+ * @brief Get current values of total counters
+ *
+ * @return Counters
+ */
+auto snapshot() noexcept -> Counters;
+
+/**
+ * @brief Get counters of allocations made in given phase
+ *
+ * @return Counters
+ */
+auto snapshot(phase phase) noexcept -> Counters;
+
+/**
+ * @brief Set phase of following allocations
+ *
+ * @param phase
+ * @return phase previous phase
+ */
+auto set_phase(phase phase) noexcept -> alloc::phase;
+
+auto current_phase() noexcept -> phase;
+
+auto to_string(phase phase) noexcept -> const char *;
+
+/**
+ * @brief Print counters of each phase
+ *
+ * @param out
+ */
+void report(std::ostream &out);
+
+/**
+ * @brief Sets phase for the enclosing scope, restores previous on exit
+ *
+ */
+class PhaseScope {
+ public:
+  explicit PhaseScope(phase phase) noexcept : _previous{set_phase(phase)} {}
+  ~PhaseScope() { set_phase(_previous); }
+
+  PhaseScope(const PhaseScope &) = delete;
+  PhaseScope &operator=(const PhaseScope &) = delete;
+
+ private:
+  phase _previous;
+};
+
+}  // namespace profiling::alloc
+
+#endif  // __ALLOC_COUNTER_H_3VZP8RKD1NQ6__
@@ -0,0 +1,57 @@
+// Replacement of global allocation functions feeding profiling::alloc
+// counters. Linked only into the `simulation` executable.
+
+#include <cstdlib>
+#include <new>
+
+#include <malloc.h>
+
+#include "profiling/alloc_counter.h"
+
+namespace {
+void *allocate(std::size_t size) noexcept {
+  void *ptr = std::malloc(size == 0 ? 1 : size);  // NOLINT
+  if (ptr != nullptr && profiling::alloc::enabled()) {
+    profiling::alloc::on_alloc(size, malloc_usable_size(ptr));
+  }
+  return ptr;
+}
+
+void deallocate(void *ptr) noexcept {
+  if (ptr != nullptr && profiling::alloc::enabled()) {
+    profiling::alloc::on_free(malloc_usable_size(ptr));
+  }
+  std::free(ptr);  // NOLINT
+}
+}  // namespace
+
+void *operator new(std::size_t size) {
+  void *ptr = allocate(size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc{};
+  }
+  return ptr;
+}
+
+void *operator new[](std::size_t size) { return ::operator new(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t & /*tag*/) noexcept {
+  return allocate(size);
+}
+
+void *operator new[](std::size_t size,
+                     const std::nothrow_t & /*tag*/) noexcept {
+  return allocate(size);
+}
+
+void operator delete(void *ptr) noexcept { deallocate(ptr); }
+
+void operator delete[](void *ptr) noexcept { deallocate(ptr); }
+
+void operator delete(void *ptr, std::size_t /*size*/) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t /*size*/) noexcept {
+  deallocate(ptr);
+}
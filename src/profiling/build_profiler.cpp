@@ -0,0 +1,110 @@
+#include "build_profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+
+#include <unistd.h>
+
+#include <fmt/core.h>
+
+#include "profiling/json.h"
+
+namespace profiling {
+
+auto BuildProfiler::instance() -> BuildProfiler & {
+  static BuildProfiler profiler;
+  return profiler;
+}
+
+auto BuildProfiler::reserve(const std::string &phase) -> std::size_t {
+  auto [it, inserted] = _index.try_emplace(phase, _phases.size());
+  if (inserted) {
+    _phases.emplace_back(phase, PhaseStats{});
+  }
+  return it->second;
+}
+
+void BuildProfiler::add(const std::string &phase, const PhaseStats &stats) {
+  auto &accumulated = _phases[reserve(phase)].second;
+  accumulated.calls += stats.calls;
+  accumulated.wall += stats.wall;
+  accumulated.allocations += stats.allocations;
+  accumulated.allocated_bytes += stats.allocated_bytes;
+  accumulated.rss_delta += stats.rss_delta;
+}
+
+void BuildProfiler::report(std::ostream &out) const {
+  out << fmt::format("{:<32} {:>8} {:>12} {:>12} {:>14} {:>12}\n", "phase",
+                     "calls", "wall, ms", "allocs", "alloc, KiB",
+                     "rss, KiB");
+
+  for (const auto &[name, stats] : phases()) {
+    auto depth = std::count(name.begin(), name.end(), '/');
+    auto label = std::string(2 * depth, ' ') + name.substr(name.rfind('/') + 1);
+
+    out << fmt::format(
+        "{:<32} {:>8} {:>12.3f} {:>12} {:>14.1f} {:>12}\n", label, stats.calls,
+        std::chrono::duration<double, std::milli>(stats.wall).count(),
+        stats.allocations, static_cast<double>(stats.allocated_bytes) / 1024,
+        stats.rss_delta / 1024);
+  }
+}
+
+void BuildProfiler::write_json(const std::string &path) const {
+  std::ofstream out{path};
+  out << "{\"phases\":[";
+
+  bool first = true;
+  for (const auto &[name, stats] : phases()) {
+    out << fmt::format(
+        R"({}{{"phase":"{}","calls":{},"wall_ns":{},"allocations":{},)"
+        R"("allocated_bytes":{},"rss_delta":{}}})",
+        first ? "" : ",", json::escape(name), stats.calls, stats.wall.count(),
+        stats.allocations, stats.allocated_bytes, stats.rss_delta);
+    first = false;
+  }
+
+  out << "]}\n";
+}
+
+ScopedPhase::ScopedPhase(const char *name)
+    : _name{name}, _active{BuildProfiler::instance().enabled()} {
+  if (_active) {
+    BuildProfiler::instance().reserve(_name);
+    _rss = current_rss();
+    _allocs = alloc::snapshot();
+    _start = std::chrono::steady_clock::now();
+  }
+}
+
+ScopedPhase::~ScopedPhase() {
+  if (!_active) {
+    return;
+  }
+
+  auto wall = std::chrono::steady_clock::now() - _start;
+  auto allocs = alloc::snapshot();
+
+  BuildProfiler::instance().add(
+      _name,
+      {.calls = 1,
+       .wall = std::chrono::duration_cast<std::chrono::nanoseconds>(wall),
+       .allocations = allocs.count - _allocs.count,
+       .allocated_bytes = allocs.bytes - _allocs.bytes,
+       .rss_delta = current_rss() - _rss});
+}
+
+auto current_rss() noexcept -> std::int64_t {
+  std::ifstream statm{"/proc/self/statm"};
+  std::int64_t size = 0;
+  std::int64_t resident = 0;
+
+  if (!(statm >> size >> resident)) {
+    return 0;
+  }
+
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+}  // namespace profiling
@@ -0,0 +1,106 @@
+#ifndef __BUILD_PROFILER_H_W2T6JH0MXC5A__
+#define __BUILD_PROFILER_H_W2T6JH0MXC5A__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "profiling/alloc_counter.h"
+
+namespace profiling {
+
+/**
+ * @brief Collects wall time, allocations and RSS delta of model build phases
+ *
+ * Phases are named hierarchically with '/' separator ("build/nodes/stack"),
+ * statistics of repeated phases are accumulated.
+ */
+class BuildProfiler {
+ public:
+  struct PhaseStats {
+    std::uint64_t calls = 0;
+    std::chrono::nanoseconds wall{};
+    std::uint64_t allocations = 0;
+    std::uint64_t allocated_bytes = 0;
+    std::int64_t rss_delta = 0;
+  };
+
+  static auto instance() -> BuildProfiler &;
+
+  void enable() noexcept { _enabled = true; }
+
+  bool enabled() const noexcept { return _enabled; }
+
+  /**
+   * @brief Register phase, so phases are reported in order of first start
+   *
+   * @param phase
+   * @return std::size_t index of phase
+   */
+  auto reserve(const std::string &phase) -> std::size_t;
+
+  void add(const std::string &phase, const PhaseStats &stats);
+
+  auto phases() const
+      -> const std::vector<std::pair<std::string, PhaseStats>> & {
+    return _phases;
+  }
+
+  /**
+   * @brief Print phases as table
+   *
+   * @param out
+   */
+  void report(std::ostream &out) const;
+
+  /**
+   * @brief Write phases in JSON format
+   *
+   * @param path
+   */
+  void write_json(const std::string &path) const;
+
+ private:
+  BuildProfiler() = default;
+
+  bool _enabled = false;
+  std::map<std::string, std::size_t> _index;
+  std::vector<std::pair<std::string, PhaseStats>> _phases;
+};
+
+/**
+ * @brief Measures enclosing scope as phase of BuildProfiler
+ *
+ * Does nothing if profiler is disabled.
+ */
+class ScopedPhase {
+ public:
+  explicit ScopedPhase(const char *name);
+  ~ScopedPhase();
+
+  ScopedPhase(const ScopedPhase &) = delete;
+  ScopedPhase &operator=(const ScopedPhase &) = delete;
+
+ private:
+  const char *_name;
+  bool _active;
+  std::chrono::steady_clock::time_point _start{};
+  alloc::Counters _allocs{};
+  std::int64_t _rss = 0;
+};
+
+/**
+ * @brief Get resident set size of current process
+ *
+ * @return std::int64_t size in bytes, 0 if unavailable
+ */
+auto current_rss() noexcept -> std::int64_t;
+
+}  // namespace profiling
+
+#endif  // __BUILD_PROFILER_H_W2T6JH0MXC5A__
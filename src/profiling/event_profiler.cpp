@@ -0,0 +1,330 @@
+#include "event_profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <vector>
+
+#include <boost/core/demangle.hpp>
+
+#include <ns3/default-simulator-impl.h>
+#include <ns3/simulator.h>
+
+#include <fmt/core.h>
+
+#include "model/model.h"
+#include "model/node.h"
+#include "profiling/json.h"
+
+namespace profiling {
+
+NS_OBJECT_ENSURE_REGISTERED(EventProfiler);
+
+/**
+ * @brief Event wrapper measuring execution time of the original event
+ *
+ */
+class EventProfiler::ProfiledEvent final : public ns3::EventImpl {
+ public:
+  ProfiledEvent(EventProfiler *profiler, std::uint32_t context,
+                ns3::EventImpl *event)
+      : _profiler{profiler},
+        _context{context},
+        // Takes ownership of reference passed to the simulator
+        _event{event, false} {}
+
+ private:
+  void Notify() override {
+    auto start = std::chrono::steady_clock::now();
+    _event->Invoke();
+    auto wall = std::chrono::steady_clock::now() - start;
+
+    _profiler->record(
+        _context, typeid(*ns3::PeekPointer(_event)),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(wall));
+  }
+
+  EventProfiler *_profiler;
+  std::uint32_t _context;
+  ns3::Ptr<ns3::EventImpl> _event;
+};
+
+namespace {
+
+struct NodeNames {
+  std::string name;
+  // TypeId name -> names of model objects of this type
+  std::map<std::string, std::vector<std::string>> objects;
+};
+
+struct Row {
+  std::string node;
+  std::string source;
+  EventProfiler::Stats stats;
+};
+
+auto resolve_names(const model::Model &model)
+    -> std::map<std::uint32_t, NodeNames> {
+  std::map<std::uint32_t, NodeNames> names_per_id;
+
+  for (const auto &node : model.nodes()) {
+    auto &names = names_per_id[node->get()->GetId()];
+    names.name = node->name();
+
+    for (std::size_t i = 0; i < node->devices_count(); ++i) {
+      const auto &device = node->get_device(i);
+      names.objects[device.get()->GetInstanceTypeId().GetName()].push_back(
+          device.name());
+
+      if (device.has_channel()) {
+        const auto channel = device.channel();
+        names.objects[channel->get()->GetInstanceTypeId().GetName()]
+            .push_back(channel->name());
+      }
+    }
+
+    for (const auto &app : node->applications()) {
+      names.objects[app.get()->GetInstanceTypeId().GetName()].push_back(
+          app.name());
+    }
+  }
+
+  return names_per_id;
+}
+
+auto join(const std::vector<std::string> &names) -> std::string {
+  std::string joined;
+  for (const auto &name : names) {
+    if (!joined.empty()) {
+      joined += ',';
+    }
+    joined += name;
+  }
+  return joined;
+}
+
+template <typename StatsMap>
+auto collect_rows(const model::Model &model, const StatsMap &stats)
+    -> std::vector<Row> {
+  auto names_per_id = resolve_names(model);
+
+  std::map<std::pair<std::string, std::string>, EventProfiler::Stats> merged;
+  for (const auto &[key, value] : stats) {
+    const auto &[context, handler_type] = key;
+
+    auto handler = boost::core::demangle(handler_type.name());
+    auto class_name = handler_class(handler);
+    auto source = class_name.empty() ? handler : class_name;
+
+    std::string node;
+    if (context == ns3::Simulator::NO_CONTEXT) {
+      node = "-";
+    } else if (auto it = names_per_id.find(context);
+               it != names_per_id.end()) {
+      node = it->second.name;
+      if (auto object = it->second.objects.find(class_name);
+          object != it->second.objects.end()) {
+        source = join(object->second);
+      }
+    } else {
+      node = fmt::format("#{}", context);
+    }
+
+    auto &row = merged[{node, source}];
+    row.events += value.events;
+    row.wall += value.wall;
+  }
+
+  std::vector<Row> rows;
+  rows.reserve(merged.size());
+  for (auto &[key, value] : merged) {
+    rows.push_back(
+        Row{.node = key.first, .source = key.second, .stats = value});
+  }
+
+  std::sort(rows.begin(), rows.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.stats.wall > rhs.stats.wall;
+  });
+
+  return rows;
+}
+
+auto total(const std::vector<Row> &rows) -> EventProfiler::Stats {
+  EventProfiler::Stats sum;
+  for (const auto &row : rows) {
+    sum.events += row.stats.events;
+    sum.wall += row.stats.wall;
+  }
+  return sum;
+}
+
+}  // namespace
+
+// Member function events are named like
+// "ns3::MakeEvent<void (ns3::UdpEchoClient::*)(), ...>(...)::EventMemberImpl"
+auto handler_class(const std::string &handler) -> std::string {
+  auto end = handler.find("::*)");
+  if (end == std::string::npos) {
+    return {};
+  }
+
+  // Class name may contain parentheses: "(anonymous namespace)::Client"
+  std::size_t depth = 0;
+  for (auto i = end; i-- > 0;) {
+    if (handler[i] == ')') {
+      ++depth;
+    } else if (handler[i] == '(') {
+      if (depth == 0) {
+        return handler.substr(i + 1, end - i - 1);
+      }
+      --depth;
+    }
+  }
+
+  return {};
+}
+
+auto EventProfiler::GetTypeId() -> ns3::TypeId {
+  static ns3::TypeId tid = ns3::TypeId("profiling::EventProfiler")
+                               .SetParent<ns3::SimulatorImpl>()
+                               .SetGroupName("Core")
+                               .AddConstructor<EventProfiler>();
+  return tid;
+}
+
+EventProfiler::EventProfiler()
+    : _impl{ns3::CreateObject<ns3::DefaultSimulatorImpl>()} {}
+
+auto EventProfiler::install() -> ns3::Ptr<EventProfiler> {
+  auto profiler = ns3::CreateObject<EventProfiler>();
+  ns3::Simulator::SetImplementation(profiler);
+  return profiler;
+}
+
+void EventProfiler::report(const model::Model &model, std::ostream &out,
+                           std::size_t top) const {
+  auto rows = collect_rows(model, _stats);
+  auto sum = total(rows);
+
+  out << fmt::format("Event profile: {} events, {:.3f} s wall\n", sum.events,
+                     std::chrono::duration<double>(sum.wall).count());
+  out << fmt::format("{:>12} {:>7} {:>12}  {:<20} {}\n", "wall, ms", "share",
+                     "events", "node", "source");
+
+  rows.resize(std::min(top, rows.size()));
+  for (const auto &row : rows) {
+    auto share = sum.wall.count() > 0
+                     ? 100.0 * static_cast<double>(row.stats.wall.count()) /
+                           static_cast<double>(sum.wall.count())
+                     : 0.0;
+
+    out << fmt::format(
+        "{:>12.3f} {:>6.2f}% {:>12}  {:<20} {}\n",
+        std::chrono::duration<double, std::milli>(row.stats.wall).count(),
+        share, row.stats.events, row.node, row.source);
+  }
+}
+
+void EventProfiler::write_profile(const model::Model &model,
+                                  const std::string &path) const {
+  auto rows = collect_rows(model, _stats);
+  auto sum = total(rows);
+
+  std::ofstream out{path};
+  out << fmt::format(R"({{"events":{},"wall_ns":{},"sources":[)", sum.events,
+                     sum.wall.count());
+
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    const auto &row = rows[i];
+    out << fmt::format(
+        R"({}{{"node":"{}","source":"{}","events":{},"wall_ns":{}}})",
+        i == 0 ? "" : ",", json::escape(row.node), json::escape(row.source),
+        row.stats.events, row.stats.wall.count());
+  }
+
+  out << "]}\n";
+}
+
+auto EventProfiler::wrap(std::uint32_t context, ns3::EventImpl *event)
+    -> ns3::EventImpl * {
+  return new ProfiledEvent(this, context, event);  // NOLINT
+}
+
+void EventProfiler::record(std::uint32_t context, std::type_index handler,
+                           std::chrono::nanoseconds wall) {
+  auto &stats = _stats[{context, handler}];
+  ++stats.events;
+  stats.wall += wall;
+}
+
+void EventProfiler::DoDispose() {
+  _impl = nullptr;
+  ns3::SimulatorImpl::DoDispose();
+}
+
+void EventProfiler::Destroy() { _impl->Destroy(); }
+
+bool EventProfiler::IsFinished() const { return _impl->IsFinished(); }
+
+void EventProfiler::Stop() { _impl->Stop(); }
+
+void EventProfiler::Stop(const ns3::Time &delay) { _impl->Stop(delay); }
+
+auto EventProfiler::Schedule(const ns3::Time &delay, ns3::EventImpl *event)
+    -> ns3::EventId {
+  return _impl->Schedule(delay, wrap(_impl->GetContext(), event));
+}
+
+void EventProfiler::ScheduleWithContext(std::uint32_t context,
+                                        const ns3::Time &delay,
+                                        ns3::EventImpl *event) {
+  _impl->ScheduleWithContext(context, delay, wrap(context, event));
+}
+
+auto EventProfiler::ScheduleNow(ns3::EventImpl *event) -> ns3::EventId {
+  return _impl->ScheduleNow(wrap(_impl->GetContext(), event));
+}
+
+auto EventProfiler::ScheduleDestroy(ns3::EventImpl *event) -> ns3::EventId {
+  // Destroy events are executed after the run and are not profiled
+  return _impl->ScheduleDestroy(event);
+}
+
+void EventProfiler::Remove(const ns3::EventId &id) { _impl->Remove(id); }
+
+void EventProfiler::Cancel(const ns3::EventId &id) { _impl->Cancel(id); }
+
+bool EventProfiler::IsExpired(const ns3::EventId &id) const {
+  return _impl->IsExpired(id);
+}
+
+void EventProfiler::Run() { _impl->Run(); }
+
+auto EventProfiler::Now() const -> ns3::Time { return _impl->Now(); }
+
+auto EventProfiler::GetDelayLeft(const ns3::EventId &id) const -> ns3::Time {
+  return _impl->GetDelayLeft(id);
+}
+
+auto EventProfiler::GetMaximumSimulationTime() const -> ns3::Time {
+  return _impl->GetMaximumSimulationTime();
+}
+
+void EventProfiler::SetScheduler(ns3::ObjectFactory schedulerFactory) {
+  _impl->SetScheduler(std::move(schedulerFactory));
+}
+
+auto EventProfiler::GetSystemId() const -> std::uint32_t {
+  return _impl->GetSystemId();
+}
+
+auto EventProfiler::GetContext() const -> std::uint32_t {
+  return _impl->GetContext();
+}
+
+auto EventProfiler::GetEventCount() const -> std::uint64_t {
+  return _impl->GetEventCount();
+}
+
+}  // namespace profiling
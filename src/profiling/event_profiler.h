@@ -0,0 +1,128 @@
+#ifndef __EVENT_PROFILER_H_Q4M7ZK2WB8RS__
+#define __EVENT_PROFILER_H_Q4M7ZK2WB8RS__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+
+#include <ns3/event-id.h>
+#include <ns3/event-impl.h>
+#include <ns3/nstime.h>
+#include <ns3/object-factory.h>
+#include <ns3/ptr.h>
+#include <ns3/simulator-impl.h>
+#include <ns3/type-id.h>
+
+namespace model {
+class Model;
+}
+
+namespace profiling {
+
+/**
+ * @brief ns3::SimulatorImpl wrapper that attributes executed events to
+ * their ns-3 context and handler type
+ *
+ * Every scheduled event is wrapped into an event that measures wall time of
+ * the original handler. Collected statistics are mapped back to model names
+ * (node, device, application) on report.
+ */
+class EventProfiler final : public ns3::SimulatorImpl {
+ public:
+  struct Stats {
+    std::uint64_t events = 0;
+    std::chrono::nanoseconds wall{};
+  };
+
+  static auto GetTypeId() -> ns3::TypeId;
+
+  EventProfiler();
+
+  /**
+   * @brief Create profiler and set it as current simulator implementation
+   *
+   * Must be called before any ns3::Simulator function
+   *
+   * @return ns3::Ptr<EventProfiler>
+   */
+  static auto install() -> ns3::Ptr<EventProfiler>;
+
+  /**
+   * @brief Print top-N event sources by wall time
+   *
+   * @param model model used to resolve node, device and application names
+   * @param out
+   * @param top number of rows
+   */
+  void report(const model::Model &model, std::ostream &out,
+              std::size_t top) const;
+
+  /**
+   * @brief Write all collected statistics in JSON format
+   *
+   * @param model model used to resolve names
+   * @param path output file
+   */
+  void write_profile(const model::Model &model, const std::string &path) const;
+
+  void Destroy() override;
+  bool IsFinished() const override;
+  void Stop() override;
+  void Stop(const ns3::Time &delay) override;
+  auto Schedule(const ns3::Time &delay, ns3::EventImpl *event)
+      -> ns3::EventId override;
+  void ScheduleWithContext(std::uint32_t context, const ns3::Time &delay,
+                           ns3::EventImpl *event) override;
+  auto ScheduleNow(ns3::EventImpl *event) -> ns3::EventId override;
+  auto ScheduleDestroy(ns3::EventImpl *event) -> ns3::EventId override;
+  void Remove(const ns3::EventId &id) override;
+  void Cancel(const ns3::EventId &id) override;
+  bool IsExpired(const ns3::EventId &id) const override;
+  void Run() override;
+  auto Now() const -> ns3::Time override;
+  auto GetDelayLeft(const ns3::EventId &id) const -> ns3::Time override;
+  auto GetMaximumSimulationTime() const -> ns3::Time override;
+  void SetScheduler(ns3::ObjectFactory schedulerFactory) override;
+  auto GetSystemId() const -> std::uint32_t override;
+  auto GetContext() const -> std::uint32_t override;
+  auto GetEventCount() const -> std::uint64_t override;
+
+ private:
+  class ProfiledEvent;
+
+  using Key = std::pair<std::uint32_t, std::type_index>;
+
+  struct KeyHash {
+    auto operator()(const Key &key) const noexcept -> std::size_t {
+      return std::hash<std::type_index>{}(key.second) ^ key.first;
+    }
+  };
+
+  void DoDispose() override;
+
+  auto wrap(std::uint32_t context, ns3::EventImpl *event) -> ns3::EventImpl *;
+
+  void record(std::uint32_t context, std::type_index handler,
+              std::chrono::nanoseconds wall);
+
+  ns3::Ptr<ns3::SimulatorImpl> _impl;
+  std::unordered_map<Key, Stats, KeyHash> _stats;
+};
+
+/**
+ * @brief Class of member function called by event handler
+ *
+ * @param handler demangled name of ns3::EventImpl type
+ * @return std::string class name, empty if handler doesn't call member
+ * function
+ */
+auto handler_class(const std::string &handler) -> std::string;
+
+}  // namespace profiling
+
+#endif  // __EVENT_PROFILER_H_Q4M7ZK2WB8RS__
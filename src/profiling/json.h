@@ -0,0 +1,49 @@
+#ifndef __JSON_H_7XKD2LQ9CV4P__
+#define __JSON_H_7XKD2LQ9CV4P__
+
+#include <string>
+#include <string_view>
+
+#include <fmt/core.h>
+
+namespace profiling::json {
+
+/**
+ * @brief Escape string to be placed inside JSON string literal
+ *
+ * @param str
+ * @return std::string
+ */
+inline auto escape(std::string_view str) -> std::string {
+  std::string escaped;
+  escaped.reserve(str.size());
+
+  for (auto symbol : str) {
+    switch (symbol) {
+      case '"':
+        escaped += R"(\")";
+        break;
+      case '\\':
+        escaped += R"(\\)";
+        break;
+      case '\n':
+        escaped += R"(\n)";
+        break;
+      case '\t':
+        escaped += R"(\t)";
+        break;
+      default:
+        if (static_cast<unsigned char>(symbol) < 0x20) {
+          escaped += fmt::format("\\u{:04x}", static_cast<int>(symbol));
+        } else {
+          escaped += symbol;
+        }
+    }
+  }
+
+  return escaped;
+}
+
+}  // namespace profiling::json
+
+#endif  // __JSON_H_7XKD2LQ9CV4P__
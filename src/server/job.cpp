@@ -0,0 +1,114 @@
+#include "job.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fmt/core.h>
+
+#include "cache/output_files.h"
+#include "model/model.h"
+#include "parser/parser.h"
+
+namespace fs = std::filesystem;
+
+namespace server {
+
+namespace {
+/**
+ * @brief Changes working directory and restores previous one on exit
+ *
+ */
+class WorkingDirectory {
+ public:
+  explicit WorkingDirectory(const std::string &path) {
+    if (path.empty()) {
+      return;
+    }
+
+    // NOLINTNEXTLINE
+    _previous = ::open(".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (_previous < 0 || ::chdir(path.c_str()) != 0) {
+      auto error = errno;
+      close();
+      throw std::runtime_error(fmt::format(
+          R"(Can't change directory to "{}": {})", path, std::strerror(error)));
+    }
+  }
+
+  ~WorkingDirectory() {
+    if (_previous >= 0) {
+      [[maybe_unused]] auto result = ::fchdir(_previous);
+    }
+    close();
+  }
+
+  WorkingDirectory(const WorkingDirectory &) = delete;
+  WorkingDirectory &operator=(const WorkingDirectory &) = delete;
+
+ private:
+  void close() noexcept {
+    if (_previous >= 0) {
+      ::close(_previous);
+      _previous = -1;
+    }
+  }
+
+  int _previous = -1;
+};
+
+auto read_model(const Request &request) -> std::string {
+  if (!request.xml.empty()) {
+    return request.xml;
+  }
+
+  std::ifstream in{request.model_path};
+  if (!in) {
+    throw std::runtime_error(
+        fmt::format(R"(Can't read model "{}")", request.model_path));
+  }
+
+  std::stringstream xml;
+  xml << in.rdbuf();
+  return xml.str();
+}
+}  // namespace
+
+auto run_job(const Request &request) -> Response {
+  Response response;
+
+  try {
+    WorkingDirectory directory{request.directory};
+
+    auto description = parser::XmlParser().parse(read_model(request));
+
+    // File systems round modification time down, some of them to seconds
+    auto start = fs::file_time_type::clock::now() - std::chrono::seconds{1};
+    {
+      model::Model model;
+      model.build_from_description(description);
+      model.start();
+    }
+
+    for (const auto &file : cache::written_files(description, start)) {
+      response.outputs.push_back(file.string());
+    }
+  } catch (const std::exception &e) {
+    response.status = 1;
+    response.error = e.what();
+  }
+
+  return response;
+}
+
+}  // namespace server
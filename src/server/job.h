@@ -0,0 +1,24 @@
+#ifndef __JOB_H_F3LP8XN1CU6R__
+#define __JOB_H_F3LP8XN1CU6R__
+
+#include "server/protocol.h"
+
+namespace server {
+
+/**
+ * @brief Parse, build and run model of request in this process
+ *
+ * Working directory is changed to the one of request for the time of job.
+ * Model is reset after run (see model::Model::reset()), so the next job in
+ * the process gets the same output as a new `simulation --xml` process.
+ * Errors of the model are returned in response with status 1.
+ *
+ * @param request
+ * @return Response with files of registrators, pollers and captures
+ * written by the job
+ */
+auto run_job(const Request &request) -> Response;
+
+}  // namespace server
+
+#endif  // __JOB_H_F3LP8XN1CU6R__
@@ -0,0 +1,256 @@
+#include "protocol.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <fmt/core.h>
+
+namespace server {
+
+namespace {
+constexpr auto dir_key = std::string_view{"DIR"};
+constexpr auto model_key = std::string_view{"MODEL"};
+constexpr auto xml_key = std::string_view{"XML"};
+constexpr auto output_key = std::string_view{"OUTPUT"};
+constexpr auto error_key = std::string_view{"ERROR"};
+constexpr auto status_key = std::string_view{"STATUS"};
+
+// Longest line of header or response, paths and error messages fit in it
+constexpr std::size_t max_line = 1 << 16;
+
+void write_all(int fd, std::string_view data) {
+  while (!data.empty()) {
+    // Closed peer is reported as error, not by SIGPIPE
+    auto written = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+    if (written < 0 && errno == ENOTSOCK) {
+      written = ::write(fd, data.data(), data.size());
+    }
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw ProtocolError(
+          fmt::format("Write failed: {}", std::strerror(errno)));
+    }
+    data.remove_prefix(static_cast<std::size_t>(written));
+  }
+}
+
+void write_line(std::string &out, std::string_view key,
+                std::string_view value) {
+  if (value.find('\n') != std::string_view::npos) {
+    throw ProtocolError(
+        fmt::format(R"(Value of "{}" contains line break)", key));
+  }
+  out.append(key).append(" ").append(value).append("\n");
+}
+
+/**
+ * @brief Buffered reader of lines and raw bytes from descriptor
+ *
+ */
+class Reader {
+ public:
+  explicit Reader(int fd) : _fd(fd) {}
+
+  /**
+   * @brief Next line without line break, empty if peer closed connection
+   *
+   */
+  auto line() -> std::optional<std::string> {
+    while (true) {
+      auto end = _buffer.find('\n');
+      if (end != std::string::npos) {
+        auto result = _buffer.substr(0, end);
+        _buffer.erase(0, end + 1);
+        return result;
+      }
+
+      if (_buffer.size() > max_line) {
+        throw ProtocolError("Line is too long");
+      }
+
+      if (!fill()) {
+        if (!_buffer.empty()) {
+          throw ProtocolError("Connection closed in the middle of line");
+        }
+        return {};
+      }
+    }
+  }
+
+  auto bytes(std::size_t size) -> std::string {
+    while (_buffer.size() < size) {
+      if (!fill()) {
+        throw ProtocolError(fmt::format(
+            "Connection closed after {} of {} bytes", _buffer.size(), size));
+      }
+    }
+
+    auto result = _buffer.substr(0, size);
+    _buffer.erase(0, size);
+    return result;
+  }
+
+ private:
+  auto fill() -> bool {
+    constexpr std::size_t chunk = 1 << 16;
+
+    char data[chunk];  // NOLINT
+    while (true) {
+      auto received = ::read(_fd, data, chunk);
+      if (received < 0 && errno == EINTR) {
+        continue;
+      }
+      if (received < 0) {
+        throw ProtocolError(
+            fmt::format("Read failed: {}", std::strerror(errno)));
+      }
+      _buffer.append(data, static_cast<std::size_t>(received));
+      return received != 0;
+    }
+  }
+
+  int _fd;
+  std::string _buffer;
+};
+
+auto split(const std::string &line) -> std::pair<std::string, std::string> {
+  auto space = line.find(' ');
+  if (space == std::string::npos) {
+    return {line, {}};
+  }
+  return {line.substr(0, space), line.substr(space + 1)};
+}
+
+auto parse_number(const std::string &key, const std::string &value)
+    -> long long {
+  std::size_t parsed = 0;
+  try {
+    auto result = std::stoll(value, &parsed);
+    if (parsed == value.size()) {
+      return result;
+    }
+  } catch (const std::exception &) {
+  }
+  throw ProtocolError(fmt::format(R"(Bad number "{}" of "{}")", value, key));
+}
+}  // namespace
+
+auto connect(const std::string &socket_path) -> int {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (socket_path.size() >= sizeof(address.sun_path)) {
+    throw ProtocolError(
+        fmt::format(R"(Socket path "{}" is too long)", socket_path));
+  }
+  std::copy(socket_path.begin(), socket_path.end(), address.sun_path);
+
+  auto fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    throw ProtocolError(
+        fmt::format("Can't create socket: {}", std::strerror(errno)));
+  }
+
+  // NOLINTNEXTLINE
+  if (::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) !=
+      0) {
+    auto error = errno;
+    ::close(fd);
+    throw ProtocolError(fmt::format(R"(Can't connect to "{}": {})",
+                                    socket_path, std::strerror(error)));
+  }
+  return fd;
+}
+
+void write_request(int fd, const Request &request) {
+  std::string out;
+  if (!request.directory.empty()) {
+    write_line(out, dir_key, request.directory);
+  }
+
+  if (request.xml.empty()) {
+    write_line(out, model_key, request.model_path);
+  } else {
+    write_line(out, xml_key, std::to_string(request.xml.size()));
+    out.append(request.xml);
+  }
+
+  write_all(fd, out);
+}
+
+auto read_request(int fd) -> Request {
+  Reader reader{fd};
+  Request request;
+
+  while (auto line = reader.line()) {
+    auto [key, value] = split(*line);
+    if (key == dir_key) {
+      request.directory = std::move(value);
+    } else if (key == model_key) {
+      request.model_path = std::move(value);
+      return request;
+    } else if (key == xml_key) {
+      auto size = parse_number(key, value);
+      if (size <= 0 || static_cast<std::size_t>(size) > max_xml_size) {
+        throw ProtocolError(fmt::format("Bad size {} of inline model", size));
+      }
+      request.xml = reader.bytes(static_cast<std::size_t>(size));
+      return request;
+    } else {
+      throw ProtocolError(fmt::format(R"(Unknown request line "{}")", key));
+    }
+  }
+
+  throw ProtocolError("Connection closed before model");
+}
+
+void write_response(int fd, const Response &response) {
+  std::string out;
+  for (const auto &output : response.outputs) {
+    write_line(out, output_key, output);
+  }
+
+  if (!response.error.empty()) {
+    auto error = response.error;
+    std::replace(error.begin(), error.end(), '\n', ' ');
+    write_line(out, error_key, error);
+  }
+
+  write_line(out, status_key, std::to_string(response.status));
+  write_all(fd, out);
+}
+
+auto read_response(int fd) -> Response {
+  Reader reader{fd};
+  Response response;
+
+  while (auto line = reader.line()) {
+    auto [key, value] = split(*line);
+    if (key == output_key) {
+      response.outputs.push_back(std::move(value));
+    } else if (key == error_key) {
+      response.error = std::move(value);
+    } else if (key == status_key) {
+      response.status = static_cast<int>(parse_number(key, value));
+      return response;
+    } else {
+      throw ProtocolError(fmt::format(R"(Unknown response line "{}")", key));
+    }
+  }
+
+  throw ProtocolError("Connection closed before status, worker has crashed");
+}
+
+}  // namespace server
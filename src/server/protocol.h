@@ -0,0 +1,74 @@
+#ifndef __PROTOCOL_H_W6HZ2QK9VD4N__
+#define __PROTOCOL_H_W6HZ2QK9VD4N__
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace server {
+
+/**
+ * @brief Malformed message or failed socket I/O
+ *
+ */
+class ProtocolError : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Job sent by client, one per connection
+ *
+ * Wire format is text lines:
+ *   DIR <working directory>   optional
+ *   MODEL <path to XML>       or
+ *   XML <size>                followed by <size> bytes of XML
+ */
+struct Request {
+  // Working directory of the job, relative paths of the model and its
+  // outputs are resolved against it. Directory of the server if empty
+  std::string directory;
+  // Path to XML model, used if xml is empty
+  std::string model_path;
+  std::string xml;
+};
+
+/**
+ * @brief Result of job
+ *
+ * Wire format is text lines:
+ *   OUTPUT <path>     for every written file
+ *   ERROR <message>   if job failed
+ *   STATUS <code>     last line
+ */
+struct Response {
+  // 0 on success
+  int status = 0;
+  std::string error;
+  // Absolute paths of statistics and capture files written by the job
+  std::vector<std::string> outputs;
+};
+
+// Inline models are read in memory, larger ones are rejected
+constexpr std::size_t max_xml_size = std::size_t{1} << 30;
+
+/**
+ * @brief Connect to server listening on Unix socket
+ *
+ * @return int descriptor of connected socket, closed by caller
+ * @throws ProtocolError if server is not available
+ */
+auto connect(const std::string &socket_path) -> int;
+
+void write_request(int fd, const Request &request);
+
+auto read_request(int fd) -> Request;
+
+void write_response(int fd, const Response &response);
+
+auto read_response(int fd) -> Response;
+
+}  // namespace server
+
+#endif  // __PROTOCOL_H_W6HZ2QK9VD4N__
@@ -0,0 +1,225 @@
+#include "server.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <fmt/core.h>
+
+#include "server/job.h"
+#include "server/protocol.h"
+
+namespace server {
+
+namespace {
+// Workers check for stop request at least this often while idle
+constexpr auto poll_interval_ms = 500;
+
+// Client stalled in sending request or reading response releases worker
+constexpr auto io_timeout_s = 30;
+
+volatile std::sig_atomic_t stop_requested = 0;  // NOLINT
+
+void request_stop(int /*sig*/) { stop_requested = 1; }
+
+// Blocking calls are interrupted by signals instead of being restarted
+void install_stop_handlers() {
+  struct sigaction action {};
+  action.sa_handler = request_stop;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = 0;
+  sigaction(SIGTERM, &action, nullptr);
+  sigaction(SIGINT, &action, nullptr);
+}
+
+auto describe_exit(int status) -> std::string {
+  if (WIFSIGNALED(status)) {
+    return fmt::format("killed by signal {}", WTERMSIG(status));
+  }
+  return fmt::format("exited with status {}", WEXITSTATUS(status));
+}
+}  // namespace
+
+Server::Server(std::string socket_path, std::size_t workers)
+    : _socket_path(std::move(socket_path)),
+      _workers(workers != 0
+                   ? workers
+                   : std::max(1U, std::thread::hardware_concurrency())) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (_socket_path.size() >= sizeof(address.sun_path)) {
+    throw ServerError(
+        fmt::format(R"(Socket path "{}" is too long)", _socket_path));
+  }
+  std::copy(_socket_path.begin(), _socket_path.end(), address.sun_path);
+
+  // Socket of the previous server is replaced, other files are not touched
+  struct stat info {};
+  if (::stat(_socket_path.c_str(), &info) == 0) {
+    if (!S_ISSOCK(info.st_mode)) {
+      throw ServerError(
+          fmt::format(R"("{}" exists and is not a socket)", _socket_path));
+    }
+    ::unlink(_socket_path.c_str());
+  }
+
+  // Non-blocking: all idle workers wake on connection, only one accepts it
+  _listen_fd =
+      ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+  if (_listen_fd < 0) {
+    throw ServerError(
+        fmt::format("Can't create socket: {}", std::strerror(errno)));
+  }
+
+  // NOLINTNEXTLINE
+  if (::bind(_listen_fd, reinterpret_cast<sockaddr *>(&address),
+             sizeof(address)) != 0 ||
+      ::listen(_listen_fd, SOMAXCONN) != 0) {
+    auto error = errno;
+    ::close(_listen_fd);
+    throw ServerError(fmt::format(R"(Can't listen on "{}": {})", _socket_path,
+                                  std::strerror(error)));
+  }
+}
+
+Server::~Server() {
+  if (_listen_fd >= 0) {
+    ::close(_listen_fd);
+    ::unlink(_socket_path.c_str());
+  }
+}
+
+void Server::run() {
+  install_stop_handlers();
+
+  for (std::size_t i = 0; i < _workers; ++i) {
+    _pids.push_back(spawn_worker());
+  }
+  std::cout << fmt::format("Serving on {} with {} workers\n", _socket_path,
+                           _workers)
+            << std::flush;
+
+  while (stop_requested == 0) {
+    int status = 0;
+    auto pid = ::waitpid(-1, &status, 0);
+    if (pid < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw ServerError(
+          fmt::format("Waiting for workers failed: {}", std::strerror(errno)));
+    }
+
+    auto worker = std::find(_pids.begin(), _pids.end(), pid);
+    if (worker == _pids.end()) {
+      continue;
+    }
+
+    auto failed = !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    if (failed) {
+      std::cerr << fmt::format("Worker {} {}\n", pid, describe_exit(status));
+    }
+
+    if (stop_requested != 0) {
+      _pids.erase(worker);
+      break;
+    }
+
+    // Don't spin when workers fail right after start
+    if (failed) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    }
+    *worker = spawn_worker();
+  }
+
+  stop_workers();
+}
+
+auto Server::spawn_worker() -> pid_t {
+  // Buffered output would be written by both processes
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+
+  auto pid = ::fork();
+  if (pid < 0) {
+    throw ServerError(
+        fmt::format("Can't start worker: {}", std::strerror(errno)));
+  }
+
+  if (pid == 0) {
+    serve();
+  }
+  return pid;
+}
+
+void Server::serve() {
+  std::size_t jobs = 0;
+  while (jobs < jobs_per_worker && stop_requested == 0) {
+    pollfd listening{.fd = _listen_fd, .events = POLLIN, .revents = 0};
+    if (::poll(&listening, 1, poll_interval_ms) <= 0) {
+      continue;
+    }
+
+    auto fd = ::accept4(_listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ||
+          errno == ECONNABORTED) {
+        continue;
+      }
+      std::cerr << fmt::format("Worker {}: accept failed: {}\n", ::getpid(),
+                               std::strerror(errno));
+      std::cerr.flush();
+      ::_exit(1);
+    }
+
+    timeval timeout{.tv_sec = io_timeout_s, .tv_usec = 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    ++jobs;
+    try {
+      auto request = read_request(fd);
+      write_response(fd, run_job(request));
+    } catch (const ProtocolError &e) {
+      std::cerr << fmt::format("Worker {}: {}\n", ::getpid(), e.what());
+    }
+    ::close(fd);
+  }
+
+  // Exit handlers and destructors belong to the server process
+  std::cout.flush();
+  std::cerr.flush();
+  ::_exit(0);
+}
+
+void Server::stop_workers() {
+  // Workers finish running job and exit on the next check of stop request
+  for (auto pid : _pids) {
+    ::kill(pid, SIGTERM);
+  }
+
+  for (auto pid : _pids) {
+    int status = 0;
+    while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+  }
+  _pids.clear();
+}
+
+}  // namespace server
@@ -0,0 +1,73 @@
+#ifndef __SERVER_H_K2RM7YB5JS0E__
+#define __SERVER_H_K2RM7YB5JS0E__
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace server {
+
+class ServerError : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Pool of worker processes running models sent over Unix socket
+ *
+ * Workers are forked from the server after ns-3 libraries are loaded and
+ * type information is registered, so jobs don't pay process startup. Every
+ * worker accepts connections on the shared listening socket and runs one
+ * job per connection (see run_job()), the kernel hands each connection to
+ * an idle worker. Workers exiting on crash or after jobs_per_worker jobs
+ * are replaced.
+ */
+class Server {
+ public:
+  // Worker is replaced after this number of jobs to return memory kept by
+  // allocator and ns-3 after model reset
+  static constexpr std::size_t jobs_per_worker = 1000;
+
+  /**
+   * @brief Listen on socket, existing socket file is replaced
+   *
+   * @param socket_path path of Unix domain socket
+   * @param workers number of worker processes, CPU count if 0
+   * @throws ServerError if socket can't be created
+   */
+  Server(std::string socket_path, std::size_t workers);
+
+  ~Server();
+
+  Server(const Server &) = delete;
+  Server &operator=(const Server &) = delete;
+
+  /**
+   * @brief Start workers and keep their number until SIGTERM or SIGINT
+   *
+   */
+  void run();
+
+ private:
+  auto spawn_worker() -> pid_t;
+
+  /**
+   * @brief Loop of worker process, never returns
+   *
+   */
+  [[noreturn]] void serve();
+
+  void stop_workers();
+
+  std::string _socket_path;
+  std::size_t _workers;
+  int _listen_fd = -1;
+  std::vector<pid_t> _pids;
+};
+
+}  // namespace server
+
+#endif  // __SERVER_H_K2RM7YB5JS0E__
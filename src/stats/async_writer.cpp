@@ -0,0 +1,202 @@
+#include "async_writer.h"
+
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <utility>
+
+#include "stats/spsc_ring.h"
+
+namespace stats {
+
+namespace {
+constexpr auto idle_sleep = std::chrono::microseconds{50};
+
+// Rows drained from one queue before switching to the next one
+constexpr std::size_t batch_rows = 1024;
+
+// Row is stored as time followed by values, bit-copied into queue words
+using Word = std::uint64_t;
+
+static_assert(sizeof(double) == sizeof(Word));
+static_assert(sizeof(std::int64_t) == sizeof(Word));
+}  // namespace
+
+/**
+ * @brief Queue and writer owned by the background thread
+ *
+ */
+class AsyncPipeline::Channel {
+ public:
+  Channel(std::unique_ptr<Writer> writer, std::size_t queue_size)
+      : writer{std::move(writer)},
+        stride{1 + this->writer->columns().size()},
+        ring{queue_size * stride},
+        batch(batch_rows * stride),
+        values(stride - 1) {}
+
+  std::unique_ptr<Writer> writer;
+  std::size_t stride;
+  SpscRing<Word> ring;
+
+  // Set by producer, reset by the background thread once writer is flushed
+  std::atomic<bool> flush_requested{false};
+
+  // Set after output error, rows of failed channel are discarded
+  bool failed = false;
+
+  // Buffers of the background thread
+  std::vector<Word> batch;
+  std::vector<double> values;
+};
+
+/**
+ * @brief Front-end writer pushing rows to the channel queue
+ *
+ */
+class AsyncPipeline::QueueWriter final : public Writer {
+ public:
+  QueueWriter(AsyncPipeline &pipeline, std::shared_ptr<Channel> channel)
+      : Writer{channel->writer->columns()},
+        _pipeline{pipeline},
+        _channel{std::move(channel)},
+        _record(_channel->stride) {}
+
+  void write(std::int64_t time, const double *values) override {
+    std::memcpy(_record.data(), &time, sizeof(Word));
+    std::memcpy(_record.data() + 1, values,
+                (_record.size() - 1) * sizeof(Word));
+
+    while (!_channel->ring.try_push(_record.data(), _record.size())) {
+      if (_pipeline._policy == overflow_policy::drop ||
+          _pipeline._stopping.load(std::memory_order_relaxed)) {
+        _pipeline._dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  void flush() override {
+    _channel->flush_requested.store(true, std::memory_order_release);
+
+    while (_channel->flush_requested.load(std::memory_order_acquire) &&
+           !_pipeline._stopping.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+  }
+
+ private:
+  AsyncPipeline &_pipeline;
+  std::shared_ptr<Channel> _channel;
+  std::vector<Word> _record;
+};
+
+AsyncPipeline::AsyncPipeline(std::size_t queue_size, overflow_policy policy)
+    : _queue_size{queue_size == 0 ? default_queue_size : queue_size},
+      _policy{policy},
+      _thread{[this] { run(); }} {}
+
+AsyncPipeline::~AsyncPipeline() { stop(); }
+
+auto AsyncPipeline::attach(std::unique_ptr<Writer> writer)
+    -> std::unique_ptr<Writer> {
+  auto channel = std::make_shared<Channel>(std::move(writer), _queue_size);
+
+  {
+    std::lock_guard lock{_mutex};
+    _channels.push_back(channel);
+  }
+
+  return std::make_unique<QueueWriter>(*this, std::move(channel));
+}
+
+void AsyncPipeline::stop() {
+  if (!_thread.joinable()) {
+    return;
+  }
+
+  _stopping.store(true, std::memory_order_release);
+  _thread.join();
+}
+
+void AsyncPipeline::run() {
+  std::vector<std::shared_ptr<Channel>> channels;
+
+  while (true) {
+    // Rows pushed before stop() are visible to the drain below
+    auto stopping = _stopping.load(std::memory_order_acquire);
+
+    {
+      std::lock_guard lock{_mutex};
+      if (channels.size() != _channels.size()) {
+        channels = _channels;
+      }
+    }
+
+    bool idle = true;
+    for (auto &channel : channels) {
+      auto flush = channel->flush_requested.load(std::memory_order_acquire);
+
+      while (drain(*channel)) {
+        idle = false;
+        if (!flush && !stopping) {
+          break;
+        }
+      }
+
+      if (flush || stopping) {
+        if (!channel->failed) {
+          try {
+            channel->writer->flush();
+          } catch (const std::exception &error) {
+            std::cerr << "Error: " << error.what() << '\n';
+            channel->failed = true;
+          }
+        }
+        channel->flush_requested.store(false, std::memory_order_release);
+      }
+    }
+
+    if (stopping) {
+      break;
+    }
+
+    if (idle) {
+      std::this_thread::sleep_for(idle_sleep);
+    }
+  }
+}
+
+bool AsyncPipeline::drain(Channel &channel) {
+  auto words =
+      channel.ring.try_pop(channel.batch.data(), channel.batch.size());
+  if (words == 0) {
+    return false;
+  }
+
+  if (channel.failed) {
+    return true;
+  }
+
+  try {
+    for (std::size_t offset = 0; offset < words; offset += channel.stride) {
+      const auto *record = channel.batch.data() + offset;
+
+      std::int64_t time = 0;
+      std::memcpy(&time, record, sizeof(Word));
+      std::memcpy(channel.values.data(), record + 1,
+                  channel.values.size() * sizeof(Word));
+
+      channel.writer->write(time, channel.values.data());
+    }
+  } catch (const std::exception &error) {
+    std::cerr << "Error: " << error.what() << '\n';
+    channel.failed = true;
+  }
+
+  return true;
+}
+
+}  // namespace stats
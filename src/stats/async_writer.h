@@ -0,0 +1,86 @@
+#ifndef __ASYNC_WRITER_H_T5W9BN2QKR7E__
+#define __ASYNC_WRITER_H_T5W9BN2QKR7E__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "stats/writer.h"
+
+namespace stats {
+
+/**
+ * @brief Moves statistics output to the background thread
+ *
+ * Every attached writer gets its own lock-free SPSC queue filled by the
+ * simulation thread. The background thread drains all queues and passes
+ * rows to the writers, so formatting and file I/O are done off the
+ * simulation thread.
+ */
+class AsyncPipeline {
+ public:
+  static constexpr std::size_t default_queue_size = 1 << 16;
+
+  /**
+   * @brief Start background thread
+   *
+   * @param queue_size capacity of each queue in rows
+   * @param policy behaviour on full queue
+   */
+  explicit AsyncPipeline(std::size_t queue_size = default_queue_size,
+                         overflow_policy policy = overflow_policy::block);
+
+  ~AsyncPipeline();
+
+  AsyncPipeline(const AsyncPipeline &) = delete;
+  AsyncPipeline &operator=(const AsyncPipeline &) = delete;
+
+  /**
+   * @brief Move writer to the background thread
+   *
+   * @param writer
+   * @return std::unique_ptr<Writer> writer pushing rows to the queue, must be
+   * used from one thread only
+   */
+  auto attach(std::unique_ptr<Writer> writer) -> std::unique_ptr<Writer>;
+
+  /**
+   * @brief Write all queued rows, flush writers and stop background thread
+   *
+   */
+  void stop();
+
+  /**
+   * @brief Number of rows dropped because of full queue
+   *
+   */
+  auto dropped() const noexcept -> std::uint64_t {
+    return _dropped.load(std::memory_order_relaxed);
+  }
+
+ private:
+  class Channel;
+  class QueueWriter;
+
+  void run();
+
+  static bool drain(Channel &channel);
+
+  std::size_t _queue_size;
+  overflow_policy _policy;
+
+  std::mutex _mutex;
+  std::vector<std::shared_ptr<Channel>> _channels;
+
+  std::atomic<bool> _stopping{false};
+  std::atomic<std::uint64_t> _dropped{0};
+  std::thread _thread;
+};
+
+}  // namespace stats
+
+#endif  // __ASYNC_WRITER_H_T5W9BN2QKR7E__
@@ -0,0 +1,32 @@
+#ifndef __BINARY_FORMAT_H_P5H0DW7NQK2M__
+#define __BINARY_FORMAT_H_P5H0DW7NQK2M__
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief Layout of binary columnar statistics file
+ *
+ * All numbers are stored in native (little-endian) byte order.
+ *
+ * Header:
+ *   char[8]   magic "SIMSTATS"
+ *   uint32    version
+ *   uint32    number of value columns N
+ *   double    seconds per time step
+ *   N times:  uint16 length, char[length] column name
+ *
+ * Followed by blocks until end of file:
+ *   uint32    number of rows R
+ *   int64[R]  time in time steps
+ *   N times:  double[R] column values
+ */
+namespace stats::binary_format {
+
+constexpr std::array<char, 8> magic = {'S', 'I', 'M', 'S', 'T', 'A', 'T', 'S'};
+
+constexpr std::uint32_t version = 1;
+
+}  // namespace stats::binary_format
+
+#endif  // __BINARY_FORMAT_H_P5H0DW7NQK2M__
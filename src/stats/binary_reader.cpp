@@ -0,0 +1,73 @@
+#include "binary_reader.h"
+
+#include <array>
+#include <utility>
+
+#include <fmt/core.h>
+
+#include "stats/binary_format.h"
+#include "stats/writer.h"
+
+namespace stats {
+
+BinaryReader::BinaryReader(const std::string &path)
+    : _in{path, std::ios::binary} {
+  if (!_in) {
+    throw OutputError(fmt::format(R"(Can't open file "{}")", path));
+  }
+
+  std::array<char, binary_format::magic.size()> magic{};
+  read(magic.data(), magic.size());
+  if (magic != binary_format::magic) {
+    throw OutputError(fmt::format(R"("{}" is not statistics file)", path));
+  }
+
+  if (auto version = read_value<std::uint32_t>();
+      version != binary_format::version) {
+    throw OutputError(fmt::format(R"(Unsupported version {} of "{}")",
+                                  version, path));
+  }
+
+  auto columns_count = read_value<std::uint32_t>();
+  _seconds_per_step = read_value<double>();
+
+  for (std::uint32_t i = 0; i < columns_count; ++i) {
+    std::string name(read_value<std::uint16_t>(), '\0');
+    read(name.data(), name.size());
+    _columns.push_back(std::move(name));
+  }
+}
+
+bool BinaryReader::next(Block &block) {
+  std::uint32_t rows = 0;
+  if (!_in.read(reinterpret_cast<char *>(&rows), sizeof(rows))) {  // NOLINT
+    return false;
+  }
+
+  block.times.resize(rows);
+  read(block.times.data(), rows * sizeof(std::int64_t));
+
+  block.values.resize(_columns.size());
+  for (auto &column : block.values) {
+    column.resize(rows);
+    read(column.data(), rows * sizeof(double));
+  }
+
+  return true;
+}
+
+template <typename T>
+T BinaryReader::read_value() {
+  T value{};
+  read(&value, sizeof(value));
+  return value;
+}
+
+void BinaryReader::read(void *data, std::size_t size) {
+  if (!_in.read(static_cast<char *>(data),
+                static_cast<std::streamsize>(size))) {
+    throw OutputError("Unexpected end of statistics file");
+  }
+}
+
+}  // namespace stats
@@ -0,0 +1,55 @@
+#ifndef __BINARY_READER_H_Z9J4GT2CPX6W__
+#define __BINARY_READER_H_Z9J4GT2CPX6W__
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace stats {
+
+/**
+ * @brief Reader of binary columnar statistics file
+ *
+ */
+class BinaryReader {
+ public:
+  struct Block {
+    std::vector<std::int64_t> times;
+    std::vector<std::vector<double>> values;
+  };
+
+  /**
+   * @brief Open file and read header
+   *
+   * @param path
+   * @throws OutputError if file can't be read or has bad format
+   */
+  explicit BinaryReader(const std::string &path);
+
+  auto columns() const -> const std::vector<std::string> & { return _columns; }
+
+  auto seconds_per_step() const -> double { return _seconds_per_step; }
+
+  /**
+   * @brief Read next block of rows
+   *
+   * @param block
+   * @return false if there are no more blocks
+   */
+  bool next(Block &block);
+
+ private:
+  template <typename T>
+  T read_value();
+
+  void read(void *data, std::size_t size);
+
+  std::ifstream _in;
+  std::vector<std::string> _columns;
+  double _seconds_per_step = 0;
+};
+
+}  // namespace stats
+
+#endif  // __BINARY_READER_H_Z9J4GT2CPX6W__
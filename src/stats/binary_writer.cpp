@@ -0,0 +1,72 @@
+#include "binary_writer.h"
+
+#include <utility>
+
+#include "stats/binary_format.h"
+
+namespace stats {
+
+BinaryWriter::BinaryWriter(const std::string &path,
+                           std::vector<std::string> columns,
+                           double seconds_per_step, std::size_t block_rows,
+                           compression method)
+    : Writer{std::move(columns)},
+      _file{path, method},
+      _block_rows{block_rows},
+      _values(this->columns().size()) {
+  _times.reserve(_block_rows);
+  for (auto &column : _values) {
+    column.reserve(_block_rows);
+  }
+
+  _file.write(binary_format::magic.data(), binary_format::magic.size());
+  _file.write_value(binary_format::version);
+  _file.write_value(static_cast<std::uint32_t>(this->columns().size()));
+  _file.write_value(seconds_per_step);
+
+  for (const auto &name : this->columns()) {
+    _file.write_value(static_cast<std::uint16_t>(name.size()));
+    _file.write(name.data(), name.size());
+  }
+}
+
+BinaryWriter::~BinaryWriter() {
+  try {
+    write_block();
+  } catch (OutputError &) {
+    // Destructor can't report error
+  }
+}
+
+void BinaryWriter::write(std::int64_t time, const double *values) {
+  _times.push_back(time);
+  for (std::size_t i = 0; i < _values.size(); ++i) {
+    _values[i].push_back(values[i]);
+  }
+
+  if (_times.size() == _block_rows) {
+    write_block();
+  }
+}
+
+void BinaryWriter::flush() {
+  write_block();
+  _file.flush();
+}
+
+void BinaryWriter::write_block() {
+  if (_times.empty()) {
+    return;
+  }
+
+  _file.write_value(static_cast<std::uint32_t>(_times.size()));
+  _file.write(_times.data(), _times.size() * sizeof(std::int64_t));
+  _times.clear();
+
+  for (auto &column : _values) {
+    _file.write(column.data(), column.size() * sizeof(double));
+    column.clear();
+  }
+}
+
+}  // namespace stats
@@ -0,0 +1,47 @@
+#ifndef __BINARY_WRITER_H_U7B3MS9ELF1C__
+#define __BINARY_WRITER_H_U7B3MS9ELF1C__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "stats/buffered_file.h"
+#include "stats/compression.h"
+#include "stats/writer.h"
+
+namespace stats {
+
+/**
+ * @brief Writes rows as fixed-width binary columns
+ *
+ * Rows are collected into blocks of `block_rows` rows, every block is stored
+ * column by column (see binary_format.h).
+ */
+class BinaryWriter final : public Writer {
+ public:
+  static constexpr std::size_t default_block_rows = 8192;
+
+  BinaryWriter(const std::string &path, std::vector<std::string> columns,
+               double seconds_per_step,
+               std::size_t block_rows = default_block_rows,
+               compression method = compression::none);
+
+  ~BinaryWriter() override;
+
+  void write(std::int64_t time, const double *values) override;
+
+  void flush() override;
+
+ private:
+  void write_block();
+
+  BufferedFile _file;
+  std::size_t _block_rows;
+  std::vector<std::int64_t> _times;
+  std::vector<std::vector<double>> _values;
+};
+
+}  // namespace stats
+
+#endif  // __BINARY_WRITER_H_U7B3MS9ELF1C__
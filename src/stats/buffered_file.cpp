@@ -0,0 +1,95 @@
+#include "buffered_file.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fmt/core.h>
+
+#include "stats/writer.h"
+
+namespace stats {
+
+BufferedFile::BufferedFile(const std::string &path, compression method,
+                           std::size_t buffer_size)
+    : _path{path}, _buffer(buffer_size), _compressor{make_compressor(method)} {
+  // NOLINTNEXTLINE
+  _fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (_fd < 0) {
+    throw OutputError(fmt::format(R"(Can't open file "{}": {})", path,
+                                  std::strerror(errno)));
+  }
+}
+
+BufferedFile::~BufferedFile() {
+  try {
+    auto used = _used;
+    _used = 0;
+    write_out(_buffer.data(), used, Compressor::mode::finish);
+  } catch (OutputError &) {
+    // Destructor can't report error
+  }
+  ::close(_fd);
+}
+
+void BufferedFile::write(const void *data, std::size_t size) {
+  const auto *bytes = static_cast<const char *>(data);
+
+  if (_used + size > _buffer.size()) {
+    auto used = _used;
+    _used = 0;
+    write_out(_buffer.data(), used, Compressor::mode::proceed);
+
+    // Large chunks bypass the buffer
+    if (size >= _buffer.size()) {
+      write_out(bytes, size, Compressor::mode::proceed);
+      return;
+    }
+  }
+
+  std::memcpy(_buffer.data() + _used, bytes, size);
+  _used += size;
+}
+
+void BufferedFile::flush() {
+  // Compressor may hold data of the chunks bypassed the buffer
+  if (_used == 0 && _compressor == nullptr) {
+    return;
+  }
+
+  auto used = _used;
+  _used = 0;
+  write_out(_buffer.data(), used, Compressor::mode::flush);
+}
+
+void BufferedFile::write_out(const char *data, std::size_t size,
+                             Compressor::mode mode) {
+  if (_compressor != nullptr) {
+    _compressed.clear();
+    _compressor->compress(data, size, mode, _compressed);
+    write_fully(_compressed.data(), _compressed.size());
+  } else {
+    write_fully(data, size);
+  }
+  _written += size;
+}
+
+void BufferedFile::write_fully(const char *data, std::size_t size) {
+  while (size > 0) {
+    auto written = ::write(_fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw OutputError(fmt::format(R"(Failed write to "{}": {})", _path,
+                                    std::strerror(errno)));
+    }
+
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+}
+
+}  // namespace stats
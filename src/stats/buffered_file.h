@@ -0,0 +1,79 @@
+#ifndef __BUFFERED_FILE_H_F1N6YQ3WXA8D__
+#define __BUFFERED_FILE_H_F1N6YQ3WXA8D__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "stats/compression.h"
+
+namespace stats {
+
+/**
+ * @brief Output file written with large sequential writes
+ *
+ * Compressed files are valid gzip/zstd streams, data written before each
+ * flush() can be decompressed while the file is still written.
+ */
+class BufferedFile {
+ public:
+  static constexpr std::size_t default_buffer_size = 1 << 20;
+
+  /**
+   * @brief Create (truncate) file
+   *
+   * @param path
+   * @param method compression of the whole file
+   * @param buffer_size
+   * @throws OutputError if file can't be opened
+   */
+  explicit BufferedFile(const std::string &path,
+                        compression method = compression::none,
+                        std::size_t buffer_size = default_buffer_size);
+  ~BufferedFile();
+
+  BufferedFile(const BufferedFile &) = delete;
+  BufferedFile &operator=(const BufferedFile &) = delete;
+
+  void write(const void *data, std::size_t size);
+
+  template <typename T>
+  void write_value(const T &value) {
+    write(&value, sizeof(value));
+  }
+
+  /**
+   * @brief Write buffered data to the file
+   *
+   * @throws OutputError on write error
+   */
+  void flush();
+
+  auto path() const -> const std::string & { return _path; }
+
+  /**
+   * @brief Position of the next written byte from the beginning of the file,
+   * uncompressed
+   *
+   */
+  auto offset() const noexcept -> std::uint64_t { return _written + _used; }
+
+ private:
+  void write_out(const char *data, std::size_t size, Compressor::mode mode);
+
+  void write_fully(const char *data, std::size_t size);
+
+  std::string _path;
+  int _fd = -1;
+  std::vector<char> _buffer;
+  std::size_t _used = 0;
+  std::uint64_t _written = 0;
+  std::unique_ptr<Compressor> _compressor;
+  std::vector<char> _compressed;
+};
+
+}  // namespace stats
+
+#endif  // __BUFFERED_FILE_H_F1N6YQ3WXA8D__
@@ -0,0 +1,160 @@
+#include "compression.h"
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+#include <fmt/core.h>
+#include <zlib.h>
+#include <zstd.h>
+
+#include "stats/writer.h"
+
+namespace stats {
+
+namespace {
+constexpr std::size_t chunk_size = 1 << 16;
+
+class GzipCompressor final : public Compressor {
+ public:
+  GzipCompressor() {
+    // 16 added to window bits selects gzip header instead of zlib one
+    constexpr int gzip_window_bits = 15 + 16;
+    constexpr int memory_level = 8;
+
+    if (deflateInit2(&_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                     gzip_window_bits, memory_level,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+      throw OutputError("Can't initialize gzip compression");
+    }
+  }
+
+  ~GzipCompressor() override { deflateEnd(&_stream); }
+
+  GzipCompressor(const GzipCompressor &) = delete;
+  GzipCompressor &operator=(const GzipCompressor &) = delete;
+
+  void compress(const char *data, std::size_t size, mode mode,
+                std::vector<char> &out) override {
+    int flush = Z_NO_FLUSH;
+    if (mode == mode::flush) {
+      flush = Z_SYNC_FLUSH;
+    } else if (mode == mode::finish) {
+      flush = Z_FINISH;
+    }
+
+    // NOLINTNEXTLINE
+    _stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    _stream.avail_in = static_cast<uInt>(size);
+
+    do {
+      auto used = out.size();
+      out.resize(used + chunk_size);
+
+      // NOLINTNEXTLINE
+      _stream.next_out = reinterpret_cast<Bytef *>(out.data() + used);
+      _stream.avail_out = chunk_size;
+
+      auto result = deflate(&_stream, flush);
+      if (result == Z_STREAM_ERROR) {
+        throw OutputError("gzip compression failed");
+      }
+
+      out.resize(used + chunk_size - _stream.avail_out);
+    } while (_stream.avail_out == 0);
+  }
+
+ private:
+  z_stream _stream{};
+};
+
+class ZstdCompressor final : public Compressor {
+ public:
+  ZstdCompressor() : _context{ZSTD_createCCtx()} {
+    constexpr int level = 3;
+
+    if (_context == nullptr ||
+        ZSTD_isError(ZSTD_CCtx_setParameter(
+            _context, ZSTD_c_compressionLevel, level))) {
+      ZSTD_freeCCtx(_context);
+      throw OutputError("Can't initialize zstd compression");
+    }
+  }
+
+  ~ZstdCompressor() override { ZSTD_freeCCtx(_context); }
+
+  ZstdCompressor(const ZstdCompressor &) = delete;
+  ZstdCompressor &operator=(const ZstdCompressor &) = delete;
+
+  void compress(const char *data, std::size_t size, mode mode,
+                std::vector<char> &out) override {
+    auto directive = ZSTD_e_continue;
+    if (mode == mode::flush) {
+      directive = ZSTD_e_flush;
+    } else if (mode == mode::finish) {
+      directive = ZSTD_e_end;
+    }
+
+    ZSTD_inBuffer input{data, size, 0};
+
+    std::size_t remaining = 0;
+    do {
+      auto used = out.size();
+      out.resize(used + chunk_size);
+
+      ZSTD_outBuffer output{out.data() + used, chunk_size, 0};
+      remaining = ZSTD_compressStream2(_context, &output, &input, directive);
+      if (ZSTD_isError(remaining)) {
+        throw OutputError(fmt::format("zstd compression failed: {}",
+                                      ZSTD_getErrorName(remaining)));
+      }
+
+      out.resize(used + output.pos);
+    } while (directive == ZSTD_e_continue ? input.pos < input.size
+                                          : remaining != 0);
+  }
+
+ private:
+  ZSTD_CCtx *_context;
+};
+}  // namespace
+
+auto compression_from_string(const std::string &str) noexcept
+    -> std::optional<compression> {
+  auto method = boost::algorithm::to_lower_copy(str);
+  if (method == "none") {
+    return compression::none;
+  }
+
+  if (method == "gzip") {
+    return compression::gzip;
+  }
+
+  if (method == "zstd") {
+    return compression::zstd;
+  }
+
+  return {};
+}
+
+auto compressed_extension(compression method) noexcept -> const char * {
+  switch (method) {
+    case compression::gzip:
+      return ".gz";
+    case compression::zstd:
+      return ".zst";
+    default:
+      return "";
+  }
+}
+
+auto make_compressor(compression method) -> std::unique_ptr<Compressor> {
+  switch (method) {
+    case compression::gzip:
+      return std::make_unique<GzipCompressor>();
+    case compression::zstd:
+      return std::make_unique<ZstdCompressor>();
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace stats
@@ -0,0 +1,62 @@
+#ifndef __COMPRESSION_H_L8W3QF6CZN1H__
+#define __COMPRESSION_H_L8W3QF6CZN1H__
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace stats {
+
+enum class compression { none, gzip, zstd };
+
+auto compression_from_string(const std::string &str) noexcept
+    -> std::optional<compression>;
+
+/**
+ * @brief Extension of compressed file: ".gz", ".zst" or empty
+ *
+ */
+auto compressed_extension(compression method) noexcept -> const char *;
+
+/**
+ * @brief Streaming compressor producing standard gzip or zstd frames
+ *
+ */
+class Compressor {
+ public:
+  enum class mode {
+    // Compressor may keep data until more input
+    proceed,
+    // Output everything compressed so far, so it can be decompressed
+    flush,
+    // Finish the stream
+    finish
+  };
+
+  virtual ~Compressor() = default;
+
+  /**
+   * @brief Compress data
+   *
+   * @param data
+   * @param size
+   * @param mode
+   * @param out compressed data is appended to
+   * @throws OutputError on compression error
+   */
+  virtual void compress(const char *data, std::size_t size, mode mode,
+                        std::vector<char> &out) = 0;
+};
+
+/**
+ * @brief Create compressor
+ *
+ * @return std::unique_ptr<Compressor> null for compression::none
+ */
+auto make_compressor(compression method) -> std::unique_ptr<Compressor>;
+
+}  // namespace stats
+
+#endif  // __COMPRESSION_H_L8W3QF6CZN1H__
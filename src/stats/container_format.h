@@ -0,0 +1,65 @@
+#ifndef __CONTAINER_FORMAT_H_V0L7HS3NBQ5T__
+#define __CONTAINER_FORMAT_H_V0L7HS3NBQ5T__
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief Layout of container file with many statistics streams
+ *
+ * All numbers are stored in native (little-endian) byte order, strings are
+ * stored as uint16 length followed by characters.
+ *
+ * Header:
+ *   char[8]   magic "SIMCONTR"
+ *   uint32    version
+ *   double    seconds per time step
+ *
+ * Records, appended as streams are opened and blocks are filled:
+ *   uint32    length of the record after this field
+ *   uint8     record type
+ *   uint32    stream id
+ *   stream record:
+ *     string    stream name
+ *     uint32    number of value columns N
+ *     N times:  string column name
+ *   block record:
+ *     uint32    number of rows R
+ *     int64[R]  time in time steps
+ *     N times:  double[R] column values
+ *
+ * Index, written on close:
+ *   uint32    number of streams S
+ *   S times:
+ *     uint32    stream id
+ *     string    stream name
+ *     uint32    number of value columns N
+ *     N times:  string column name
+ *     uint32    number of blocks B
+ *     B times:  uint64 offset of block record, uint32 number of rows
+ *
+ * Trailer:
+ *   uint64    offset of index
+ *   char[8]   magic "SIMINDEX"
+ *
+ * File without trailer (interrupted run) can be read by scanning records.
+ */
+namespace stats::container_format {
+
+constexpr std::array<char, 8> magic = {'S', 'I', 'M', 'C', 'O', 'N', 'T', 'R'};
+
+constexpr std::array<char, 8> index_magic = {'S', 'I', 'M', 'I',
+                                             'N', 'D', 'E', 'X'};
+
+constexpr std::uint32_t version = 1;
+
+enum class record_type : std::uint8_t { stream = 1, block = 2 };
+
+// Size of record fields before the payload: length, type and stream id
+constexpr std::uint32_t record_header_size = 4 + 1 + 4;
+
+constexpr std::uint32_t trailer_size = 8 + index_magic.size();
+
+}  // namespace stats::container_format
+
+#endif  // __CONTAINER_FORMAT_H_V0L7HS3NBQ5T__
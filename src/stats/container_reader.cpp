@@ -0,0 +1,194 @@
+#include "container_reader.h"
+
+#include <array>
+#include <utility>
+
+#include <fmt/core.h>
+
+#include "stats/container_format.h"
+#include "stats/writer.h"
+
+namespace stats {
+
+using container_format::record_type;
+
+namespace {
+constexpr std::uint64_t header_size =
+    container_format::magic.size() + sizeof(std::uint32_t) + sizeof(double);
+}  // namespace
+
+ContainerReader::ContainerReader(const std::string &path)
+    : _path{path}, _in{path, std::ios::binary} {
+  if (!_in) {
+    throw OutputError(fmt::format(R"(Can't open file "{}")", path));
+  }
+
+  std::array<char, container_format::magic.size()> magic{};
+  read(magic.data(), magic.size());
+  if (magic != container_format::magic) {
+    throw OutputError(
+        fmt::format(R"("{}" is not statistics container)", path));
+  }
+
+  if (auto version = read_value<std::uint32_t>();
+      version != container_format::version) {
+    throw OutputError(fmt::format(R"(Unsupported version {} of "{}")",
+                                  version, path));
+  }
+  _seconds_per_step = read_value<double>();
+
+  _in.seekg(0, std::ios::end);
+  auto file_size = static_cast<std::uint64_t>(_in.tellg());
+
+  _indexed = read_index(file_size);
+  if (!_indexed) {
+    scan_records(file_size);
+  }
+}
+
+bool ContainerReader::is_container(const std::string &path) {
+  std::ifstream in{path, std::ios::binary};
+  std::array<char, container_format::magic.size()> magic{};
+  return in.read(magic.data(), magic.size()) &&
+         magic == container_format::magic;
+}
+
+auto ContainerReader::find(const std::string &name) const -> const Stream * {
+  for (const auto &stream : _streams) {
+    if (stream.name == name) {
+      return &stream;
+    }
+  }
+  return nullptr;
+}
+
+void ContainerReader::read_block(const Stream &stream, std::size_t block,
+                                 Block &out) {
+  const auto &info = stream.blocks.at(block);
+
+  _in.clear();
+  _in.seekg(static_cast<std::streamoff>(info.offset) +
+            container_format::record_header_size);
+
+  auto rows = read_value<std::uint32_t>();
+  if (rows != info.rows) {
+    throw OutputError(fmt::format(R"(Corrupted block of stream "{}" in "{}")",
+                                  stream.name, _path));
+  }
+
+  out.times.resize(rows);
+  read(out.times.data(), rows * sizeof(std::int64_t));
+
+  out.values.resize(stream.columns.size());
+  for (auto &column : out.values) {
+    column.resize(rows);
+    read(column.data(), rows * sizeof(double));
+  }
+}
+
+bool ContainerReader::read_index(std::uint64_t file_size) {
+  if (file_size < header_size + container_format::trailer_size) {
+    return false;
+  }
+
+  _in.seekg(static_cast<std::streamoff>(file_size -
+                                        container_format::trailer_size));
+  auto index_offset = read_value<std::uint64_t>();
+
+  std::array<char, container_format::index_magic.size()> magic{};
+  read(magic.data(), magic.size());
+  if (magic != container_format::index_magic || index_offset < header_size ||
+      index_offset > file_size - container_format::trailer_size) {
+    return false;
+  }
+
+  _in.seekg(static_cast<std::streamoff>(index_offset));
+  auto streams_count = read_value<std::uint32_t>();
+  for (std::uint32_t i = 0; i < streams_count; ++i) {
+    Stream stream;
+    stream.id = read_value<std::uint32_t>();
+    stream.name = read_string();
+
+    auto columns_count = read_value<std::uint32_t>();
+    for (std::uint32_t column = 0; column < columns_count; ++column) {
+      stream.columns.push_back(read_string());
+    }
+
+    auto blocks_count = read_value<std::uint32_t>();
+    stream.blocks.reserve(blocks_count);
+    for (std::uint32_t block = 0; block < blocks_count; ++block) {
+      auto offset = read_value<std::uint64_t>();
+      auto rows = read_value<std::uint32_t>();
+      stream.blocks.push_back(BlockInfo{.offset = offset, .rows = rows});
+    }
+
+    _streams.push_back(std::move(stream));
+  }
+
+  return true;
+}
+
+void ContainerReader::scan_records(std::uint64_t file_size) {
+  _in.clear();
+
+  std::uint64_t offset = header_size;
+  while (offset + container_format::record_header_size <= file_size) {
+    _in.seekg(static_cast<std::streamoff>(offset));
+    auto length = read_value<std::uint32_t>();
+
+    auto next = offset + sizeof(length) + length;
+    if (next > file_size) {
+      // Record was not written completely
+      break;
+    }
+
+    auto type = read_value<record_type>();
+    auto id = read_value<std::uint32_t>();
+
+    if (type == record_type::stream) {
+      if (id != _streams.size()) {
+        throw OutputError(
+            fmt::format(R"(Corrupted stream table of "{}")", _path));
+      }
+
+      Stream stream{
+          .id = id, .name = read_string(), .columns = {}, .blocks = {}};
+      auto columns_count = read_value<std::uint32_t>();
+      for (std::uint32_t column = 0; column < columns_count; ++column) {
+        stream.columns.push_back(read_string());
+      }
+      _streams.push_back(std::move(stream));
+    } else if (type == record_type::block && id < _streams.size()) {
+      auto rows = read_value<std::uint32_t>();
+      _streams[id].blocks.push_back(BlockInfo{.offset = offset, .rows = rows});
+    } else {
+      // Index or unknown record
+      break;
+    }
+
+    offset = next;
+  }
+}
+
+template <typename T>
+T ContainerReader::read_value() {
+  T value{};
+  read(&value, sizeof(value));
+  return value;
+}
+
+auto ContainerReader::read_string() -> std::string {
+  std::string str(read_value<std::uint16_t>(), '\0');
+  read(str.data(), str.size());
+  return str;
+}
+
+void ContainerReader::read(void *data, std::size_t size) {
+  if (!_in.read(static_cast<char *>(data),
+                static_cast<std::streamsize>(size))) {
+    throw OutputError(
+        fmt::format(R"(Unexpected end of statistics container "{}")", _path));
+  }
+}
+
+}  // namespace stats
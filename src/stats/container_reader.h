@@ -0,0 +1,92 @@
+#ifndef __CONTAINER_READER_H_E9T2XB6RJN0C__
+#define __CONTAINER_READER_H_E9T2XB6RJN0C__
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "stats/binary_reader.h"
+
+namespace stats {
+
+/**
+ * @brief Reader of container file with many statistics streams
+ *
+ * Uses the index to read blocks of one stream without scanning the file.
+ * If the index is missing (run was interrupted), records are scanned once on
+ * open.
+ */
+class ContainerReader {
+ public:
+  using Block = BinaryReader::Block;
+
+  struct BlockInfo {
+    std::uint64_t offset;
+    std::uint32_t rows;
+  };
+
+  struct Stream {
+    std::uint32_t id;
+    std::string name;
+    std::vector<std::string> columns;
+    std::vector<BlockInfo> blocks;
+  };
+
+  /**
+   * @brief Open file and read index
+   *
+   * @param path
+   * @throws OutputError if file can't be read or has bad format
+   */
+  explicit ContainerReader(const std::string &path);
+
+  /**
+   * @brief Check that file starts with container magic
+   *
+   */
+  static bool is_container(const std::string &path);
+
+  auto streams() const -> const std::vector<Stream> & { return _streams; }
+
+  auto find(const std::string &name) const -> const Stream *;
+
+  auto seconds_per_step() const -> double { return _seconds_per_step; }
+
+  /**
+   * @brief Whether index was read, false if records were scanned
+   *
+   */
+  bool indexed() const { return _indexed; }
+
+  /**
+   * @brief Read block of stream
+   *
+   * @param stream
+   * @param block index of block in `stream.blocks`
+   * @param out
+   */
+  void read_block(const Stream &stream, std::size_t block, Block &out);
+
+ private:
+  bool read_index(std::uint64_t file_size);
+
+  void scan_records(std::uint64_t file_size);
+
+  template <typename T>
+  T read_value();
+
+  auto read_string() -> std::string;
+
+  void read(void *data, std::size_t size);
+
+  std::string _path;
+  std::ifstream _in;
+  double _seconds_per_step = 0;
+  bool _indexed = false;
+  std::vector<Stream> _streams;
+};
+
+}  // namespace stats
+
+#endif  // __CONTAINER_READER_H_E9T2XB6RJN0C__
@@ -0,0 +1,214 @@
+#include "container_writer.h"
+
+#include <utility>
+
+#include <fmt/core.h>
+
+#include "stats/container_format.h"
+
+namespace stats {
+
+using container_format::record_type;
+
+/**
+ * @brief Writer of one stream, collects rows into blocks
+ *
+ */
+class ContainerFile::Stream final : public Writer {
+ public:
+  Stream(std::shared_ptr<ContainerFile> container, std::uint32_t id,
+         std::vector<std::string> columns, std::size_t block_rows)
+      : Writer{std::move(columns)},
+        _container{std::move(container)},
+        _id{id},
+        _block_rows{block_rows},
+        _values(this->columns().size()) {
+    _times.reserve(_block_rows);
+    for (auto &column : _values) {
+      column.reserve(_block_rows);
+    }
+  }
+
+  ~Stream() override {
+    try {
+      write_block();
+    } catch (OutputError &) {
+      // Destructor can't report error
+    }
+  }
+
+  void write(std::int64_t time, const double *values) override {
+    _times.push_back(time);
+    for (std::size_t i = 0; i < _values.size(); ++i) {
+      _values[i].push_back(values[i]);
+    }
+
+    if (_times.size() == _block_rows) {
+      write_block();
+    }
+  }
+
+  void flush() override {
+    write_block();
+    _container->flush();
+  }
+
+ private:
+  void write_block() {
+    if (_times.empty()) {
+      return;
+    }
+
+    _container->write_block(_id, _times, _values);
+
+    _times.clear();
+    for (auto &column : _values) {
+      column.clear();
+    }
+  }
+
+  std::shared_ptr<ContainerFile> _container;
+  std::uint32_t _id;
+  std::size_t _block_rows;
+  std::vector<std::int64_t> _times;
+  std::vector<std::vector<double>> _values;
+};
+
+ContainerFile::ContainerFile(const std::string &path) : _file{path} {}
+
+ContainerFile::~ContainerFile() {
+  try {
+    close();
+  } catch (OutputError &) {
+    // Destructor can't report error
+  }
+}
+
+auto ContainerFile::open_stream(const std::string &name,
+                                std::vector<std::string> columns,
+                                double seconds_per_step,
+                                std::size_t block_rows)
+    -> std::unique_ptr<Writer> {
+  auto id = add_stream(name, columns, seconds_per_step);
+  return std::make_unique<Stream>(shared_from_this(), id, std::move(columns),
+                                  block_rows);
+}
+
+void ContainerFile::close() {
+  std::lock_guard lock{_mutex};
+  if (_closed) {
+    return;
+  }
+  _closed = true;
+
+  if (!_seconds_per_step.has_value()) {
+    write_header(0);
+  }
+
+  auto index_offset = _file.offset();
+
+  _file.write_value(static_cast<std::uint32_t>(_streams.size()));
+  for (std::uint32_t id = 0; id < _streams.size(); ++id) {
+    const auto &stream = _streams[id];
+
+    _file.write_value(id);
+    write_string(stream.name);
+    _file.write_value(static_cast<std::uint32_t>(stream.columns.size()));
+    for (const auto &column : stream.columns) {
+      write_string(column);
+    }
+
+    _file.write_value(static_cast<std::uint32_t>(stream.blocks.size()));
+    for (const auto &[offset, rows] : stream.blocks) {
+      _file.write_value(offset);
+      _file.write_value(rows);
+    }
+  }
+
+  _file.write_value(index_offset);
+  _file.write(container_format::index_magic.data(),
+              container_format::index_magic.size());
+  _file.flush();
+}
+
+auto ContainerFile::add_stream(const std::string &name,
+                               const std::vector<std::string> &columns,
+                               double seconds_per_step) -> std::uint32_t {
+  std::lock_guard lock{_mutex};
+  if (_closed) {
+    throw OutputError(fmt::format(
+        R"(Can't add stream "{}" to closed container "{}")", name, path()));
+  }
+
+  if (!_seconds_per_step.has_value()) {
+    write_header(seconds_per_step);
+  } else if (*_seconds_per_step != seconds_per_step) {
+    throw OutputError(fmt::format(
+        R"(Time step of stream "{}" differs from container "{}")", name,
+        path()));
+  }
+
+  auto id = static_cast<std::uint32_t>(_streams.size());
+  _streams.push_back(
+      StreamIndex{.name = name, .columns = columns, .blocks = {}});
+
+  std::size_t length = 1 + 4 + 2 + name.size() + 4;
+  for (const auto &column : columns) {
+    length += 2 + column.size();
+  }
+
+  _file.write_value(static_cast<std::uint32_t>(length));
+  _file.write_value(record_type::stream);
+  _file.write_value(id);
+  write_string(name);
+  _file.write_value(static_cast<std::uint32_t>(columns.size()));
+  for (const auto &column : columns) {
+    write_string(column);
+  }
+
+  return id;
+}
+
+void ContainerFile::write_block(
+    std::uint32_t stream, const std::vector<std::int64_t> &times,
+    const std::vector<std::vector<double>> &values) {
+  std::lock_guard lock{_mutex};
+  if (_closed) {
+    throw OutputError(
+        fmt::format(R"(Can't write to closed container "{}")", path()));
+  }
+
+  auto rows = static_cast<std::uint32_t>(times.size());
+  _streams[stream].blocks.emplace_back(_file.offset(), rows);
+
+  auto length = 1 + 4 + 4 + rows * sizeof(std::int64_t) +
+                values.size() * rows * sizeof(double);
+
+  _file.write_value(static_cast<std::uint32_t>(length));
+  _file.write_value(record_type::block);
+  _file.write_value(stream);
+  _file.write_value(rows);
+  _file.write(times.data(), rows * sizeof(std::int64_t));
+  for (const auto &column : values) {
+    _file.write(column.data(), rows * sizeof(double));
+  }
+}
+
+void ContainerFile::write_header(double seconds_per_step) {
+  _seconds_per_step = seconds_per_step;
+  _file.write(container_format::magic.data(), container_format::magic.size());
+  _file.write_value(container_format::version);
+  _file.write_value(seconds_per_step);
+}
+
+void ContainerFile::flush() {
+  std::lock_guard lock{_mutex};
+  _file.flush();
+}
+
+void ContainerFile::write_string(const std::string &str) {
+  _file.write_value(static_cast<std::uint16_t>(str.size()));
+  _file.write(str.data(), str.size());
+}
+
+}  // namespace stats
@@ -0,0 +1,96 @@
+#ifndef __CONTAINER_WRITER_H_G3D8PW1ZMK6Y__
+#define __CONTAINER_WRITER_H_G3D8PW1ZMK6Y__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "stats/buffered_file.h"
+#include "stats/writer.h"
+
+namespace stats {
+
+/**
+ * @brief Single file collecting many statistics streams
+ *
+ * Streams append length-prefixed block records, the index of blocks of every
+ * stream is written on close (see container_format.h). Streams may write
+ * from different threads.
+ */
+class ContainerFile : public std::enable_shared_from_this<ContainerFile> {
+ public:
+  static constexpr std::size_t default_block_rows = 8192;
+
+  /**
+   * @brief Create file, header is written with the first stream
+   *
+   * @param path
+   * @throws OutputError if file can't be opened
+   */
+  explicit ContainerFile(const std::string &path);
+
+  ~ContainerFile();
+
+  ContainerFile(const ContainerFile &) = delete;
+  ContainerFile &operator=(const ContainerFile &) = delete;
+
+  /**
+   * @brief Add stream to the file
+   *
+   * @param name
+   * @param columns
+   * @param seconds_per_step the same for all streams
+   * @param block_rows rows collected before block is written
+   * @return std::unique_ptr<Writer> writer of stream, keeps container alive
+   * @throws OutputError if container is closed or time step differs
+   */
+  auto open_stream(const std::string &name, std::vector<std::string> columns,
+                   double seconds_per_step,
+                   std::size_t block_rows = default_block_rows)
+      -> std::unique_ptr<Writer>;
+
+  /**
+   * @brief Write index and trailer, streams must be flushed before
+   *
+   */
+  void close();
+
+  auto path() const -> const std::string & { return _file.path(); }
+
+ private:
+  class Stream;
+
+  struct StreamIndex {
+    std::string name;
+    std::vector<std::string> columns;
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> blocks;
+  };
+
+  auto add_stream(const std::string &name,
+                  const std::vector<std::string> &columns,
+                  double seconds_per_step) -> std::uint32_t;
+
+  void write_header(double seconds_per_step);
+
+  void write_block(std::uint32_t stream, const std::vector<std::int64_t> &times,
+                   const std::vector<std::vector<double>> &values);
+
+  void flush();
+
+  void write_string(const std::string &str);
+
+  std::mutex _mutex;
+  BufferedFile _file;
+  std::vector<StreamIndex> _streams;
+  std::optional<double> _seconds_per_step;
+  bool _closed = false;
+};
+
+}  // namespace stats
+
+#endif  // __CONTAINER_WRITER_H_G3D8PW1ZMK6Y__
@@ -0,0 +1,40 @@
+#include "csv_writer.h"
+
+#include <iterator>
+#include <utility>
+
+#include <fmt/format.h>
+
+namespace stats {
+
+CsvWriter::CsvWriter(const std::string &path,
+                     std::vector<std::string> columns, double seconds_per_step,
+                     compression method)
+    : Writer{std::move(columns)},
+      _file{path, method},
+      _seconds_per_step{seconds_per_step} {
+  _line = "Time";
+  for (const auto &column : this->columns()) {
+    _line += ',';
+    _line += column;
+  }
+  _line += '\n';
+  _file.write(_line.data(), _line.size());
+}
+
+void CsvWriter::write(std::int64_t time, const double *values) {
+  _line.clear();
+  auto out = std::back_inserter(_line);
+
+  fmt::format_to(out, "{}", static_cast<double>(time) * _seconds_per_step);
+  for (std::size_t i = 0; i < columns().size(); ++i) {
+    fmt::format_to(out, ",{}", values[i]);
+  }
+  _line += '\n';
+
+  _file.write(_line.data(), _line.size());
+}
+
+void CsvWriter::flush() { _file.flush(); }
+
+}  // namespace stats
@@ -0,0 +1,37 @@
+#ifndef __CSV_WRITER_H_H6R1NC8VDK3Y__
+#define __CSV_WRITER_H_H6R1NC8VDK3Y__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "stats/buffered_file.h"
+#include "stats/compression.h"
+#include "stats/writer.h"
+
+namespace stats {
+
+/**
+ * @brief Writes rows as comma separated text, time in seconds
+ *
+ * Output is compatible with ns3::FileAggregator::COMMA_SEPARATED with
+ * "Time,<columns...>" heading.
+ */
+class CsvWriter final : public Writer {
+ public:
+  CsvWriter(const std::string &path, std::vector<std::string> columns,
+            double seconds_per_step, compression method = compression::none);
+
+  void write(std::int64_t time, const double *values) override;
+
+  void flush() override;
+
+ private:
+  BufferedFile _file;
+  double _seconds_per_step;
+  std::string _line;
+};
+
+}  // namespace stats
+
+#endif  // __CSV_WRITER_H_H6R1NC8VDK3Y__
@@ -0,0 +1,118 @@
+#include "histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace stats {
+
+namespace {
+// Magnitude with binary exponent e and mantissa m in [0.5, 1) goes to
+// bucket floor((m - 0.5) * 2 * sub_buckets) of block e
+auto split(double magnitude, int &exponent) noexcept -> std::size_t {
+  magnitude = std::min(magnitude, std::numeric_limits<double>::max());
+  auto mantissa = std::frexp(magnitude, &exponent);
+  auto sub = static_cast<int>((mantissa - 0.5) * 2 * Histogram::sub_buckets);
+  return static_cast<std::size_t>(
+      std::clamp(sub, 0, Histogram::sub_buckets - 1));
+}
+
+// Middle of the bucket
+auto middle(int exponent, std::size_t sub) noexcept -> double {
+  auto mantissa = 0.5 + (static_cast<double>(sub) + 0.5) /
+                            (2.0 * Histogram::sub_buckets);
+  return std::ldexp(mantissa, exponent);
+}
+}  // namespace
+
+void Histogram::add(double value) {
+  if (std::isnan(value)) {
+    return;
+  }
+
+  if (value > 0.0) {
+    add(_positive, value);
+  } else if (value < 0.0) {
+    add(_negative, -value);
+  } else {
+    ++_zeros;
+  }
+
+  if (_count == 0) {
+    _min = _max = value;
+  } else {
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+  }
+  ++_count;
+}
+
+void Histogram::add(Blocks &blocks, double magnitude) {
+  int exponent = 0;
+  auto sub = split(magnitude, exponent);
+  ++blocks[exponent][sub];
+}
+
+auto Histogram::quantile(double quantile) const -> double {
+  if (_count == 0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  quantile = std::clamp(quantile, 0.0, 1.0);
+  if (quantile == 0.0) {
+    return _min;
+  }
+  if (quantile == 1.0) {
+    return _max;
+  }
+
+  // Rank of the value, starting from 1
+  auto rank = static_cast<std::uint64_t>(
+      std::ceil(quantile * static_cast<double>(_count)));
+  rank = std::max<std::uint64_t>(rank, 1);
+
+  // Negative values in ascending order go from the largest magnitude
+  std::uint64_t seen = 0;
+  for (auto block = _negative.rbegin(); block != _negative.rend(); ++block) {
+    for (auto sub = block->second.size(); sub-- > 0;) {
+      seen += block->second[sub];
+      if (seen >= rank) {
+        return std::clamp(-middle(block->first, sub), _min, _max);
+      }
+    }
+  }
+
+  seen += _zeros;
+  if (seen >= rank) {
+    return 0.0;
+  }
+
+  for (const auto &[exponent, block] : _positive) {
+    for (std::size_t sub = 0; sub < block.size(); ++sub) {
+      seen += block[sub];
+      if (seen >= rank) {
+        return std::clamp(middle(exponent, sub), _min, _max);
+      }
+    }
+  }
+
+  return _max;
+}
+
+void Histogram::reset() {
+  for (auto *blocks : {&_positive, &_negative}) {
+    for (auto &[exponent, block] : *blocks) {
+      block.fill(0);
+    }
+  }
+  _zeros = 0;
+  _count = 0;
+}
+
+auto Histogram::memory_usage() const noexcept -> std::size_t {
+  // Node of the map keeps the key and three links besides the block
+  constexpr auto node_size = sizeof(Blocks::value_type) + 4 * sizeof(void *);
+  return (_positive.size() + _negative.size()) * node_size;
+}
+
+}  // namespace stats
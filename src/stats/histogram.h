@@ -0,0 +1,64 @@
+#ifndef __HISTOGRAM_H_Q4P7ZC2VNE9J__
+#define __HISTOGRAM_H_Q4P7ZC2VNE9J__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace stats {
+
+/**
+ * @brief Streaming histogram with log-linear buckets for quantile estimates
+ *
+ * Like HDR histogram, every power of two is split into `sub_buckets` equal
+ * buckets, so quantiles are estimated with relative error below
+ * 1 / sub_buckets for values of any magnitude and sign. Buckets of a power
+ * of two are allocated on the first value in it, zeros are only counted.
+ */
+class Histogram {
+ public:
+  static constexpr int sub_buckets = 128;
+
+  void add(double value);
+
+  /**
+   * @brief Estimate quantile
+   *
+   * @param quantile quantile in [0, 1]
+   * @return double value, NaN if histogram is empty
+   */
+  auto quantile(double quantile) const -> double;
+
+  auto count() const noexcept -> std::uint64_t { return _count; }
+
+  /**
+   * @brief Remove all values, keeping allocated buckets
+   *
+   */
+  void reset();
+
+  /**
+   * @brief Approximate heap memory used by buckets in bytes
+   *
+   */
+  auto memory_usage() const noexcept -> std::size_t;
+
+ private:
+  using Block = std::array<std::uint64_t, sub_buckets>;
+  // Buckets of magnitudes by binary exponent
+  using Blocks = std::map<int, Block>;
+
+  static void add(Blocks &blocks, double magnitude);
+
+  Blocks _positive;
+  Blocks _negative;
+  std::uint64_t _zeros = 0;
+  std::uint64_t _count = 0;
+  double _min = 0;
+  double _max = 0;
+};
+
+}  // namespace stats
+
+#endif  // __HISTOGRAM_H_Q4P7ZC2VNE9J__
@@ -0,0 +1,74 @@
+#include "output.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "stats/binary_writer.h"
+#include "stats/csv_writer.h"
+#include "stats/shm_writer.h"
+
+namespace stats {
+
+namespace {
+// Writes the same rows to the file and to the live feed
+class TeeWriter final : public Writer {
+ public:
+  TeeWriter(std::unique_ptr<Writer> first, std::unique_ptr<Writer> second)
+      : Writer{first->columns()},
+        _first{std::move(first)},
+        _second{std::move(second)} {}
+
+  void write(std::int64_t time, const double *values) override {
+    _first->write(time, values);
+    _second->write(time, values);
+  }
+
+  void flush() override {
+    _first->flush();
+    _second->flush();
+  }
+
+ private:
+  std::unique_ptr<Writer> _first;
+  std::unique_ptr<Writer> _second;
+};
+}  // namespace
+
+auto make_output(output_format format, const std::string &file_name,
+                 std::vector<std::string> columns, double seconds_per_step,
+                 const OutputContext &context) -> std::unique_ptr<Writer> {
+  std::unique_ptr<Writer> live;
+  if (!context.live.empty()) {
+    live = std::make_unique<ShmWriter>(
+        ShmWriter::segment_name(context.live, file_name), columns,
+        seconds_per_step, context.live_capacity);
+  }
+
+  std::unique_ptr<Writer> writer;
+  if (context.container != nullptr) {
+    writer = context.container->open_stream(file_name, std::move(columns),
+                                            seconds_per_step);
+  } else if (format == output_format::csv) {
+    writer = std::make_unique<CsvWriter>(
+        file_name + ".txt" + compressed_extension(context.compress),
+        std::move(columns), seconds_per_step, context.compress);
+  } else {
+    writer = std::make_unique<BinaryWriter>(
+        file_name + ".bin" + compressed_extension(context.compress),
+        std::move(columns), seconds_per_step,
+        BinaryWriter::default_block_rows, context.compress);
+  }
+
+  if (live != nullptr) {
+    writer = std::make_unique<TeeWriter>(std::move(writer), std::move(live));
+  }
+
+  if (context.pipeline != nullptr) {
+    writer = context.pipeline->attach(std::move(writer));
+  }
+
+  return writer;
+}
+
+}  // namespace stats
@@ -0,0 +1,50 @@
+#ifndef __OUTPUT_H_B5X1KM8QHZ3W__
+#define __OUTPUT_H_B5X1KM8QHZ3W__
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "stats/async_writer.h"
+#include "stats/compression.h"
+#include "stats/container_writer.h"
+#include "stats/writer.h"
+
+namespace stats {
+
+/**
+ * @brief Shared outputs of all registrators
+ *
+ */
+struct OutputContext {
+  // Background output, files are written on the simulation thread if null
+  AsyncPipeline *pipeline = nullptr;
+  // All streams are written to the container instead of own files if set
+  std::shared_ptr<ContainerFile> container;
+  // Compression of own files
+  compression compress = compression::none;
+  // Rows are also published to shared memory "<live>-<file name>" if set
+  std::string live;
+  std::size_t live_capacity = 1 << 16;
+};
+
+/**
+ * @brief Open statistics output file
+ *
+ * @param format format of own file, ignored for container stream
+ * @param file_name file name without extension: ".txt" is added for CSV, the
+ * same as by ns3::FileHelper, and ".bin" for binary format, followed by
+ * ".gz" or ".zst" for compressed file. Name of stream in container
+ * @param columns
+ * @param seconds_per_step
+ * @param context
+ * @return std::unique_ptr<Writer>
+ */
+auto make_output(output_format format, const std::string &file_name,
+                 std::vector<std::string> columns, double seconds_per_step,
+                 const OutputContext &context = {}) -> std::unique_ptr<Writer>;
+
+}  // namespace stats
+
+#endif  // __OUTPUT_H_B5X1KM8QHZ3W__
@@ -0,0 +1,185 @@
+#include "packet_filter.h"
+
+#include <utility>
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+namespace stats {
+
+namespace {
+constexpr std::uint16_t ethertype_ipv4 = 0x0800;
+constexpr std::uint16_t ethertype_ipv6 = 0x86DD;
+constexpr std::uint16_t ppp_ipv4 = 0x0021;
+constexpr std::uint16_t ppp_ipv6 = 0x0057;
+
+constexpr std::uint8_t ip_icmp = 1;
+constexpr std::uint8_t ip_tcp = 6;
+constexpr std::uint8_t ip_udp = 17;
+constexpr std::uint8_t ip_icmpv6 = 58;
+
+constexpr std::size_t ethernet_header = 14;
+constexpr std::size_t llc_snap_header = 8;
+constexpr std::size_t ipv6_header = 40;
+
+// Values below are frame lengths of 802.3 frames with LLC header
+constexpr std::uint16_t min_ethertype = 0x0600;
+
+auto read_u16(const std::uint8_t *data) noexcept -> std::uint16_t {
+  return static_cast<std::uint16_t>((data[0] << 8U) | data[1]);
+}
+
+enum class network { unknown, ipv4, ipv6 };
+
+struct Transport {
+  std::uint8_t protocol = 0;
+  // Offset of transport header, 0 if there is none
+  std::size_t offset = 0;
+};
+
+// Network protocol and offset of its header
+auto parse_link(link_type link, const std::uint8_t *data,
+                std::size_t size) noexcept -> std::pair<network, std::size_t> {
+  if (link == link_type::ppp) {
+    std::size_t offset = 0;
+    // Address and control fields are optional
+    if (size >= 2 && data[0] == 0xFF && data[1] == 0x03) {
+      offset = 2;
+    }
+    if (size < offset + 2) {
+      return {network::unknown, 0};
+    }
+
+    auto protocol = read_u16(data + offset);
+    offset += 2;
+    if (protocol == ppp_ipv4) {
+      return {network::ipv4, offset};
+    }
+    if (protocol == ppp_ipv6) {
+      return {network::ipv6, offset};
+    }
+    return {network::unknown, 0};
+  }
+
+  if (size < ethernet_header) {
+    return {network::unknown, 0};
+  }
+
+  auto type = read_u16(data + 12);
+  auto offset = ethernet_header;
+  if (type < min_ethertype) {
+    if (size < offset + llc_snap_header) {
+      return {network::unknown, 0};
+    }
+    type = read_u16(data + offset + 6);
+    offset += llc_snap_header;
+  }
+
+  if (type == ethertype_ipv4) {
+    return {network::ipv4, offset};
+  }
+  if (type == ethertype_ipv6) {
+    return {network::ipv6, offset};
+  }
+  return {network::unknown, 0};
+}
+
+auto parse_network(network net, const std::uint8_t *data,
+                   std::size_t size) noexcept -> std::optional<Transport> {
+  if (net == network::ipv4) {
+    if (size < 20) {
+      return {};
+    }
+
+    std::size_t header_length = (data[0] & 0x0FU) * 4U;
+    auto fragment_offset = read_u16(data + 6) & 0x1FFFU;
+
+    // Only the first fragment has transport header
+    return Transport{
+        .protocol = data[9],
+        .offset = fragment_offset == 0 ? header_length : std::size_t{0}};
+  }
+
+  if (net == network::ipv6) {
+    if (size < ipv6_header) {
+      return {};
+    }
+    return Transport{.protocol = data[6], .offset = ipv6_header};
+  }
+
+  return {};
+}
+}  // namespace
+
+auto capture_protocol_from_string(const std::string &str) noexcept
+    -> std::optional<capture_protocol> {
+  auto protocol = boost::algorithm::to_lower_copy(str);
+  if (protocol == "any") {
+    return capture_protocol::any;
+  }
+
+  if (protocol == "tcp") {
+    return capture_protocol::tcp;
+  }
+
+  if (protocol == "udp") {
+    return capture_protocol::udp;
+  }
+
+  if (protocol == "icmp") {
+    return capture_protocol::icmp;
+  }
+
+  return {};
+}
+
+bool PacketFilter::match(const std::uint8_t *data,
+                         std::size_t size) const noexcept {
+  if (!enabled()) {
+    return true;
+  }
+
+  auto [net, network_offset] = parse_link(_link, data, size);
+  auto transport =
+      parse_network(net, data + network_offset, size - network_offset);
+  if (!transport.has_value()) {
+    return false;
+  }
+
+  switch (_protocol) {
+    case capture_protocol::tcp:
+      if (transport->protocol != ip_tcp) {
+        return false;
+      }
+      break;
+    case capture_protocol::udp:
+      if (transport->protocol != ip_udp) {
+        return false;
+      }
+      break;
+    case capture_protocol::icmp:
+      if (transport->protocol != ip_icmp && transport->protocol != ip_icmpv6) {
+        return false;
+      }
+      break;
+    default:
+      break;
+  }
+
+  if (!_port.has_value()) {
+    return true;
+  }
+
+  if (transport->protocol != ip_tcp && transport->protocol != ip_udp) {
+    return false;
+  }
+
+  auto ports_offset = network_offset + transport->offset;
+  if (transport->offset == 0 || size < ports_offset + 4) {
+    return false;
+  }
+
+  return read_u16(data + ports_offset) == *_port ||
+         read_u16(data + ports_offset + 2) == *_port;
+}
+
+}  // namespace stats
@@ -0,0 +1,63 @@
+#ifndef __PACKET_FILTER_H_G3K7VB0NSE2W__
+#define __PACKET_FILTER_H_G3K7VB0NSE2W__
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "stats/pcapng_writer.h"
+
+namespace stats {
+
+enum class capture_protocol { any, tcp, udp, icmp };
+
+auto capture_protocol_from_string(const std::string &str) noexcept
+    -> std::optional<capture_protocol>;
+
+/**
+ * @brief Matches captured frames by transport protocol and port
+ *
+ * Headers are parsed from raw bytes: Ethernet II or LLC/SNAP, PPP, then IPv4
+ * or IPv6 without extension headers. Frames that can't be parsed match only
+ * filter without protocol and port.
+ */
+class PacketFilter {
+ public:
+  // Enough bytes of frame to parse link, IP and transport ports
+  static constexpr std::size_t header_bytes = 22 + 60 + 4;
+
+  PacketFilter() = default;
+
+  /**
+   * @brief Construct filter
+   *
+   * @param link
+   * @param protocol
+   * @param port source or destination port of TCP or UDP, any if not set
+   */
+  PacketFilter(link_type link, capture_protocol protocol,
+               std::optional<std::uint16_t> port) noexcept
+      : _link{link}, _protocol{protocol}, _port{port} {}
+
+  bool enabled() const noexcept {
+    return _protocol != capture_protocol::any || _port.has_value();
+  }
+
+  /**
+   * @brief Check frame
+   *
+   * @param data first bytes of frame
+   * @param size number of bytes, at least header_bytes or the whole frame
+   */
+  bool match(const std::uint8_t *data, std::size_t size) const noexcept;
+
+ private:
+  link_type _link = link_type::ethernet;
+  capture_protocol _protocol = capture_protocol::any;
+  std::optional<std::uint16_t> _port;
+};
+
+}  // namespace stats
+
+#endif  // __PACKET_FILTER_H_G3K7VB0NSE2W__
@@ -0,0 +1,99 @@
+#include "pcapng_writer.h"
+
+#include <algorithm>
+#include <array>
+
+namespace stats {
+
+namespace {
+constexpr std::uint32_t section_header_block = 0x0A0D0D0A;
+constexpr std::uint32_t interface_description_block = 0x00000001;
+constexpr std::uint32_t enhanced_packet_block = 0x00000006;
+
+constexpr std::uint32_t byte_order_magic = 0x1A2B3C4D;
+
+constexpr std::uint16_t opt_endofopt = 0;
+constexpr std::uint16_t if_name = 2;
+constexpr std::uint16_t if_tsresol = 9;
+
+// Timestamps in 10^-9 seconds
+constexpr std::uint8_t nanoseconds_resolution = 9;
+
+constexpr auto padded(std::size_t size) noexcept -> std::size_t {
+  return (size + 3) & ~std::size_t{3};
+}
+
+constexpr std::array<std::uint8_t, 4> padding = {};
+}  // namespace
+
+PcapngWriter::PcapngWriter(const std::string &path, link_type link,
+                           std::uint32_t snap_length,
+                           const std::string &interface_name)
+    : _file{path}, _snap_length{snap_length} {
+  // Section header: type, length, byte order, version 1.0, unknown section
+  // length, length
+  constexpr std::uint32_t section_length = 28;
+  _file.write_value(section_header_block);
+  _file.write_value(section_length);
+  _file.write_value(byte_order_magic);
+  _file.write_value(std::uint16_t{1});
+  _file.write_value(std::uint16_t{0});
+  _file.write_value(std::int64_t{-1});
+  _file.write_value(section_length);
+
+  auto name_length = static_cast<std::uint16_t>(
+      std::min<std::size_t>(interface_name.size(), UINT16_MAX));
+
+  // Interface description: type, length, link type, reserved, snap length,
+  // options, length
+  auto interface_length = static_cast<std::uint32_t>(
+      20 + (name_length > 0 ? 4 + padded(name_length) : 0) + 4 + padded(1) +
+      4);
+  _file.write_value(interface_description_block);
+  _file.write_value(interface_length);
+  _file.write_value(static_cast<std::uint16_t>(link));
+  _file.write_value(std::uint16_t{0});
+  _file.write_value(_snap_length);
+  if (name_length > 0) {
+    write_option(if_name, interface_name.data(), name_length);
+  }
+  write_option(if_tsresol, &nanoseconds_resolution, 1);
+  write_option(opt_endofopt, nullptr, 0);
+  _file.write_value(interface_length);
+}
+
+void PcapngWriter::write(std::uint64_t time_ns, const std::uint8_t *data,
+                         std::uint32_t captured, std::uint32_t original) {
+  captured = std::min(captured, _snap_length);
+  auto data_length = padded(captured);
+
+  // Enhanced packet: type, length, interface, timestamp, captured and
+  // original length, data, length
+  auto length = static_cast<std::uint32_t>(32 + data_length);
+  _file.write_value(enhanced_packet_block);
+  _file.write_value(length);
+  _file.write_value(std::uint32_t{0});
+  _file.write_value(static_cast<std::uint32_t>(time_ns >> 32U));
+  _file.write_value(static_cast<std::uint32_t>(time_ns));
+  _file.write_value(captured);
+  _file.write_value(original);
+  if (captured > 0) {
+    _file.write(data, captured);
+    _file.write(padding.data(), data_length - captured);
+  }
+  _file.write_value(length);
+
+  ++_packets;
+}
+
+void PcapngWriter::write_option(std::uint16_t code, const void *value,
+                                std::uint16_t length) {
+  _file.write_value(code);
+  _file.write_value(length);
+  if (length > 0) {
+    _file.write(value, length);
+    _file.write(padding.data(), padded(length) - length);
+  }
+}
+
+}  // namespace stats
@@ -0,0 +1,63 @@
+#ifndef __PCAPNG_WRITER_H_M4Q8ZT1WHC6B__
+#define __PCAPNG_WRITER_H_M4Q8ZT1WHC6B__
+
+#include <cstdint>
+#include <string>
+
+#include "stats/buffered_file.h"
+
+namespace stats {
+
+/**
+ * @brief Link layer of captured frames, values are pcap LINKTYPE_* codes
+ *
+ */
+enum class link_type : std::uint16_t { ethernet = 1, ppp = 9 };
+
+/**
+ * @brief Writes packets to pcapng file with one interface
+ *
+ * File consists of section header block, interface description block with
+ * nanosecond timestamps and enhanced packet block per packet.
+ */
+class PcapngWriter {
+ public:
+  /**
+   * @brief Create file and write headers
+   *
+   * @param path
+   * @param link
+   * @param snap_length maximal captured length of packet
+   * @param interface_name name of interface shown by analyzers
+   * @throws OutputError if file can't be opened
+   */
+  PcapngWriter(const std::string &path, link_type link,
+               std::uint32_t snap_length, const std::string &interface_name);
+
+  /**
+   * @brief Write packet
+   *
+   * @param time_ns packet time in nanoseconds
+   * @param data captured bytes, at most snap length is written
+   * @param captured number of captured bytes
+   * @param original length of the whole packet
+   */
+  void write(std::uint64_t time_ns, const std::uint8_t *data,
+             std::uint32_t captured, std::uint32_t original);
+
+  void flush() { _file.flush(); }
+
+  auto packets() const noexcept -> std::uint64_t { return _packets; }
+
+ private:
+  void write_option(std::uint16_t code, const void *value,
+                    std::uint16_t length);
+
+  BufferedFile _file;
+  std::uint32_t _snap_length;
+  std::uint64_t _packets = 0;
+};
+
+}  // namespace stats
+
+#endif  // __PCAPNG_WRITER_H_M4Q8ZT1WHC6B__
@@ -0,0 +1,74 @@
+#ifndef __SAMPLE_FILTER_H_R2G9VK6DXH4M__
+#define __SAMPLE_FILTER_H_R2G9VK6DXH4M__
+
+#include <cstdint>
+
+namespace stats {
+
+/**
+ * @brief Thins out samples before they are written
+ *
+ * Keeps every `decimate`-th sample starting from the first one, then keeps
+ * only samples at least `min_interval` time steps after the previous kept
+ * sample.
+ */
+class SampleFilter {
+ public:
+  SampleFilter() = default;
+
+  /**
+   * @brief Construct filter
+   *
+   * @param decimate keep every N-th sample, 1 keeps all
+   * @param min_interval minimal interval between samples in time steps, 0
+   * disables rate limiting
+   */
+  SampleFilter(std::uint32_t decimate, std::int64_t min_interval) noexcept
+      : _decimate{decimate == 0 ? 1 : decimate}, _min_interval{min_interval} {}
+
+  /**
+   * @brief Account sample and decide whether to keep it
+   *
+   * @param time sample time in time steps
+   */
+  bool accept(std::int64_t time) noexcept {
+    ++_seen;
+
+    if (_decimate > 1) {
+      if (_skip != 0) {
+        --_skip;
+        return false;
+      }
+      _skip = _decimate - 1;
+    }
+
+    if (_min_interval > 0 && _accepted != 0 && time - _last < _min_interval) {
+      return false;
+    }
+
+    _last = time;
+    ++_accepted;
+    return true;
+  }
+
+  bool enabled() const noexcept { return _decimate > 1 || _min_interval > 0; }
+
+  auto seen() const noexcept -> std::uint64_t { return _seen; }
+
+  auto accepted() const noexcept -> std::uint64_t { return _accepted; }
+
+  auto dropped() const noexcept -> std::uint64_t { return _seen - _accepted; }
+
+ private:
+  std::uint32_t _decimate = 1;
+  std::int64_t _min_interval = 0;
+
+  std::uint32_t _skip = 0;
+  std::int64_t _last = 0;
+  std::uint64_t _seen = 0;
+  std::uint64_t _accepted = 0;
+};
+
+}  // namespace stats
+
+#endif  // __SAMPLE_FILTER_H_R2G9VK6DXH4M__
@@ -0,0 +1,75 @@
+#ifndef __SHM_FORMAT_H_R2J8WD5QKX7M__
+#define __SHM_FORMAT_H_R2J8WD5QKX7M__
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Layout of shared memory segment with live statistics of one stream
+ *
+ * Segment "/<name>" is created by the simulator and removed when the stream is
+ * closed, readers that opened it before keep reading. All numbers are stored
+ * in native byte order.
+ *
+ * Header (struct Header):
+ *   char[8]   magic "SIMLIVE1", written last when the segment is ready
+ *   uint32    version
+ *   uint32    number of value columns N
+ *   uint64    number of slots C, power of two
+ *   uint32    size of slot in bytes
+ *   uint32    offset of the first slot
+ *   double    seconds per time step
+ *   uint64    write index, number of published samples (own cache line)
+ *   uint32    closed flag, set after the last sample
+ *
+ * Column names, after the header:
+ *   N times:  uint16 length followed by characters
+ *
+ * Slots, sample with index I is stored in slot I % C:
+ *   uint64    sequence number: I + 1 when sample is complete, 0 while written
+ *   int64     time in time steps
+ *   double[N] values
+ *
+ * Producer never waits for readers and overwrites the oldest slots. Reader
+ * keeps index of the next sample, copies the slot and checks that sequence
+ * number before and after the copy is I + 1, otherwise the sample was
+ * overwritten and the reader skips to the oldest available sample.
+ */
+namespace stats::shm_format {
+
+constexpr std::array<char, 8> magic = {'S', 'I', 'M', 'L', 'I', 'V', 'E', '1'};
+
+constexpr std::uint32_t version = 1;
+
+constexpr std::size_t cache_line = 64;
+
+struct Header {
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t columns;
+  std::uint64_t capacity;
+  std::uint32_t slot_size;
+  std::uint32_t data_offset;
+  double seconds_per_step;
+  alignas(cache_line) std::atomic<std::uint64_t> write_index;
+  std::atomic<std::uint32_t> closed;
+};
+
+struct Slot {
+  std::atomic<std::uint64_t> sequence;
+  std::int64_t time;
+  // Followed by values
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "Atomics in shared memory must be lock free");
+
+constexpr auto slot_size(std::uint32_t columns) noexcept -> std::uint32_t {
+  return static_cast<std::uint32_t>(sizeof(Slot) + columns * sizeof(double));
+}
+
+}  // namespace stats::shm_format
+
+#endif  // __SHM_FORMAT_H_R2J8WD5QKX7M__
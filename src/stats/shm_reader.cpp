@@ -0,0 +1,125 @@
+#include "shm_reader.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/core.h>
+
+#include "stats/writer.h"
+
+namespace stats {
+
+ShmReader::ShmReader(const std::string &name) {
+  auto path = name.rfind('/', 0) == 0 ? name : '/' + name;
+
+  // NOLINTNEXTLINE
+  auto fd = shm_open(path.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    throw OutputError(fmt::format(R"(Can't open shared memory "{}": {})",
+                                  path, std::strerror(errno)));
+  }
+
+  struct stat info {};
+  if (fstat(fd, &info) != 0 ||
+      static_cast<std::size_t>(info.st_size) < sizeof(shm_format::Header)) {
+    ::close(fd);
+    throw OutputError(
+        fmt::format(R"("{}" is not a live statistics stream)", path));
+  }
+
+  _size = static_cast<std::size_t>(info.st_size);
+  _memory = mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (_memory == MAP_FAILED) {  // NOLINT
+    throw OutputError(fmt::format(R"(Can't map shared memory "{}": {})",
+                                  path, std::strerror(errno)));
+  }
+
+  _header = static_cast<const shm_format::Header *>(_memory);
+
+  // Magic is written last, the rest of the header is read only after it,
+  // pairs with the release fence of the writer
+  auto magic = _header->magic;
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  auto valid = magic == shm_format::magic &&
+               _header->version == shm_format::version &&
+               _header->data_offset +
+                       _header->capacity * _header->slot_size <=
+                   _size;
+  if (!valid) {
+    munmap(_memory, _size);
+    throw OutputError(
+        fmt::format(R"("{}" is not a live statistics stream)", path));
+  }
+
+  const auto *names = static_cast<const char *>(_memory) +
+                      sizeof(shm_format::Header);
+  for (std::uint32_t i = 0; i < _header->columns; ++i) {
+    std::uint16_t length = 0;
+    std::memcpy(&length, names, sizeof(length));
+    _columns.emplace_back(names + sizeof(length), length);
+    names += sizeof(length) + length;
+  }
+}
+
+ShmReader::~ShmReader() { munmap(_memory, _size); }
+
+bool ShmReader::next(Sample &sample) {
+  auto capacity = _header->capacity;
+  sample.values.resize(_columns.size());
+
+  while (true) {
+    auto written = _header->write_index.load(std::memory_order_acquire);
+    if (_index == written) {
+      return false;
+    }
+
+    // Oldest samples are already overwritten
+    if (written - _index > capacity) {
+      _lost += written - capacity - _index;
+      _index = written - capacity;
+    }
+
+    const auto *current = slot(_index);
+    auto before = current->sequence.load(std::memory_order_acquire);
+
+    sample.time = current->time;
+    std::memcpy(sample.values.data(),
+                reinterpret_cast<const char *>(current) +  // NOLINT
+                    sizeof(shm_format::Slot),
+                _columns.size() * sizeof(double));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    auto after = current->sequence.load(std::memory_order_relaxed);
+
+    if (before == _index + 1 && after == before) {
+      sample.sequence = _index++;
+      return true;
+    }
+
+    // Slot is overwritten while copied, the sample is lost
+    ++_lost;
+    ++_index;
+  }
+}
+
+bool ShmReader::closed() const noexcept {
+  return _header->closed.load(std::memory_order_acquire) != 0;
+}
+
+auto ShmReader::slot(std::uint64_t index) const noexcept
+    -> const shm_format::Slot * {
+  const auto *data = static_cast<const char *>(_memory) + _header->data_offset;
+  // NOLINTNEXTLINE
+  return reinterpret_cast<const shm_format::Slot *>(
+      data + (index & (_header->capacity - 1)) * _header->slot_size);
+}
+
+}  // namespace stats
@@ -0,0 +1,80 @@
+#ifndef __SHM_READER_H_W9D4KB2FNQ6S__
+#define __SHM_READER_H_W9D4KB2FNQ6S__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "stats/shm_format.h"
+
+namespace stats {
+
+/**
+ * @brief Reads live statistics published by ShmWriter
+ *
+ * Reader doesn't change the segment, any number of readers can follow one
+ * stream.
+ */
+class ShmReader {
+ public:
+  struct Sample {
+    // Index of sample in the stream, from 0
+    std::uint64_t sequence = 0;
+    std::int64_t time = 0;
+    std::vector<double> values;
+  };
+
+  /**
+   * @brief Open shared memory segment
+   *
+   * @param name segment name, "/" is prepended if missing
+   * @throws OutputError if segment doesn't exist or has wrong format
+   */
+  explicit ShmReader(const std::string &name);
+  ~ShmReader();
+
+  ShmReader(const ShmReader &) = delete;
+  ShmReader &operator=(const ShmReader &) = delete;
+
+  auto columns() const -> const std::vector<std::string> & { return _columns; }
+
+  auto seconds_per_step() const noexcept -> double {
+    return _header->seconds_per_step;
+  }
+
+  /**
+   * @brief Read next sample
+   *
+   * @param sample
+   * @return true if sample is read, false if there are no new samples
+   */
+  bool next(Sample &sample);
+
+  /**
+   * @brief Whether writer has published the last sample
+   *
+   * Samples published before closing can still be read by next().
+   */
+  bool closed() const noexcept;
+
+  /**
+   * @brief Number of samples overwritten before they were read
+   *
+   */
+  auto lost() const noexcept -> std::uint64_t { return _lost; }
+
+ private:
+  auto slot(std::uint64_t index) const noexcept -> const shm_format::Slot *;
+
+  std::size_t _size = 0;
+  void *_memory = nullptr;
+  const shm_format::Header *_header = nullptr;
+  std::vector<std::string> _columns;
+  std::uint64_t _index = 0;
+  std::uint64_t _lost = 0;
+};
+
+}  // namespace stats
+
+#endif  // __SHM_READER_H_W9D4KB2FNQ6S__
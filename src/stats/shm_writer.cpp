@@ -0,0 +1,138 @@
+#include "shm_writer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <fmt/core.h>
+
+namespace stats {
+
+namespace {
+auto round_up_pow2(std::size_t value) noexcept -> std::size_t {
+  std::size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+auto align_up(std::size_t value, std::size_t alignment) noexcept
+    -> std::size_t {
+  return (value + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+ShmWriter::ShmWriter(const std::string &name, std::vector<std::string> columns,
+                     double seconds_per_step, std::size_t capacity)
+    : Writer{std::move(columns)},
+      _name{name.rfind('/', 0) == 0 ? name : '/' + name} {
+  capacity = round_up_pow2(std::max<std::size_t>(capacity, 1));
+
+  auto names_size = std::size_t{0};
+  for (const auto &column : this->columns()) {
+    names_size += sizeof(std::uint16_t) + column.size();
+  }
+
+  auto columns_count = static_cast<std::uint32_t>(this->columns().size());
+  auto slot_size = shm_format::slot_size(columns_count);
+  auto data_offset =
+      align_up(sizeof(shm_format::Header) + names_size, shm_format::cache_line);
+  _size = data_offset + capacity * slot_size;
+
+  // Segment of the previous run is replaced, its readers keep the old one
+  shm_unlink(_name.c_str());
+
+  // NOLINTNEXTLINE
+  auto fd = shm_open(_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (fd < 0) {
+    throw OutputError(fmt::format(R"(Can't create shared memory "{}": {})",
+                                  _name, std::strerror(errno)));
+  }
+
+  if (ftruncate(fd, static_cast<off_t>(_size)) != 0) {
+    auto error = errno;
+    ::close(fd);
+    shm_unlink(_name.c_str());
+    throw OutputError(fmt::format(R"(Can't resize shared memory "{}": {})",
+                                  _name, std::strerror(error)));
+  }
+
+  _memory = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (_memory == MAP_FAILED) {  // NOLINT
+    shm_unlink(_name.c_str());
+    throw OutputError(fmt::format(R"(Can't map shared memory "{}": {})",
+                                  _name, std::strerror(errno)));
+  }
+
+  // New segment is zero filled: all slots are empty
+  _header = new (_memory) shm_format::Header{};
+  _header->version = shm_format::version;
+  _header->columns = columns_count;
+  _header->capacity = capacity;
+  _header->slot_size = slot_size;
+  _header->data_offset = static_cast<std::uint32_t>(data_offset);
+  _header->seconds_per_step = seconds_per_step;
+
+  auto *names = static_cast<char *>(_memory) + sizeof(shm_format::Header);
+  for (const auto &column : this->columns()) {
+    auto length = static_cast<std::uint16_t>(column.size());
+    std::memcpy(names, &length, sizeof(length));
+    std::memcpy(names + sizeof(length), column.data(), column.size());
+    names += sizeof(length) + column.size();
+  }
+
+  _mask = capacity - 1;
+
+  std::atomic_thread_fence(std::memory_order_release);
+  _header->magic = shm_format::magic;
+}
+
+ShmWriter::~ShmWriter() {
+  _header->closed.store(1, std::memory_order_release);
+  munmap(_memory, _size);
+  shm_unlink(_name.c_str());
+}
+
+void ShmWriter::write(std::int64_t time, const double *values) {
+  auto *current = slot(_index);
+
+  // Readers that copy the slot now see it is being changed
+  current->sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  current->time = time;
+  std::memcpy(reinterpret_cast<char *>(current) +  // NOLINT
+                  sizeof(shm_format::Slot),
+              values, columns().size() * sizeof(double));
+
+  ++_index;
+  current->sequence.store(_index, std::memory_order_release);
+  _header->write_index.store(_index, std::memory_order_release);
+}
+
+auto ShmWriter::segment_name(const std::string &prefix,
+                             const std::string &file_name) -> std::string {
+  auto name = fmt::format("{}-{}", prefix, file_name);
+
+  // Segment name can't have slashes except the leading one
+  auto begin = name.front() == '/' ? name.begin() + 1 : name.begin();
+  std::replace(begin, name.end(), '/', '_');
+  return name;
+}
+
+auto ShmWriter::slot(std::uint64_t index) noexcept -> shm_format::Slot * {
+  auto *data = static_cast<char *>(_memory) + _header->data_offset;
+  // NOLINTNEXTLINE
+  return reinterpret_cast<shm_format::Slot *>(
+      data + (index & _mask) * _header->slot_size);
+}
+
+}  // namespace stats
@@ -0,0 +1,68 @@
+#ifndef __SHM_WRITER_H_T5N1XC8LPV3E__
+#define __SHM_WRITER_H_T5N1XC8LPV3E__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "stats/shm_format.h"
+#include "stats/writer.h"
+
+namespace stats {
+
+/**
+ * @brief Publishes rows to shared memory ring for live local readers
+ *
+ * Writer never waits for readers, slow readers lose the oldest rows (see
+ * shm_format.h).
+ */
+class ShmWriter final : public Writer {
+ public:
+  static constexpr std::size_t default_capacity = 1 << 16;
+
+  /**
+   * @brief Create (replace) shared memory segment
+   *
+   * @param name segment name, "/" is prepended if missing
+   * @param columns
+   * @param seconds_per_step
+   * @param capacity number of rows kept, rounded up to power of two
+   * @throws OutputError if segment can't be created
+   */
+  ShmWriter(const std::string &name, std::vector<std::string> columns,
+            double seconds_per_step, std::size_t capacity = default_capacity);
+
+  /**
+   * @brief Mark stream closed and remove the segment name
+   *
+   */
+  ~ShmWriter() override;
+
+  void write(std::int64_t time, const double *values) override;
+
+  void flush() override {}
+
+  auto name() const -> const std::string & { return _name; }
+
+  /**
+   * @brief Segment name for statistics output "<prefix>-<file name>"
+   *
+   */
+  static auto segment_name(const std::string &prefix,
+                           const std::string &file_name) -> std::string;
+
+ private:
+  auto slot(std::uint64_t index) noexcept -> shm_format::Slot *;
+
+  std::string _name;
+  std::size_t _size = 0;
+  void *_memory = nullptr;
+  shm_format::Header *_header = nullptr;
+  std::uint64_t _mask = 0;
+  std::uint64_t _index = 0;
+};
+
+}  // namespace stats
+
+#endif  // __SHM_WRITER_H_T5N1XC8LPV3E__
@@ -0,0 +1,100 @@
+#ifndef __SPSC_RING_H_M3E8XQ1TBW6K__
+#define __SPSC_RING_H_M3E8XQ1TBW6K__
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace stats {
+
+/**
+ * @brief Lock-free single-producer/single-consumer ring buffer
+ *
+ * Items are pushed in groups which become visible to the consumer at once.
+ */
+template <typename T>
+class SpscRing {
+ public:
+  /**
+   * @brief Construct ring buffer
+   *
+   * @param capacity capacity in items, rounded up to the power of two
+   */
+  explicit SpscRing(std::size_t capacity) : _buffer(round_up(capacity)) {
+    _mask = _buffer.size() - 1;
+  }
+
+  /**
+   * @brief Push all `count` items or nothing, called by producer only
+   *
+   * @return false if there is no space for all items
+   */
+  bool try_push(const T *items, std::size_t count) noexcept {
+    auto tail = _tail.load(std::memory_order_relaxed);
+
+    if (_buffer.size() - (tail - _cached_head) < count) {
+      _cached_head = _head.load(std::memory_order_acquire);
+      if (_buffer.size() - (tail - _cached_head) < count) {
+        return false;
+      }
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+      _buffer[(tail + i) & _mask] = items[i];
+    }
+
+    _tail.store(tail + count, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Pop up to `max` items, called by consumer only
+   *
+   * @return std::size_t number of popped items
+   */
+  auto try_pop(T *items, std::size_t max) noexcept -> std::size_t {
+    auto head = _head.load(std::memory_order_relaxed);
+    auto tail = _tail.load(std::memory_order_acquire);
+
+    auto count = std::min(max, tail - head);
+    for (std::size_t i = 0; i < count; ++i) {
+      items[i] = _buffer[(head + i) & _mask];
+    }
+
+    _head.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  bool empty() const noexcept {
+    return _head.load(std::memory_order_acquire) ==
+           _tail.load(std::memory_order_acquire);
+  }
+
+  auto capacity() const noexcept -> std::size_t { return _buffer.size(); }
+
+ private:
+  static constexpr std::size_t cache_line = 64;
+
+  static auto round_up(std::size_t capacity) noexcept -> std::size_t {
+    std::size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+  std::vector<T> _buffer;
+  std::size_t _mask;
+
+  // Consumer position
+  alignas(cache_line) std::atomic<std::size_t> _head{0};
+
+  // Producer position and its view of the consumer position
+  alignas(cache_line) std::atomic<std::size_t> _tail{0};
+  std::size_t _cached_head = 0;
+};
+
+}  // namespace stats
+
+#endif  // __SPSC_RING_H_M3E8XQ1TBW6K__
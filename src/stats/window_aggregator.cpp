@@ -0,0 +1,130 @@
+#include "window_aggregator.h"
+
+#include <algorithm>
+#include <charconv>
+#include <utility>
+
+namespace stats {
+
+auto statistic_from_string(const std::string &str) -> std::optional<Statistic> {
+  using kind = statistic_kind;
+
+  if (str == "count") {
+    return Statistic{.kind = kind::count, .name = str};
+  }
+  if (str == "sum") {
+    return Statistic{.kind = kind::sum, .name = str};
+  }
+  if (str == "mean") {
+    return Statistic{.kind = kind::mean, .name = str};
+  }
+  if (str == "min") {
+    return Statistic{.kind = kind::min, .name = str};
+  }
+  if (str == "max") {
+    return Statistic{.kind = kind::max, .name = str};
+  }
+
+  if (str.size() < 2 || str.front() != 'p') {
+    return {};
+  }
+
+  double percentile = 0;
+  const auto *end = str.data() + str.size();
+  auto [ptr, error] = std::from_chars(str.data() + 1, end, percentile);
+  if (error != std::errc{} || ptr != end || percentile <= 0 ||
+      percentile > 100) {
+    return {};
+  }
+
+  return Statistic{
+      .kind = kind::quantile, .quantile = percentile / 100, .name = str};
+}
+
+WindowAggregator::WindowAggregator(std::int64_t window,
+                                   std::vector<Statistic> statistics,
+                                   std::unique_ptr<Writer> output)
+    : Writer{{"value"}},
+      _window{std::max<std::int64_t>(window, 1)},
+      _statistics{std::move(statistics)},
+      _output{std::move(output)},
+      _row(_statistics.size()) {
+  _has_quantiles =
+      std::any_of(_statistics.begin(), _statistics.end(), [](const auto &stat) {
+        return stat.kind == statistic_kind::quantile;
+      });
+}
+
+void WindowAggregator::write(std::int64_t time, const double *values) {
+  auto window = time / _window;
+  if (_count != 0 && window != _current) {
+    write_window();
+  }
+  _current = window;
+
+  auto value = values[0];
+  if (_count == 0) {
+    _min = _max = value;
+  } else {
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+  }
+  _sum += value;
+  ++_count;
+
+  if (_has_quantiles) {
+    _histogram.add(value);
+  }
+}
+
+void WindowAggregator::flush() {
+  if (_count != 0) {
+    write_window();
+  }
+  _output->flush();
+}
+
+auto WindowAggregator::columns(const std::string &value_name,
+                               const std::vector<Statistic> &statistics)
+    -> std::vector<std::string> {
+  std::vector<std::string> names;
+  names.reserve(statistics.size());
+  for (const auto &stat : statistics) {
+    names.push_back(value_name + "_" + stat.name);
+  }
+  return names;
+}
+
+void WindowAggregator::write_window() {
+  for (std::size_t i = 0; i < _statistics.size(); ++i) {
+    const auto &stat = _statistics[i];
+    switch (stat.kind) {
+      case statistic_kind::count:
+        _row[i] = static_cast<double>(_count);
+        break;
+      case statistic_kind::sum:
+        _row[i] = _sum;
+        break;
+      case statistic_kind::mean:
+        _row[i] = _sum / static_cast<double>(_count);
+        break;
+      case statistic_kind::min:
+        _row[i] = _min;
+        break;
+      case statistic_kind::max:
+        _row[i] = _max;
+        break;
+      case statistic_kind::quantile:
+        _row[i] = _histogram.quantile(stat.quantile);
+        break;
+    }
+  }
+
+  _output->write((_current + 1) * _window, _row.data());
+
+  _count = 0;
+  _sum = 0;
+  _histogram.reset();
+}
+
+}  // namespace stats
@@ -0,0 +1,88 @@
+#ifndef __WINDOW_AGGREGATOR_H_C8J2WF5LYT1R__
+#define __WINDOW_AGGREGATOR_H_C8J2WF5LYT1R__
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "stats/histogram.h"
+#include "stats/writer.h"
+
+namespace stats {
+
+enum class statistic_kind { count, sum, mean, min, max, quantile };
+
+/**
+ * @brief Summary statistic of the window
+ *
+ */
+struct Statistic {
+  statistic_kind kind;
+  // Quantile in [0, 1] for kind::quantile
+  double quantile = 0;
+  // Name as written in the model description: "mean", "p99.9"
+  std::string name;
+};
+
+/**
+ * @brief Parse statistic name: count, sum, mean, min, max or pN, where N is
+ * percentile in (0, 100]
+ *
+ */
+auto statistic_from_string(const std::string &str) -> std::optional<Statistic>;
+
+/**
+ * @brief Replaces samples by one row of statistics per time window
+ *
+ * Takes rows of one value, writes one row of statistics per each window with
+ * samples. Row time is the end of the window. The last incomplete window is
+ * written on flush.
+ */
+class WindowAggregator final : public Writer {
+ public:
+  /**
+   * @brief Construct aggregator
+   *
+   * @param window window length in simulator time steps
+   * @param statistics statistics to write
+   * @param output writer with columns for each statistic
+   */
+  WindowAggregator(std::int64_t window, std::vector<Statistic> statistics,
+                   std::unique_ptr<Writer> output);
+
+  void write(std::int64_t time, const double *values) override;
+
+  void flush() override;
+
+  /**
+   * @brief Names of output columns, "<value_name>_<statistic>"
+   *
+   */
+  static auto columns(const std::string &value_name,
+                      const std::vector<Statistic> &statistics)
+      -> std::vector<std::string>;
+
+ private:
+  void write_window();
+
+  std::int64_t _window;
+  std::vector<Statistic> _statistics;
+  std::unique_ptr<Writer> _output;
+
+  bool _has_quantiles = false;
+  std::int64_t _current = 0;
+
+  std::uint64_t _count = 0;
+  double _sum = 0;
+  double _min = 0;
+  double _max = 0;
+  Histogram _histogram;
+
+  std::vector<double> _row;
+};
+
+}  // namespace stats
+
+#endif  // __WINDOW_AGGREGATOR_H_C8J2WF5LYT1R__
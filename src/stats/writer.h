@@ -0,0 +1,93 @@
+#ifndef __WRITER_H_K8C2RV5ZT0LE__
+#define __WRITER_H_K8C2RV5ZT0LE__
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+namespace stats {
+
+enum class output_format { csv, binary };
+
+/**
+ * @brief Behaviour of asynchronous output on full queue
+ *
+ */
+enum class overflow_policy { block, drop };
+
+class OutputError : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Sink of statistics rows
+ *
+ * Row consists of time in simulator time steps and values of columns.
+ */
+class Writer {
+ public:
+  explicit Writer(std::vector<std::string> columns)
+      : _columns{std::move(columns)} {}
+
+  virtual ~Writer() = default;
+
+  Writer(const Writer &) = delete;
+  Writer &operator=(const Writer &) = delete;
+
+  /**
+   * @brief Write one row
+   *
+   * @param time time in simulator time steps
+   * @param values array of `columns().size()` values
+   */
+  virtual void write(std::int64_t time, const double *values) = 0;
+
+  /**
+   * @brief Write buffered rows to the output
+   *
+   */
+  virtual void flush() = 0;
+
+  auto columns() const -> const std::vector<std::string> & { return _columns; }
+
+ private:
+  std::vector<std::string> _columns;
+};
+
+inline auto output_format_from_string(const std::string &str) noexcept
+    -> std::optional<output_format> {
+  auto format = boost::algorithm::to_lower_copy(str);
+  if (format == "csv") {
+    return output_format::csv;
+  }
+
+  if (format == "binary") {
+    return output_format::binary;
+  }
+
+  return {};
+}
+
+inline auto overflow_policy_from_string(const std::string &str) noexcept
+    -> std::optional<overflow_policy> {
+  auto policy = boost::algorithm::to_lower_copy(str);
+  if (policy == "block") {
+    return overflow_policy::block;
+  }
+
+  if (policy == "drop") {
+    return overflow_policy::drop;
+  }
+
+  return {};
+}
+
+}  // namespace stats
+
+#endif  // __WRITER_H_K8C2RV5ZT0LE__
@@ -0,0 +1,74 @@
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "profiling/alloc_counter.h"
+
+namespace alloc = profiling::alloc;
+
+// Allocation hooks are not linked into tests, so counters change only by
+// direct calls and every test releases what it allocates
+
+TEST(AllocCounter, PhaseScopeRestoresPhase) {  // NOLINT
+  auto previous = alloc::set_phase(alloc::phase::parse);
+  {
+    alloc::PhaseScope scope{alloc::phase::build};
+    EXPECT_EQ(alloc::current_phase(), alloc::phase::build);
+  }
+  EXPECT_EQ(alloc::current_phase(), alloc::phase::parse);
+
+  EXPECT_EQ(alloc::set_phase(previous), alloc::phase::parse);
+}
+
+TEST(AllocCounter, CountsAllocationsAndPeakPerPhase) {  // NOLINT
+  alloc::enable();
+  alloc::PhaseScope scope{alloc::phase::routing};
+  auto total = alloc::snapshot();
+
+  alloc::on_alloc(100, 128);
+  alloc::on_alloc(50, 64);
+  alloc::on_free(128);
+  alloc::on_alloc(10, 16);
+
+  auto routing = alloc::snapshot(alloc::phase::routing);
+  EXPECT_EQ(routing.count, 3);
+  EXPECT_EQ(routing.bytes, 160);
+  // 128 + 64 live before the first block is released
+  EXPECT_EQ(routing.peak, 192);
+
+  EXPECT_EQ(alloc::snapshot().count, total.count + 3);
+  EXPECT_EQ(alloc::snapshot().bytes, total.bytes + 160);
+
+  alloc::on_free(64);
+  alloc::on_free(16);
+}
+
+TEST(AllocCounter, FreeOfUncountedBlockIsIgnored) {  // NOLINT
+  alloc::enable();
+  alloc::PhaseScope scope{alloc::phase::run};
+
+  // Block allocated before counting was enabled
+  alloc::on_free(1000);
+  alloc::on_alloc(10, 16);
+
+  EXPECT_EQ(alloc::snapshot(alloc::phase::run).peak, 16);
+
+  alloc::on_free(16);
+}
+
+TEST(AllocCounter, ReportPrintsPhasesWithAllocations) {  // NOLINT
+  alloc::enable();
+  {
+    alloc::PhaseScope scope{alloc::phase::build};
+    alloc::on_alloc(2048, 2048);
+    alloc::on_free(2048);
+  }
+
+  std::ostringstream out;
+  alloc::report(out);
+
+  EXPECT_NE(out.str().find("phase"), std::string::npos);
+  EXPECT_NE(out.str().find("build"), std::string::npos);
+  EXPECT_EQ(out.str().find("none"), std::string::npos);
+}
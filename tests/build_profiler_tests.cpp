@@ -0,0 +1,41 @@
+#include <algorithm>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "profiling/build_profiler.h"
+
+using profiling::BuildProfiler;
+using profiling::ScopedPhase;
+
+TEST(BuildProfiler, AccumulatesPhases) {  // NOLINT
+  auto &profiler = BuildProfiler::instance();
+  profiler.enable();
+
+  for (int i = 0; i < 2; ++i) {
+    ScopedPhase outer{"test"};
+    ScopedPhase inner{"test/inner"};
+  }
+
+  const auto &phases = profiler.phases();
+
+  auto outer = std::find_if(phases.begin(), phases.end(), [](const auto &p) {
+    return p.first == "test";
+  });
+  auto inner = std::find_if(phases.begin(), phases.end(), [](const auto &p) {
+    return p.first == "test/inner";
+  });
+
+  ASSERT_NE(outer, phases.end());
+  ASSERT_NE(inner, phases.end());
+
+  // Parent phase is reported before nested one
+  EXPECT_LT(outer, inner);
+  EXPECT_EQ(outer->second.calls, 2);
+  EXPECT_EQ(inner->second.calls, 2);
+  EXPECT_GE(outer->second.wall, inner->second.wall);
+}
+
+TEST(BuildProfiler, ReadsRss) {  // NOLINT
+  EXPECT_GT(profiling::current_rss(), 0);
+}
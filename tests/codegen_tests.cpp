@@ -0,0 +1,77 @@
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "codegen/codegen.h"
+#include "parser/parser.h"
+
+namespace {
+auto make_description() -> parser::ModelDescription {
+  parser::ModelDescription description;
+  description.model_name = "echo";
+  description.nodes = {
+      {.name = "client",
+       .devices = {{.name = "eth0", .type = "PPP"}},
+       .applications = {{.name = "client",
+                         .type = "ns3::UdpEchoClient",
+                         .attributes = {{"RemotePort", "9"}}}}},
+      {.name = "server", .devices = {{.name = "eth0", .type = "PPP"}}}};
+  description.connections = {{.name = "link",
+                              .type = model::channel_type::PPP,
+                              .interfaces = {"client/eth0", "server/eth0"}}};
+  return description;
+}
+}  // namespace
+
+TEST(Codegen, WritesTypedConstruction) {  // NOLINT
+  auto description = make_description();
+  description.nodes[0].devices[0].attributes = {{"DataRate", "5Mbps"}};
+  description.connections[0].attributes = {{"Delay", "2ms"}};
+
+  std::ostringstream source;
+  codegen::generate(description, source);
+  const auto code = source.str();
+
+  for (const auto *expected :
+       {"ns3::CreateObject<ns3::PointToPointNetDevice>()",
+        "ns3::DataRateValue{ns3::DataRate{5000000U}}",
+        "ns3::CreateObject<ns3::UdpEchoClient>()",
+        R"(SetAttribute("RemotePort", ns3::UintegerValue{9U}))",
+        "ns3::CreateObject<ns3::PointToPointChannel>()",
+        "ns3::TimeValue{ns3::Time::From(",
+        "model.nodes()[1]->get_device(0).attach(connection)",
+        "model.build_from_nodes(make_description())", "int main()"}) {
+    EXPECT_NE(code.find(expected), std::string::npos) << expected;
+  }
+
+  EXPECT_EQ(code.find("build_from_description"), std::string::npos);
+}
+
+TEST(Codegen, BadConnectionIsReported) {  // NOLINT
+  auto description = make_description();
+  description.connections[0].interfaces[1] = "server/eth1";
+
+  std::ostringstream source;
+  EXPECT_THROW(codegen::generate(description, source), codegen::CodegenError);
+
+  description = make_description();
+  description.connections[0].type = model::channel_type::CSMA;
+  EXPECT_THROW(codegen::generate(description, source), codegen::CodegenError);
+
+  description = make_description();
+  description.nodes[0].devices[0].attributes["Mtu"] = "mtu";
+  EXPECT_THROW(codegen::generate(description, source), codegen::CodegenError);
+}
+
+TEST(Codegen, UnknownApplicationIsReported) {  // NOLINT
+  auto description = make_description();
+  description.nodes[0].applications[0].type = "ns3::UnknownApplication";
+
+  std::ostringstream source;
+  EXPECT_THROW(codegen::generate(description, source), codegen::CodegenError);
+
+  description = make_description();
+  description.nodes[0].applications[0].attributes["RemotePort"] = "port";
+  EXPECT_THROW(codegen::generate(description, source), codegen::CodegenError);
+}
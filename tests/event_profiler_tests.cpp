@@ -0,0 +1,74 @@
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ns3/nstime.h>
+#include <ns3/simulator.h>
+
+#include "model/model.h"
+#include "profiling/event_profiler.h"
+
+namespace profiler_test {
+struct Counter {
+  void tick() { ++ticks; }
+
+  int ticks = 0;
+};
+}  // namespace profiler_test
+
+TEST(EventProfiler, HandlerClassOfMemberFunction) {  // NOLINT
+  using profiling::handler_class;
+
+  EXPECT_EQ(handler_class("ns3::MakeEvent<void (ns3::UdpEchoClient::*)(), "
+                          "ns3::UdpEchoClient*>(...)::EventMemberImpl0"),
+            "ns3::UdpEchoClient");
+  EXPECT_EQ(handler_class("ns3::MakeEvent<void ((anonymous namespace)::"
+                          "Client::*)()>(...)::EventMemberImpl0"),
+            "(anonymous namespace)::Client");
+  EXPECT_EQ(
+      handler_class("ns3::MakeEvent<void (*)()>(...)::EventFunctionImpl0"),
+      "");
+}
+
+TEST(EventProfiler, CountsEventsPerContextAndHandler) {  // NOLINT
+  // Implementation can be set only before the simulator is created
+  ns3::Simulator::Destroy();
+  auto profiler = profiling::EventProfiler::install();
+
+  profiler_test::Counter counter;
+  constexpr auto context = 7;
+  for (int i = 0; i < 3; ++i) {
+    ns3::Simulator::Schedule(ns3::Seconds(i), &profiler_test::Counter::tick,
+                             &counter);
+  }
+  for (int i = 0; i < 2; ++i) {
+    ns3::Simulator::ScheduleWithContext(
+        context, ns3::Seconds(i), &profiler_test::Counter::tick, &counter);
+  }
+  ns3::Simulator::Run();
+  EXPECT_EQ(counter.ticks, 5);
+
+  auto path = std::filesystem::temp_directory_path() / "event_profile.json";
+  {
+    // Model has no nodes, so contexts are not resolved to names
+    model::Model model;
+    profiler->write_profile(model, path);
+  }
+
+  std::ifstream in{path};
+  std::string profile{std::istreambuf_iterator<char>{in}, {}};
+  std::filesystem::remove(path);
+
+  EXPECT_NE(profile.find(R"("node":"-","source":"profiler_test::Counter",)"
+                         R"("events":3)"),
+            std::string::npos)
+      << profile;
+  EXPECT_NE(profile.find(R"("node":"#7","source":"profiler_test::Counter",)"
+                         R"("events":2)"),
+            std::string::npos)
+      << profile;
+  EXPECT_NE(profile.find(R"({"events":5,)"), std::string::npos) << profile;
+}
@@ -0,0 +1,81 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "model/channel.h"
+#include "parser/model_builder.h"
+#include "parser/parser.h"
+
+TEST(ModelBuilder, BuildsDescription) {  // NOLINT
+  parser::ModelBuilder builder{"model"};
+  builder.duration("10s").populate_routing_tables();
+  builder.node("client")
+      .device("eth0", "Csma", {{"Mtu", "1200"}})
+      .address("10.0.0.1", "255.255.255.0")
+      .address("2001::1", 64)
+      .application("echo", "ns3::UdpEchoClient", {{"RemotePort", "9"}});
+  builder.node("server")
+      .device("eth0", "Csma")
+      .address("10.0.0.2", "255.255.255.0")
+      .end()
+      .connect("lan", model::channel_type::CSMA,
+               {"client/eth0", "server/eth0"}, {{"Delay", "1ms"}});
+
+  auto description = builder.build();
+
+  EXPECT_EQ(description.model_name, "model");
+  EXPECT_EQ(description.end_time, "10s");
+  EXPECT_TRUE(description.polulate_tables);
+  ASSERT_EQ(description.nodes.size(), 2);
+
+  const auto &client = description.nodes.front();
+  ASSERT_EQ(client.devices.size(), 1);
+  EXPECT_EQ(client.devices.front().attributes.at("Mtu"), "1200");
+  ASSERT_EQ(client.devices.front().ipv4_addresses.size(), 1);
+  EXPECT_EQ(client.devices.front().ipv4_addresses.front().to_string(),
+            "10.0.0.1/24");
+  ASSERT_EQ(client.devices.front().ipv6_addresses.size(), 1);
+  EXPECT_EQ(client.devices.front().ipv6_addresses.front().prefix_length(), 64);
+  ASSERT_EQ(client.applications.size(), 1);
+  EXPECT_EQ(client.applications.front().type, "ns3::UdpEchoClient");
+
+  ASSERT_EQ(description.connections.size(), 1);
+  EXPECT_EQ(description.connections.front().interfaces,
+            (std::vector<std::string>{"client/eth0", "server/eth0"}));
+
+  EXPECT_TRUE(builder.description().nodes.empty());
+}
+
+TEST(ModelBuilder, ReportsBadReferences) {  // NOLINT
+  parser::ModelBuilder builder{"model"};
+  builder.node("a").device("eth0", "PPP");
+  builder.node("b").device("eth0", "PPP").device("eth1", "PPP");
+
+  EXPECT_THROW(builder.node("a"), parser::ParseError);
+  EXPECT_THROW(builder.node("c").device("eth0", "PPP").device("eth0", "PPP"),
+               parser::ParseError);
+  EXPECT_THROW(builder.node("d").address("10.0.0.1", "255.255.255.0"),
+               parser::ParseError);
+  EXPECT_THROW(builder.node("e").device("eth0", "PPP").address("10.0.0", "24"),
+               parser::ParseError);
+
+  EXPECT_THROW(builder.connect("link", model::channel_type::PPP,
+                               {"a/eth0", "b/eth9"}),
+               parser::ParseError);
+  EXPECT_THROW(builder.connect("link", model::channel_type::PPP,
+                               {"a/eth0", "unknown/eth0"}),
+               parser::ParseError);
+
+  builder.connect("link", model::channel_type::PPP, {"a/eth0", "b/eth0"});
+  EXPECT_THROW(builder.connect("link", model::channel_type::PPP,
+                               {"b/eth1", "c/eth0"}),
+               parser::ParseError);
+  EXPECT_THROW(builder.connect("other", model::channel_type::PPP,
+                               {"a/eth0", "b/eth1"}),
+               parser::ParseError);
+
+  EXPECT_THROW(
+      builder.background_flow({.name = "flow", .source = "unknown"}),
+      parser::ParseError);
+}
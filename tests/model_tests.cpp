@@ -1,15 +1,31 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include <boost/asio/ip/address_v6.hpp>
 #include <boost/asio/ip/network_v4.hpp>
 
+#include <ns3/arp-cache.h>
 #include <ns3/attribute.h>
+#include <ns3/callback.h>
 #include <ns3/channel-list.h>
 #include <ns3/config.h>
+#include <ns3/csma-channel.h>
 #include <ns3/csma-net-device.h>
+#include <ns3/data-rate.h>
 #include <ns3/event-id.h>
+#include <ns3/inet-socket-address.h>
 #include <ns3/ipv4-address.h>
 #include <ns3/ipv4-interface-address.h>
+#include <ns3/ipv4-interface.h>
+#include <ns3/ipv4-l3-protocol.h>
 #include <ns3/ipv4.h>
 #include <ns3/ipv6.h>
 #include <ns3/mac48-address.h>
@@ -18,20 +34,27 @@
 #include <ns3/node-list.h>
 #include <ns3/nstime.h>
 #include <ns3/object.h>
+#include <ns3/packet.h>
 #include <ns3/pointer.h>
+#include <ns3/simulator.h>
 #include <ns3/string.h>
 #include <ns3/uinteger.h>
 
 #include <gtest/gtest.h>
 
+#include "applications/burst_source.h"
+#include "applications/latency_sink.h"
 #include "model/application.h"
+#include "model/background_traffic.h"
 #include "model/channel.h"
 #include "model/device.h"
 #include "model/model.h"
 #include "model/model_build_error.h"
 #include "model/name_service.h"
 #include "model/node.h"
+#include "model/polling_registrator.h"
 #include "model/registrator.h"
+#include "model/topology.h"
 #include "parser/parser.h"
 #include "utils/address.h"
 
@@ -349,6 +372,44 @@ TEST_F(ModelTest, BuildModel) {  // NOLINT
       registrators.at(0)->get_event_id().PeekEventImpl()->IsCancelled());
 }
 
+TEST_F(ModelTest, BuildModelFromAddedNodes) {  // NOLINT
+  model::Model model;
+  for (const auto *name : {"node_a", "node_b"}) {
+    auto node = model::Node::create_empty(name);
+    auto device = ns3::CreateObject<ns3::CsmaNetDevice>();
+    device->SetAddress(ns3::Mac48Address::Allocate());
+    device->SetAttribute("Mtu", ns3::UintegerValue{442});
+    node->attach(
+        model::Device{device, "eth0", model::device_type::CSMA, {}, {}});
+    model.add_node(std::move(node));
+  }
+
+  auto channel = model::Channel::create(ns3::CreateObject<ns3::CsmaChannel>(),
+                                        "lan", model::channel_type::CSMA);
+  for (const auto &node : model.nodes()) {
+    node->get_device(0).attach(channel);
+  }
+
+  parser::RegistratorDescription registrator_desc{
+      .source = "/Names/node_a/eth0/MacTx",
+      .type = "ns3::PacketProbe",
+      .sink = "OutputBytes",
+      .start_time = "1s",
+  };
+
+  parser::ModelDescription model_desc = {.model_name = "model",
+                                         .registrators = {registrator_desc}};
+  model.build_from_nodes(model_desc);
+
+  auto *node_a = model.find_node("node_a");
+  ASSERT_TRUE(node_a != nullptr);
+  EXPECT_TRUE(ns3::Names::Find<ns3::NetDevice>("/Names/node_a/eth0") ==
+              node_a->get_device(0).get());
+  EXPECT_TRUE(node_a->get_device(0).get()->GetChannel() != nullptr);
+  EXPECT_TRUE(ns3::Names::Find<ns3::Channel>("/Names/lan") != nullptr);
+  EXPECT_EQ(model.get_registrators().size(), 1);
+}
+
 TEST_F(ModelTest, ConnectUnknownNode) {  // NOLINT
   parser::NodeDescription node_a_desc = {
       .name = "node_a",
@@ -458,4 +519,712 @@ TEST_F(ModelTest, CreateAndScheduleRegistrator) {  // NOLINT
   ASSERT_TRUE(registrator->get_event_id().PeekEventImpl() != nullptr);
   ASSERT_FALSE(registrator->get_event_id().IsExpired());
   ASSERT_FALSE(registrator->get_event_id().PeekEventImpl()->IsCancelled());
-}
\ No newline at end of file
+}
+TEST_F(ModelTest, PollingRegistratorWritesRowPerPeriod) {  // NOLINT
+  parser::NodeDescription node_desc = {
+      .name = "node",
+      .devices = {parser::DeviceDescription{
+          .name = "eth0",
+          .type = "Csma",
+          .attributes = {{"Mtu", "442"},
+                         {"TxQueue", "ns3::DropTailQueue<Packet>"}}}}};
+  auto node = model::Node::create(node_desc);
+
+  parser::PollerDescription desc = {
+      .file = "poller_test",
+      .period = "1s",
+      .end_time = "2s",
+      .values = {
+          {.name = "mtu", .object = "node/eth0", .attribute = "Mtu"},
+          {.name = "queue", .object = "node/eth0", .getter = "NPackets"}}};
+
+  model::PollingRegistrator poller{desc, ns3::Time{}};
+  poller.shedule_init();
+  ns3::Simulator::Run();
+  poller.flush();
+  ns3::Simulator::Destroy();
+
+  std::ifstream file{"poller_test.txt"};
+  std::string heading;
+  std::getline(file, heading);
+  EXPECT_EQ(heading, "Time,mtu,queue");
+
+  std::vector<std::string> rows;
+  for (std::string row; std::getline(file, row);) {
+    rows.push_back(row);
+  }
+  EXPECT_EQ(rows,
+            (std::vector<std::string>{"0,442,0", "1,442,0", "2,442,0"}));
+
+  std::remove("poller_test.txt");
+}
+
+TEST_F(ModelTest, PollingRegistratorBadValues) {  // NOLINT
+  auto node = model::Node::create({.name = "node"});
+
+  parser::PollerDescription desc = {
+      .file = "poller_test",
+      .period = "1s",
+      .end_time = "2s",
+      .values = {{.name = "x", .object = "unknown", .attribute = "Id"}}};
+  EXPECT_THROW(model::PollingRegistrator(desc, ns3::Time{}),
+               model::ModelBuildError);
+
+  desc.values = {{.name = "x", .object = "node", .attribute = "Unknown"}};
+  EXPECT_THROW(model::PollingRegistrator(desc, ns3::Time{}),
+               model::ModelBuildError);
+
+  desc.values = {{.name = "x", .object = "node", .getter = "TotalRx"}};
+  EXPECT_THROW(model::PollingRegistrator(desc, ns3::Time{}),
+               model::ModelBuildError);
+
+  // No end time
+  desc.values = {{.name = "id", .object = "node", .attribute = "Id"}};
+  desc.end_time.reset();
+  EXPECT_THROW(model::PollingRegistrator(desc, ns3::Time{}),
+               model::ModelBuildError);
+}
+
+TEST_F(ModelTest, WildcardRegistratorSharesOutput) {  // NOLINT
+  std::vector<std::unique_ptr<model::Node>> nodes;
+  for (const auto* name : {"node-1", "node-2", "other"}) {
+    nodes.push_back(model::Node::create(
+        {.name = name,
+         .devices = {parser::DeviceDescription{
+             .name = "eth0",
+             .type = "Csma",
+             .attributes = {{"TxQueue", "ns3::DropTailQueue<Packet>"}}}}}));
+  }
+
+  parser::RegistratorDescription desc = {
+      .source = "/Names/node-*/eth0/TxQueue/PacketsInQueue",
+      .type = "ns3::Uinteger32Probe",
+      .file = "wildcard_test",
+      .start_time = "0s"};
+
+  auto registrator = model::Registrator::create(desc);
+  registrator->shedule_init();
+  ns3::Simulator::Run();
+  registrator->flush();
+  ns3::Simulator::Destroy();
+
+  std::ifstream output{"wildcard_test.txt"};
+  std::string heading;
+  std::getline(output, heading);
+  EXPECT_EQ(heading, "Time,object,value");
+
+  std::ifstream objects{"wildcard_test.objects.txt"};
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(objects, line);) {
+    lines.push_back(line);
+  }
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_EQ(lines[0], "object,path");
+  EXPECT_EQ(lines[1].rfind("0,", 0), 0);
+  EXPECT_EQ(lines[2].rfind("1,", 0), 0);
+
+  std::remove("wildcard_test.txt");
+  std::remove("wildcard_test.objects.txt");
+}
+
+TEST_F(ModelTest, WildcardRegistratorFiltersEachObject) {  // NOLINT
+  std::vector<std::unique_ptr<model::Node>> nodes;
+  for (const auto* name : {"node-1", "node-2"}) {
+    nodes.push_back(model::Node::create(
+        {.name = name,
+         .devices = {parser::DeviceDescription{
+             .name = "eth0",
+             .type = "Csma",
+             .attributes = {{"TxQueue", "ns3::DropTailQueue<Packet>"}}}}}));
+  }
+
+  parser::RegistratorDescription desc = {
+      .source = "/Names/node-*/eth0/TxQueue/PacketsInQueue",
+      .type = "ns3::Uinteger32Probe",
+      .file = "wildcard_filter_test",
+      .start_time = "0s",
+      .end_time = "3s",
+      .min_interval = "1s"};
+
+  auto registrator = model::Registrator::create(desc);
+  registrator->shedule_init();
+
+  // Both queues change at the same moments, each object keeps its samples
+  for (const auto& node : nodes) {
+    auto queue =
+        node->get_device(0).get()->GetObject<ns3::CsmaNetDevice>()->GetQueue();
+    for (auto time : {1.0, 1.5, 2.5}) {
+      ns3::Simulator::Schedule(ns3::Seconds(time), [queue] {
+        queue->Enqueue(ns3::Create<ns3::Packet>(100));
+      });
+    }
+  }
+
+  ns3::Simulator::Run();
+  registrator->flush();
+  ns3::Simulator::Destroy();
+
+  std::ifstream output{"wildcard_filter_test.txt"};
+  std::string line;
+  std::getline(output, line);
+  std::vector<int> samples(2, 0);
+  while (std::getline(output, line)) {
+    auto object = std::stoi(line.substr(line.find(',') + 1));
+    ASSERT_LT(object, 2);
+    ++samples[object];
+  }
+
+  EXPECT_EQ(samples[0], 2);
+  EXPECT_EQ(samples[1], 2);
+  EXPECT_EQ(registrator->samples_seen(), 6);
+  EXPECT_EQ(registrator->samples_dropped(), 2);
+
+  std::remove("wildcard_filter_test.txt");
+  std::remove("wildcard_filter_test.objects.txt");
+}
+
+TEST_F(ModelTest, LatencySinkMeasuresUdpClientPackets) {  // NOLINT
+  auto sink_app = model::Application::create(
+      {.name = "sink",
+       .type = "applications::LatencySink",
+       .attributes = {{"Timestamp", "SeqTsHeader"},
+                      {"Output", "latency_sink_test.csv"}}});
+  auto sink = ns3::DynamicCast<applications::LatencySink>(sink_app.get());
+  ASSERT_TRUE(sink != nullptr);
+
+  parser::ModelDescription model_desc = {
+      .model_name = "model",
+      .nodes = {{.name = "client",
+                 .devices = {{.name = "eth0",
+                              .type = "PPP",
+                              .ipv4_addresses = {asio::ip::make_network_v4(
+                                  "10.10.10.2/24")}}}},
+                {.name = "server",
+                 .devices = {{.name = "eth0",
+                              .type = "PPP",
+                              .ipv4_addresses = {asio::ip::make_network_v4(
+                                  "10.10.10.4/24")}}}}},
+      .connections = {{.name = "link",
+                       .type = model::channel_type::PPP,
+                       .interfaces = {"client/eth0", "server/eth0"},
+                       .attributes = {{"Delay", "5ms"}}}}};
+
+  model::Model model;
+  model.build_from_description(model_desc);
+
+  sink->SetAttribute("Local", ns3::AddressValue(ns3::InetSocketAddress(
+                                  ns3::Ipv4Address::GetAny(), 9)));
+  model.find_node("server")->get()->AddApplication(sink);
+
+  auto client = model::Application::create(
+      {.name = "client",
+       .type = "ns3::UdpClient",
+       .attributes = {{"MaxPackets", "10"}, {"Interval", "100ms"}}});
+  client.get()->SetAttribute(
+      "RemoteAddress", ns3::AddressValue(ns3::Ipv4Address("10.10.10.4")));
+  client.get()->SetAttribute("RemotePort", ns3::UintegerValue(9));
+  model.find_node("client")->get()->AddApplication(client.get());
+
+  ns3::Simulator::Stop(ns3::Seconds(2));
+  ns3::Simulator::Run();
+
+  EXPECT_EQ(sink->GetReceived(), 10);
+  EXPECT_GT(sink->GetLatency(0.5), ns3::MilliSeconds(5));
+  EXPECT_LT(sink->GetLatency(1), ns3::MilliSeconds(10));
+
+  sink->Report();
+  ns3::Simulator::Destroy();
+
+  std::ifstream output{"latency_sink_test.csv"};
+  std::string heading;
+  std::getline(output, heading);
+  EXPECT_EQ(heading.rfind("packets,bytes,untimed,throughput", 0), 0);
+
+  std::string row;
+  std::getline(output, row);
+  EXPECT_EQ(row.rfind("10,", 0), 0);
+
+  std::remove("latency_sink_test.csv");
+}
+
+TEST_F(ModelTest, BurstSourceSendsTimestampedBursts) {  // NOLINT
+  auto sink_app = model::Application::create(
+      {.name = "sink",
+       .type = "applications::LatencySink",
+       .attributes = {{"Timestamp", "Tag"}}});
+  auto sink = ns3::DynamicCast<applications::LatencySink>(sink_app.get());
+  ASSERT_TRUE(sink != nullptr);
+
+  auto source_app = model::Application::create(
+      {.name = "source",
+       .type = "applications::BurstSource",
+       .attributes = {{"DataRate", "1Mb/s"},
+                      {"PacketSize", "500"},
+                      {"BurstSize", "ns3::ConstantRandomVariable[Constant=4]"},
+                      {"MaxBytes", "20000"}}});
+  auto source = ns3::DynamicCast<applications::BurstSource>(source_app.get());
+  ASSERT_TRUE(source != nullptr);
+
+  parser::ModelDescription model_desc = {
+      .model_name = "model",
+      .nodes = {{.name = "client",
+                 .devices = {{.name = "eth0",
+                              .type = "PPP",
+                              .ipv4_addresses = {asio::ip::make_network_v4(
+                                  "10.10.10.2/24")}}}},
+                {.name = "server",
+                 .devices = {{.name = "eth0",
+                              .type = "PPP",
+                              .ipv4_addresses = {asio::ip::make_network_v4(
+                                  "10.10.10.4/24")}}}}},
+      .connections = {{.name = "link",
+                       .type = model::channel_type::PPP,
+                       .interfaces = {"client/eth0", "server/eth0"},
+                       .attributes = {{"Delay", "5ms"}}}}};
+
+  model::Model model;
+  model.build_from_description(model_desc);
+
+  sink->SetAttribute("Local", ns3::AddressValue(ns3::InetSocketAddress(
+                                  ns3::Ipv4Address::GetAny(), 9)));
+  model.find_node("server")->get()->AddApplication(sink);
+
+  source->SetAttribute("Remote", ns3::AddressValue(ns3::InetSocketAddress(
+                                     ns3::Ipv4Address("10.10.10.4"), 9)));
+  model.find_node("client")->get()->AddApplication(source);
+
+  ns3::Simulator::Stop(ns3::Seconds(2));
+  ns3::Simulator::Run();
+
+  EXPECT_EQ(source->GetTotalTx(), 20000);
+  EXPECT_EQ(sink->GetReceived(), 40);
+  EXPECT_GT(sink->GetLatency(0.5), ns3::MilliSeconds(5));
+
+  ns3::Simulator::Destroy();
+}
+
+TEST_F(ModelTest, BackgroundFlowReducesCapacityOfRoutedLinks) {  // NOLINT
+  auto ppp_device = [](const std::string &name, const std::string &address) {
+    return parser::DeviceDescription{
+        .name = name,
+        .type = "PPP",
+        .ipv4_addresses = {asio::ip::make_network_v4(address)},
+        .attributes = {{"DataRate", "10Mb/s"}}};
+  };
+
+  parser::ModelDescription model_desc = {
+      .model_name = "model",
+      .polulate_tables = true,
+      .nodes = {{.name = "a", .devices = {ppp_device("eth0", "10.0.1.1/24")}},
+                {.name = "router",
+                 .devices = {ppp_device("eth0", "10.0.1.2/24"),
+                             ppp_device("eth1", "10.0.2.1/24")}},
+                {.name = "b", .devices = {ppp_device("eth0", "10.0.2.2/24")}}},
+      .connections = {{.name = "a-router",
+                       .type = model::channel_type::PPP,
+                       .interfaces = {"a/eth0", "router/eth0"}},
+                      {.name = "router-b",
+                       .type = model::channel_type::PPP,
+                       .interfaces = {"router/eth1", "b/eth0"}}},
+      .background = {.flows = {{.name = "bulk",
+                                .source = "a",
+                                .destination =
+                                    asio::ip::make_address_v4("10.0.2.2"),
+                                .rate = "4Mb/s",
+                                .end_time = "2s"}}}};
+
+  model::Model model;
+  model.build_from_description(model_desc);
+
+  const auto *background = model.background();
+  ASSERT_TRUE(background != nullptr);
+  EXPECT_EQ(background->flows_count(), 1);
+  ASSERT_EQ(background->links().size(), 2);
+
+  auto rate_of = [&](const std::string &node, const std::string &device) {
+    ns3::DataRateValue rate;
+    model.find_node(node)->get_device_by_name(device)->get()->GetAttribute(
+        "DataRate", rate);
+    return rate.Get();
+  };
+
+  ns3::Simulator::Stop(ns3::Seconds(1));
+  ns3::Simulator::Run();
+
+  EXPECT_EQ(rate_of("a", "eth0"), ns3::DataRate("6Mb/s"));
+  EXPECT_EQ(rate_of("router", "eth1"), ns3::DataRate("6Mb/s"));
+  // Reverse direction is not loaded
+  EXPECT_EQ(rate_of("router", "eth0"), ns3::DataRate("10Mb/s"));
+  EXPECT_NEAR(background->busiest()->utilization(), 0.4, 1e-9);
+
+  ns3::Simulator::Stop(ns3::Seconds(2));
+  ns3::Simulator::Run();
+
+  EXPECT_EQ(rate_of("a", "eth0"), ns3::DataRate("10Mb/s"));
+
+  ns3::Simulator::Destroy();
+}
+
+TEST_F(ModelTest, BackgroundFlowWithoutRouteThrows) {  // NOLINT
+  parser::ModelDescription model_desc = {
+      .model_name = "model",
+      .nodes = {{.name = "a",
+                 .devices = {{.name = "eth0",
+                              .type = "PPP",
+                              .ipv4_addresses = {asio::ip::make_network_v4(
+                                  "10.0.1.1/24")}}}}},
+      .background = {.flows = {{.name = "bulk",
+                                .source = "a",
+                                .destination =
+                                    asio::ip::make_address_v4("10.0.9.9"),
+                                .rate = "4Mb/s"}}}};
+
+  model::Model model;
+  EXPECT_THROW(model.build_from_description(model_desc),
+               model::ModelBuildError);
+  ns3::Simulator::Destroy();
+}
+
+TEST_F(ModelTest, BackgroundFlowEndingBeforeStartThrows) {  // NOLINT
+  parser::ModelDescription model_desc = {
+      .model_name = "model",
+      .nodes = {{.name = "a",
+                 .devices = {{.name = "eth0",
+                              .type = "PPP",
+                              .ipv4_addresses = {asio::ip::make_network_v4(
+                                  "10.0.1.1/24")}}}}},
+      .background = {.flows = {{.name = "bulk",
+                                .source = "a",
+                                .destination =
+                                    asio::ip::make_address_v4("10.0.1.1"),
+                                .rate = "4Mb/s",
+                                .start_time = "2s",
+                                .end_time = "2s"}}}};
+
+  model::Model model;
+  EXPECT_THROW(model.build_from_description(model_desc),
+               model::ModelBuildError);
+  ns3::Simulator::Destroy();
+}
+
+TEST(FluidModel, QueueingDelayGrowsWithUtilization) {  // NOLINT
+  EXPECT_DOUBLE_EQ(model::fluid::residual_rate(4e6, 10e6), 6e6);
+  EXPECT_DOUBLE_EQ(model::fluid::residual_rate(20e6, 10e6),
+                   10e6 * (1 - model::fluid::max_utilization));
+
+  // M/M/1 at rho = 0.5 waits one service time
+  EXPECT_DOUBLE_EQ(model::fluid::queueing_delay(5e6, 10e6, 10e3), 1e-3);
+  EXPECT_DOUBLE_EQ(model::fluid::queueing_delay(0, 10e6, 10e3), 0);
+  EXPECT_GT(model::fluid::queueing_delay(9e6, 10e6, 10e3),
+            model::fluid::queueing_delay(5e6, 10e6, 10e3));
+}
+
+TEST_F(ModelTest, PopulatesNeighborCacheOfCsmaPeers) {  // NOLINT
+  auto csma_node = [](const std::string &name, const std::string &address) {
+    return parser::NodeDescription{
+        .name = name,
+        .devices = {{.name = "eth0",
+                     .type = "Csma",
+                     .ipv4_addresses = {asio::ip::make_network_v4(address)}}}};
+  };
+
+  parser::ModelDescription model_desc = {
+      .model_name = "model",
+      .populate_neighbor_cache = true,
+      .nodes = {csma_node("a", "10.0.0.1/24"), csma_node("b", "10.0.0.2/24"),
+                csma_node("c", "10.0.0.3/24")},
+      .connections = {{.name = "lan",
+                       .type = model::channel_type::CSMA,
+                       .interfaces = {"a/eth0", "b/eth0", "c/eth0"}}}};
+
+  model::Model model;
+  model.build_from_description(model_desc);
+
+  auto *node = model.find_node("a");
+  auto l3 = node->get()->GetObject<ns3::Ipv4L3Protocol>();
+  auto interface =
+      l3->GetInterfaceForDevice(node->get_device_by_name("eth0")->get());
+  auto arp_cache = l3->GetInterface(interface)->GetArpCache();
+
+  for (const auto *peer_name : {"b", "c"}) {
+    auto *peer = model.find_node(peer_name);
+    auto *entry = arp_cache->Lookup(peer->ipv4()->GetAddress(1, 0).GetLocal());
+    ASSERT_TRUE(entry != nullptr) << peer_name;
+    EXPECT_TRUE(entry->IsPermanent());
+    EXPECT_EQ(entry->GetMacAddress(),
+              peer->get_device_by_name("eth0")->get()->GetAddress());
+  }
+
+  ns3::Simulator::Destroy();
+}
+
+bool count_frame(std::uint64_t *counter, ns3::Ptr<ns3::NetDevice> /*device*/,
+                 ns3::Ptr<const ns3::Packet> /*packet*/,
+                 std::uint16_t /*protocol*/, const ns3::Address & /*from*/,
+                 const ns3::Address & /*to*/,
+                 ns3::NetDevice::PacketType /*type*/) {
+  ++*counter;
+  return true;
+}
+
+TEST_F(ModelTest, IdealChannelDeliversUnicastToDestinationOnly) {  // NOLINT
+  auto ideal_node = [](const std::string &name, const std::string &address) {
+    return parser::NodeDescription{
+        .name = name,
+        .devices = {{.name = "eth0",
+                     .type = "Ideal",
+                     .ipv4_addresses = {asio::ip::make_network_v4(address)},
+                     .attributes = {{"DataRate", "100Mbps"}}}}};
+  };
+
+  parser::ModelDescription model_desc = {
+      .model_name = "model",
+      .nodes = {ideal_node("a", "10.0.0.1/24"), ideal_node("b", "10.0.0.2/24"),
+                ideal_node("c", "10.0.0.3/24")},
+      .connections = {{.name = "lan",
+                       .type = model::channel_type::Ideal,
+                       .interfaces = {"a/eth0", "b/eth0", "c/eth0"},
+                       .attributes = {{"Delay", "1ms"}}}}};
+
+  model::Model model;
+  model.build_from_description(model_desc);
+
+  auto channel =
+      model.find_node("a")->get_device_by_name("eth0")->channel()->get();
+  EXPECT_EQ(channel->GetNDevices(), 3);
+
+  std::uint64_t b_frames = 0;
+  std::uint64_t c_frames = 0;
+  model.find_node("b")->get_device_by_name("eth0")->get()
+      ->SetPromiscReceiveCallback(ns3::MakeBoundCallback(&count_frame,
+                                                         &b_frames));
+  model.find_node("c")->get_device_by_name("eth0")->get()
+      ->SetPromiscReceiveCallback(ns3::MakeBoundCallback(&count_frame,
+                                                         &c_frames));
+
+  auto client = model::Application::create(
+      {.name = "client",
+       .type = "ns3::UdpClient",
+       .attributes = {{"MaxPackets", "5"}, {"Interval", "10ms"}}});
+  client.get()->SetAttribute(
+      "RemoteAddress", ns3::AddressValue(ns3::Ipv4Address("10.0.0.2")));
+  client.get()->SetAttribute("RemotePort", ns3::UintegerValue(9));
+  model.find_node("a")->get()->AddApplication(client.get());
+
+  ns3::Simulator::Stop(ns3::Seconds(1));
+  ns3::Simulator::Run();
+
+  // ARP request is broadcast, ARP reply and UDP packets are unicast
+  EXPECT_EQ(b_frames, 1 + 5);
+  EXPECT_EQ(c_frames, 1);
+
+  ns3::Simulator::Destroy();
+}
+
+TEST_F(ModelTest, IdealDeviceRequiresIdealChannel) {  // NOLINT
+  parser::ModelDescription model_desc = {
+      .model_name = "model",
+      .nodes = {{.name = "a", .devices = {{.name = "eth0", .type = "Ideal"}}},
+                {.name = "b", .devices = {{.name = "eth0", .type = "Csma"}}}},
+      .connections = {{.name = "lan",
+                       .type = model::channel_type::CSMA,
+                       .interfaces = {"a/eth0", "b/eth0"}}}};
+
+  model::Model model;
+  EXPECT_THROW(model.build_from_description(model_desc),
+               model::ModelBuildError);
+}
+
+TEST_F(ModelTest, TopologyHasEdgesOfConnections) {  // NOLINT
+  parser::ModelDescription model_desc = {
+      .model_name = "model",
+      .nodes = {{.name = "a",
+                 .devices = {{.name = "eth0",
+                              .type = "PPP",
+                              .attributes = {{"DataRate", "1Gbps"}}}}},
+                {.name = "b",
+                 .devices = {{.name = "eth0", .type = "PPP"},
+                             {.name = "eth1", .type = "Csma"}}},
+                {.name = "c", .devices = {{.name = "eth0", .type = "Csma"}}},
+                {.name = "d", .devices = {{.name = "eth0", .type = "Csma"}}},
+                {.name = "isolated"}},
+      .connections = {{.name = "link",
+                       .type = model::channel_type::PPP,
+                       .interfaces = {"a/eth0", "b/eth0"},
+                       .attributes = {{"Delay", "2ms"}}},
+                      {.name = "lan",
+                       .type = model::channel_type::CSMA,
+                       .interfaces = {"b/eth1", "c/eth0", "d/eth0"},
+                       .attributes = {{"DataRate", "100Mbps"}}}}};
+
+  model::Model model;
+  model.build_from_description(model_desc);
+  EXPECT_EQ(model.topology(), nullptr);
+  model.reset();
+
+  model.enable_topology();
+  model.build_from_description(model_desc);
+  ASSERT_NE(model.topology(), nullptr);
+
+  const auto &topology = *model.topology();
+  EXPECT_EQ(topology.nodes_count(), 5);
+  EXPECT_EQ(topology.devices_count(), 5);
+  EXPECT_EQ(topology.channels_count(), 2);
+  EXPECT_EQ(topology.vertices_count(), 7);
+  // Edge from node to channel and back for every connected device
+  EXPECT_EQ(topology.edges_count(), 10);
+
+  auto a = *topology.find_node("a");
+  auto b = *topology.find_node("b");
+  ASSERT_EQ(topology.neighbors(a).size(), 1);
+  const auto &edge = *topology.neighbors(a).begin();
+  EXPECT_EQ(edge.vertex, topology.channel_vertex(0));
+  EXPECT_EQ(edge.delay_ns, 2'000'000);
+  EXPECT_EQ(edge.rate_bps, 1'000'000'000);
+
+  ASSERT_EQ(topology.neighbors(edge.vertex).size(), 2);
+  EXPECT_EQ(topology.neighbors(edge.vertex).begin()[1].vertex, b);
+
+  // Csma devices share rate of channel
+  for (const auto &lan_edge : topology.neighbors(*topology.find_node("c"))) {
+    EXPECT_EQ(lan_edge.rate_bps, 100'000'000);
+    EXPECT_TRUE(topology.is_channel(lan_edge.vertex));
+    EXPECT_EQ(topology.channel_name(topology.device_channel(lan_edge.device)),
+              "lan");
+  }
+
+  auto distance = topology.bfs(a);
+  EXPECT_EQ(distance, (std::vector<model::Topology::id>{
+                          0, 1, 2, 2, model::Topology::invalid}));
+
+  std::size_t components = 0;
+  topology.components(&components);
+  EXPECT_EQ(components, 2);
+}
+
+TEST_F(ModelTest, TopologyOfSharedSegmentIsLinear) {  // NOLINT
+  constexpr auto hosts = 1000;
+
+  parser::ModelDescription model_desc = {.model_name = "model"};
+  parser::ConnectionDescription lan = {.name = "lan",
+                                       .type = model::channel_type::CSMA};
+  for (int i = 0; i < hosts; ++i) {
+    auto name = "host-" + std::to_string(i);
+    model_desc.nodes.push_back(
+        {.name = name, .devices = {{.name = "eth0", .type = "Csma"}}});
+    lan.interfaces.push_back(name + "/eth0");
+  }
+  model_desc.connections.push_back(std::move(lan));
+
+  auto topology = model::Topology::build(model_desc);
+  EXPECT_EQ(topology.edges_count(), 2 * hosts);
+  EXPECT_EQ(topology.neighbors(topology.channel_vertex(0)).size(), hosts);
+
+  auto distance = topology.bfs(0);
+  EXPECT_EQ(distance.size(), hosts);
+  EXPECT_EQ(distance[0], 0);
+  EXPECT_TRUE(std::all_of(distance.begin() + 1, distance.end(),
+                          [](auto hops) { return hops == 1; }));
+}
+
+TEST_F(ModelTest, ResetReleasesNodesBetweenRuns) {  // NOLINT
+  parser::ModelDescription model_desc = {
+      .model_name = "model",
+      .end_time = "10ms",
+      .nodes = {{.name = "a",
+                 .devices = {{.name = "eth0",
+                              .type = "PPP",
+                              .ipv4_addresses = {asio::ip::make_network_v4(
+                                  "10.0.0.1/24")}}}},
+                {.name = "b",
+                 .devices = {{.name = "eth0",
+                              .type = "PPP",
+                              .ipv4_addresses = {asio::ip::make_network_v4(
+                                  "10.0.0.2/24")}}}}},
+      .connections = {{.name = "link",
+                       .type = model::channel_type::PPP,
+                       .interfaces = {"a/eth0", "b/eth0"}}}};
+
+  model::Model model;
+  for (int run = 0; run < 3; ++run) {
+    // Names of previous run would be reported as duplicates
+    model.build_from_description(model_desc);
+    ASSERT_EQ(ns3::NodeList::GetNNodes(), 2);
+    ASSERT_EQ(ns3::ChannelList::GetNChannels(), 1);
+    EXPECT_EQ(model.nodes().front()->get()->GetId(), 0);
+
+    model.start();
+    model.reset();
+
+    EXPECT_EQ(ns3::NodeList::GetNNodes(), 0);
+    EXPECT_EQ(ns3::ChannelList::GetNChannels(), 0);
+    EXPECT_EQ(ns3::Names::Find<ns3::Node>("a"), nullptr);
+    EXPECT_TRUE(model.nodes().empty());
+  }
+}
+
+TEST_F(ModelTest, ResetRepeatsRandomModel) {  // NOLINT
+  parser::ModelDescription model_desc = {
+      .model_name = "model",
+      .end_time = "1s",
+      .nodes = {{.name = "client",
+                 .devices = {{.name = "eth0",
+                              .type = "PPP",
+                              .ipv4_addresses = {asio::ip::make_network_v4(
+                                  "10.10.10.2/24")}}}},
+                {.name = "server",
+                 .devices = {{.name = "eth0",
+                              .type = "PPP",
+                              .ipv4_addresses = {asio::ip::make_network_v4(
+                                  "10.10.10.4/24")}}}}},
+      .connections = {{.name = "link",
+                       .type = model::channel_type::PPP,
+                       .interfaces = {"client/eth0", "server/eth0"}}},
+      .registrators = {{.source = "/NodeList/*/DeviceList/*/"
+                                  "$ns3::PointToPointNetDevice/MacTx",
+                        .type = "ns3::PacketProbe",
+                        .sink = "OutputBytes",
+                        .file = "reset_random_test",
+                        .start_time = "0s"}}};
+
+  // Earlier tests leave counters of streams and MAC addresses behind
+  model::Model model;
+  model.reset();
+
+  std::vector<std::string> outputs;
+  std::vector<ns3::Address> addresses;
+  for (int run = 0; run < 2; ++run) {
+    model.build_from_description(model_desc);
+    addresses.push_back(
+        model.find_node("client")->get_device(0).get()->GetAddress());
+
+    // Random variables of the source take streams assigned automatically
+    auto source = model::Application::create(
+        {.name = "source",
+         .type = "applications::BurstSource",
+         .attributes = {
+             {"DataRate", "1Mb/s"},
+             {"BurstSize", "ns3::UniformRandomVariable[Min=1|Max=8]"},
+             {"InterBurst", "ns3::ExponentialRandomVariable[Mean=1]"},
+             {"MaxBytes", "50000"}}});
+    source.get()->SetAttribute(
+        "Remote", ns3::AddressValue(ns3::InetSocketAddress(
+                      ns3::Ipv4Address("10.10.10.4"), 9)));
+    model.find_node("client")->get()->AddApplication(source.get());
+
+    model.start();
+    model.reset();
+
+    std::ifstream output{"reset_random_test.txt"};
+    std::stringstream content;
+    content << output.rdbuf();
+    outputs.push_back(content.str());
+  }
+
+  EXPECT_FALSE(outputs[0].empty());
+  EXPECT_EQ(outputs[0], outputs[1]);
+  EXPECT_EQ(addresses[0], addresses[1]);
+
+  std::remove("reset_random_test.txt");
+  std::remove("reset_random_test.objects.txt");
+}
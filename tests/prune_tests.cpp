@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <boost/asio/ip/network_v4.hpp>
+
+#include <gtest/gtest.h>
+
+#include "model/channel.h"
+#include "parser/parser.h"
+#include "parser/prune.h"
+
+namespace {
+
+auto make_node(const std::string &name, std::vector<std::string> devices,
+               bool application = false) -> parser::NodeDescription {
+  parser::NodeDescription node{.name = name};
+  for (auto &device : devices) {
+    node.devices.push_back({.name = std::move(device), .type = "Csma"});
+  }
+  if (application) {
+    node.applications.push_back(
+        {.name = name + "-app", .type = "ns3::PacketSink"});
+  }
+  return node;
+}
+
+auto make_link(const std::string &lhs, const std::string &rhs)
+    -> parser::ConnectionDescription {
+  return {.name = lhs + "-" + rhs,
+          .type = model::channel_type::PPP,
+          .interfaces = {lhs, rhs}};
+}
+
+auto node_names(const parser::ModelDescription &description)
+    -> std::vector<std::string> {
+  std::vector<std::string> names;
+  for (const auto &node : description.nodes) {
+    names.push_back(node.name);
+  }
+  return names;
+}
+
+}  // namespace
+
+TEST(Prune, RemovesDeadBranch) {  // NOLINT
+  parser::ModelDescription description{
+      .nodes = {make_node("a", {"eth0"}, true),
+                make_node("router", {"eth0", "eth1", "eth2"}),
+                make_node("b", {"eth0"}, true),
+                make_node("x", {"eth0", "eth1"}), make_node("y", {"eth0"})},
+      .connections = {make_link("a/eth0", "router/eth0"),
+                      make_link("router/eth1", "b/eth0"),
+                      make_link("router/eth2", "x/eth0"),
+                      make_link("x/eth1", "y/eth0")}};
+
+  auto report = parser::prune(description);
+
+  EXPECT_EQ(report.endpoints, 2);
+  EXPECT_EQ(report.nodes, (std::vector<std::string>{"x", "y"}));
+  EXPECT_EQ(report.connections,
+            (std::vector<std::string>{"router/eth2-x/eth0", "x/eth1-y/eth0"}));
+  EXPECT_EQ(report.devices, (std::vector<std::string>{"router/eth2"}));
+
+  EXPECT_EQ(node_names(description),
+            (std::vector<std::string>{"a", "router", "b"}));
+  EXPECT_EQ(description.connections.size(), 2);
+  EXPECT_EQ(description.nodes[1].devices.size(), 2);
+}
+
+TEST(Prune, KeepsAlternativePaths) {  // NOLINT
+  // a - r1 - r2 - b with detour r1 - r3 - r2 and dead leaf d behind r3
+  parser::ModelDescription description{
+      .nodes = {make_node("a", {"eth0"}, true),
+                make_node("r1", {"eth0", "eth1", "eth2"}),
+                make_node("r2", {"eth0", "eth1", "eth2"}),
+                make_node("r3", {"eth0", "eth1", "eth2"}),
+                make_node("b", {"eth0"}, true), make_node("d", {"eth0"})},
+      .connections = {make_link("a/eth0", "r1/eth0"),
+                      make_link("r1/eth1", "r2/eth0"),
+                      make_link("r2/eth1", "b/eth0"),
+                      make_link("r1/eth2", "r3/eth0"),
+                      make_link("r3/eth1", "r2/eth2"),
+                      make_link("r3/eth2", "d/eth0")}};
+
+  auto report = parser::prune(description);
+
+  EXPECT_EQ(report.nodes, (std::vector<std::string>{"d"}));
+  EXPECT_EQ(node_names(description),
+            (std::vector<std::string>{"a", "r1", "r2", "r3", "b"}));
+}
+
+TEST(Prune, ShrinksSharedSegment) {  // NOLINT
+  parser::ModelDescription description{
+      .nodes = {make_node("a", {"eth0"}, true), make_node("b", {"eth0"}, true),
+                make_node("c", {"eth0"})},
+      .connections = {{.name = "lan",
+                       .type = model::channel_type::CSMA,
+                       .interfaces = {"a/eth0", "b/eth0", "c/eth0"}}}};
+
+  auto report = parser::prune(description);
+
+  EXPECT_EQ(report.nodes, (std::vector<std::string>{"c"}));
+  EXPECT_TRUE(report.connections.empty());
+  ASSERT_EQ(description.connections.size(), 1);
+  EXPECT_EQ(description.connections.front().interfaces,
+            (std::vector<std::string>{"a/eth0", "b/eth0"}));
+}
+
+TEST(Prune, AddressInApplicationAttributesIsEndpoint) {  // NOLINT
+  auto client = make_node("client", {"eth0"}, true);
+  client.applications.front().attributes = {{"Remote", "10.0.0.3"}};
+
+  auto server = make_node("server", {"eth0"});
+  server.devices.front().ipv4_addresses = {
+      boost::asio::ip::make_network_v4("10.0.0.3/24")};
+
+  parser::ModelDescription description{
+      .nodes = {client, make_node("router", {"eth0", "eth1", "eth2"}), server,
+                make_node("idle", {"eth0"})},
+      .connections = {make_link("client/eth0", "router/eth0"),
+                      make_link("router/eth1", "server/eth0"),
+                      make_link("router/eth2", "idle/eth0")}};
+
+  auto report = parser::prune(description);
+
+  EXPECT_EQ(report.endpoints, 2);
+  EXPECT_EQ(node_names(description),
+            (std::vector<std::string>{"client", "router", "server"}));
+}
+
+TEST(Prune, SerializedAddressInApplicationAttributesIsEndpoint) {  // NOLINT
+  auto client = make_node("client", {"eth0"}, true);
+  client.applications.front().attributes = {
+      {"RemoteAddress", "0-4-0A:00:00:03"}};
+
+  auto server = make_node("server", {"eth0"});
+  server.devices.front().ipv4_addresses = {
+      boost::asio::ip::make_network_v4("10.0.0.3/24")};
+
+  parser::ModelDescription description{
+      .nodes = {client, make_node("router", {"eth0", "eth1", "eth2"}), server,
+                make_node("idle", {"eth0"})},
+      .connections = {make_link("client/eth0", "router/eth0"),
+                      make_link("router/eth1", "server/eth0"),
+                      make_link("router/eth2", "idle/eth0")}};
+
+  auto report = parser::prune(description);
+
+  EXPECT_EQ(report.endpoints, 2);
+  EXPECT_EQ(report.nodes, (std::vector<std::string>{"idle"}));
+}
+
+TEST(Prune, SocketAddressInApplicationAttributesIsEndpoint) {  // NOLINT
+  // InetSocketAddress 10.1.22.2:666 with TOS, as in on_off_tcp example
+  auto client = make_node("client", {"eth0"}, true);
+  client.applications.front().attributes = {
+      {"Remote", "0-7-0A:01:16:02:9a:02:00"}};
+
+  auto server = make_node("server", {"eth0"});
+  server.devices.front().ipv4_addresses = {
+      boost::asio::ip::make_network_v4("10.1.22.2/24")};
+
+  parser::ModelDescription description{
+      .nodes = {client, make_node("router", {"eth0", "eth1", "eth2"}), server,
+                make_node("idle", {"eth0"})},
+      .connections = {make_link("client/eth0", "router/eth0"),
+                      make_link("router/eth1", "server/eth0"),
+                      make_link("router/eth2", "idle/eth0")}};
+
+  auto report = parser::prune(description);
+
+  EXPECT_EQ(report.endpoints, 2);
+  EXPECT_EQ(report.nodes, (std::vector<std::string>{"idle"}));
+}
+
+TEST(Prune, KeepsObservedNodesAndIndices) {  // NOLINT
+  parser::ModelDescription description{
+      .nodes = {make_node("a", {"eth0"}, true), make_node("idle0", {"eth0"}),
+                make_node("b", {"eth0"}, true), make_node("idle1", {"eth0"}),
+                make_node("polled", {"eth0"}), make_node("idle2", {"eth0"})},
+      .connections = {make_link("a/eth0", "b/eth0")},
+      .registrators = {{.source = "/NodeList/1/$ns3::Ipv4L3Protocol/Tx"}},
+      .pollers = {{.values = {{.name = "rx", .object = "polled/eth0"}}}}};
+
+  auto report = parser::prune(description);
+
+  EXPECT_EQ(report.nodes, (std::vector<std::string>{"idle1", "idle2"}));
+  EXPECT_EQ(node_names(description),
+            (std::vector<std::string>{"a", "idle0", "b", "polled"}));
+
+  // Unconnected observed device is kept, unobserved is removed
+  EXPECT_EQ(description.nodes[3].devices.size(), 1);
+  EXPECT_TRUE(description.nodes[1].devices.empty());
+}
+
+TEST(Prune, KeepsNodesMatchedByWildcardSources) {  // NOLINT
+  parser::ModelDescription description{
+      .nodes = {make_node("a", {"eth0"}, true), make_node("b", {"eth0"}, true),
+                make_node("server-1", {"eth0", "eth1"}),
+                make_node("server-2", {"eth0"}), make_node("backup", {"eth0"}),
+                make_node("idle", {"eth0"})},
+      .connections = {make_link("a/eth0", "b/eth0")},
+      .registrators = {
+          {.source = "/Names/server-*/eth*/TxQueue/PacketsInQueue"},
+          {.source = "/Names/idle-*|backup/eth0/TxQueue/PacketsInQueue"}}};
+
+  auto report = parser::prune(description);
+
+  EXPECT_EQ(report.nodes, (std::vector<std::string>{"idle"}));
+  EXPECT_EQ(node_names(description),
+            (std::vector<std::string>{"a", "b", "server-1", "server-2",
+                                      "backup"}));
+  EXPECT_EQ(description.nodes[2].devices.size(), 2);
+}
+
+TEST(Prune, KeepsAllNodesOfNodeListWildcard) {  // NOLINT
+  parser::ModelDescription description{
+      .nodes = {make_node("a", {"eth0"}, true), make_node("b", {"eth0"}, true),
+                make_node("idle", {"eth0"})},
+      .connections = {make_link("a/eth0", "b/eth0")},
+      .registrators = {{.source = "/NodeList/*/$ns3::Ipv4L3Protocol/Tx"}}};
+
+  auto report = parser::prune(description);
+
+  EXPECT_TRUE(report.nodes.empty());
+  EXPECT_EQ(description.nodes.size(), 3);
+}
+
+TEST(Prune, KeepsRoutedDevices) {  // NOLINT
+  auto a = make_node("a", {"eth0", "eth1", "eth2"}, true);
+  a.routing.ipv4.push_back(
+      {.network = boost::asio::ip::make_network_v4("10.1.0.0/16"),
+       .interface = "eth1"});
+
+  parser::ModelDescription description{
+      .nodes = {a, make_node("b", {"eth0"}, true)},
+      .connections = {make_link("a/eth0", "b/eth0")}};
+
+  auto report = parser::prune(description);
+
+  EXPECT_EQ(report.devices, (std::vector<std::string>{"a/eth2"}));
+  ASSERT_EQ(description.nodes.front().devices.size(), 2);
+  EXPECT_EQ(description.nodes.front().devices[1].name, "eth1");
+}
+
+TEST(Prune, SkipsModelWithoutEndpoints) {  // NOLINT
+  parser::ModelDescription description{
+      .nodes = {make_node("a", {"eth0"}), make_node("b", {"eth0", "eth1"})},
+      .connections = {make_link("a/eth0", "b/eth0")}};
+
+  auto report = parser::prune(description);
+
+  EXPECT_EQ(report.endpoints, 0);
+  EXPECT_TRUE(report.empty());
+  EXPECT_EQ(description.nodes.size(), 2);
+  EXPECT_EQ(description.nodes[1].devices.size(), 2);
+}
@@ -0,0 +1,152 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "cache/canonical.h"
+#include "cache/output_files.h"
+#include "cache/result_cache.h"
+#include "parser/parser.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+class ResultCacheTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    _root = fs::temp_directory_path() /
+            ("result_cache_" + std::to_string(::testing::UnitTest::GetInstance()
+                                                  ->random_seed()));
+    fs::remove_all(_root);
+    fs::create_directories(_root / "out");
+  }
+
+  void TearDown() override { fs::remove_all(_root); }
+
+ protected:
+  auto write(const std::string &name, const std::string &content) const
+      -> fs::path {
+    auto path = _root / "out" / name;
+    std::ofstream{path} << content;
+    return path;
+  }
+
+  static auto read(const fs::path &path) -> std::string {
+    std::ifstream in{path};
+    return {std::istreambuf_iterator<char>{in}, {}};
+  }
+
+  fs::path _root;
+};
+
+auto make_description(const std::string &end_time)
+    -> parser::ModelDescription {
+  return {.model_name = "model",
+          .end_time = end_time,
+          .nodes = {{.name = "a"}},
+          .registrators = {{.source = "/NodeList/0/$ns3::Ipv4L3Protocol/Tx",
+                            .file = "tx"}}};
+}
+}  // namespace
+
+TEST(Canonical, DiffersForDifferentDescriptions) {  // NOLINT
+  auto description = make_description("1s");
+  EXPECT_EQ(cache::canonical(description),
+            cache::canonical(make_description("1s")));
+  EXPECT_NE(cache::canonical(description),
+            cache::canonical(make_description("2s")));
+
+  // Strings are length prefixed, so moved separators are different
+  auto lhs = description;
+  lhs.nodes.front().name = "a;b";
+  auto rhs = description;
+  rhs.nodes.front().name = "a";
+  rhs.nodes.push_back({.name = "b"});
+  EXPECT_NE(cache::canonical(lhs), cache::canonical(rhs));
+}
+
+TEST_F(ResultCacheTest, RestoresStoredFiles) {  // NOLINT
+  cache::ResultCache results{_root / "cache", 1 << 20};
+  auto key = cache::ResultCache::key(make_description("1s"));
+
+  EXPECT_FALSE(results.restore(key).has_value());
+
+  auto file = write("tx.txt", "0,100\n");
+  results.store(key, {file});
+
+  fs::remove(file);
+  auto restored = results.restore(key);
+  ASSERT_TRUE(restored.has_value());
+  EXPECT_EQ(*restored, (std::vector<fs::path>{file}));
+  EXPECT_EQ(read(file), "0,100\n");
+
+  // Other description is a miss
+  EXPECT_FALSE(
+      results.restore(cache::ResultCache::key(make_description("2s")))
+          .has_value());
+}
+
+TEST_F(ResultCacheTest, EvictsLeastRecentlyUsed) {  // NOLINT
+  constexpr auto file_size = 1000;
+  // Two entries fit together with their key and manifest files
+  cache::ResultCache results{_root / "cache", 3 * file_size};
+
+  auto first = cache::ResultCache::key(make_description("1s"));
+  auto second = cache::ResultCache::key(make_description("2s"));
+  auto third = cache::ResultCache::key(make_description("3s"));
+  auto file = write("tx.txt", std::string(file_size, 'x'));
+
+  results.store(first, {file});
+  results.store(second, {file});
+  // First becomes the most recently used
+  ASSERT_TRUE(results.restore(first).has_value());
+  results.store(third, {file});
+
+  EXPECT_TRUE(results.restore(first).has_value());
+  EXPECT_FALSE(results.restore(second).has_value());
+  EXPECT_TRUE(results.restore(third).has_value());
+}
+
+TEST_F(ResultCacheTest, WrittenFilesIncludeApplicationOutputs) {  // NOLINT
+  auto since = fs::file_time_type::clock::now() - std::chrono::seconds{1};
+  auto registrator = write("tx.txt", "0,100\n");
+  auto latency = write("latency.csv", "quantile,latency\n");
+  write("unrelated.txt", "");
+
+  auto description = make_description("1s");
+  description.registrators.front().file = (_root / "out" / "tx").string();
+  description.nodes.front().applications = {
+      {.name = "sink",
+       .type = "applications::LatencySink",
+       .attributes = {{"Output", latency.string()}}},
+      {.name = "echo", .type = "ns3::UdpEchoServer"}};
+
+  EXPECT_EQ(cache::written_files(description, since),
+            (std::vector<fs::path>{latency, registrator}));
+}
+
+TEST(OutputFiles, PrintedSummariesAreNotCached) {  // NOLINT
+  auto description = make_description("1s");
+  EXPECT_FALSE(cache::prints_summary(description));
+
+  auto sink = description;
+  sink.nodes.front().applications = {
+      {.name = "sink", .type = "applications::LatencySink"}};
+  EXPECT_TRUE(cache::prints_summary(sink));
+
+  sink.nodes.front().applications.front().attributes = {
+      {"Output", "latency.csv"}};
+  EXPECT_FALSE(cache::prints_summary(sink));
+
+  auto capture = description;
+  capture.nodes.front().devices = {
+      {.name = "eth0", .type = "Csma", .capture = {{.file = "eth0"}}}};
+  EXPECT_TRUE(cache::prints_summary(capture));
+
+  auto decimated = description;
+  decimated.registrators.front().decimate = 10;
+  EXPECT_TRUE(cache::prints_summary(decimated));
+}
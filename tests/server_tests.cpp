@@ -0,0 +1,361 @@
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "server/job.h"
+#include "server/protocol.h"
+#include "server/server.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+class SocketPair {
+ public:
+  SocketPair() {
+    ::socketpair(AF_UNIX, SOCK_STREAM, 0, _fds);  // NOLINT
+  }
+
+  ~SocketPair() {
+    ::close(_fds[0]);
+    ::close(_fds[1]);
+  }
+
+  SocketPair(const SocketPair &) = delete;
+  SocketPair &operator=(const SocketPair &) = delete;
+
+  auto client() const -> int { return _fds[0]; }
+  auto worker() const -> int { return _fds[1]; }
+
+  void close_client() { ::shutdown(_fds[0], SHUT_WR); }
+
+ private:
+  int _fds[2] = {-1, -1};  // NOLINT
+};
+
+// Echo client and server, registrator writes "echo_tx.txt"
+constexpr auto echo_model = R"(<?xml version="1.0" encoding="UTF-8"?>
+<model name="echo">
+  <populate-routing-tables>true</populate-routing-tables>
+  <duration>1s</duration>
+  <node name="client">
+    <device-list>
+      <device name="eth0" type="Csma">
+        <address value="10.1.22.1" netmask="255.255.255.0"/>
+      </device>
+    </device-list>
+    <applications>
+      <application name="echo" type="ns3::UdpEchoClient">
+        <attributes>
+          <attribute key="RemoteAddress" value="0-4-0A:01:16:02"/>
+          <attribute key="RemotePort" value="666"/>
+          <attribute key="MaxPackets" value="5"/>
+          <attribute key="Interval" value="100ms"/>
+        </attributes>
+      </application>
+    </applications>
+  </node>
+  <node name="server">
+    <device-list>
+      <device name="eth0" type="Csma">
+        <address value="10.1.22.2" netmask="255.255.255.0"/>
+      </device>
+    </device-list>
+    <applications>
+      <application name="echo" type="ns3::UdpEchoServer">
+        <attributes>
+          <attribute key="Port" value="666"/>
+        </attributes>
+      </application>
+    </applications>
+  </node>
+  <connections>
+    <connection name="lan" type="Csma">
+      <interfaces>
+        <interface>client/eth0</interface>
+        <interface>server/eth0</interface>
+      </interfaces>
+    </connection>
+  </connections>
+  <statistics>
+    <registrator value_name="Bytes" type="ns3::Ipv4PacketProbe"
+                 source="/NodeList/*/$ns3::Ipv4L3Protocol/Tx" start="0s"
+                 file="echo_tx" sink="OutputBytes"/>
+  </statistics>
+</model>)";
+
+// Echo model with random loss of packets received by server, registrator
+// writes "lossy_tx.txt"
+constexpr auto lossy_echo_model = R"(<?xml version="1.0" encoding="UTF-8"?>
+<model name="lossy-echo">
+  <populate-routing-tables>true</populate-routing-tables>
+  <duration>1s</duration>
+  <node name="client">
+    <device-list>
+      <device name="eth0" type="Csma">
+        <address value="10.1.22.1" netmask="255.255.255.0"/>
+      </device>
+    </device-list>
+    <applications>
+      <application name="echo" type="ns3::UdpEchoClient">
+        <attributes>
+          <attribute key="RemoteAddress" value="0-4-0A:01:16:02"/>
+          <attribute key="RemotePort" value="666"/>
+          <attribute key="MaxPackets" value="50"/>
+          <attribute key="Interval" value="10ms"/>
+        </attributes>
+      </application>
+    </applications>
+  </node>
+  <node name="server">
+    <device-list>
+      <device name="eth0" type="Csma">
+        <address value="10.1.22.2" netmask="255.255.255.0"/>
+        <attributes>
+          <attribute key="ReceiveErrorModel"
+                     value="ns3::RateErrorModel[ErrorRate=0.5|ErrorUnit=ERROR_UNIT_PACKET]"/>
+        </attributes>
+      </device>
+    </device-list>
+    <applications>
+      <application name="echo" type="ns3::UdpEchoServer">
+        <attributes>
+          <attribute key="Port" value="666"/>
+        </attributes>
+      </application>
+    </applications>
+  </node>
+  <connections>
+    <connection name="lan" type="Csma">
+      <interfaces>
+        <interface>client/eth0</interface>
+        <interface>server/eth0</interface>
+      </interfaces>
+    </connection>
+  </connections>
+  <statistics>
+    <registrator value_name="Bytes" type="ns3::Ipv4PacketProbe"
+                 source="/NodeList/*/$ns3::Ipv4L3Protocol/Tx" start="0s"
+                 file="lossy_tx" sink="OutputBytes"/>
+  </statistics>
+</model>)";
+
+class ServerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    _root = fs::temp_directory_path() /
+            ("server_" + std::to_string(::getpid()) + "_" +
+             ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    fs::remove_all(_root);
+    fs::create_directories(_root);
+  }
+
+  void TearDown() override { fs::remove_all(_root); }
+
+ protected:
+  /**
+   * @brief Run model on server, waiting for server to start listening
+   *
+   */
+  auto submit(const std::string &socket,
+              const std::string &xml = echo_model) const -> server::Response {
+    constexpr auto attempts = 100;
+
+    int fd = -1;
+    for (int attempt = 0; fd < 0; ++attempt) {
+      try {
+        fd = server::connect(socket);
+      } catch (const server::ProtocolError &) {
+        if (attempt == attempts) {
+          throw;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+      }
+    }
+
+    server::write_request(fd, {.directory = _root.string(), .xml = xml});
+    auto response = server::read_response(fd);
+    ::close(fd);
+    return response;
+  }
+
+  fs::path _root;
+};
+
+// Worker processes of the server, read from procfs
+auto children(pid_t pid) -> std::vector<pid_t> {
+  auto path = "/proc/" + std::to_string(pid) + "/task/" +
+              std::to_string(pid) + "/children";
+  std::ifstream in{path};
+  std::vector<pid_t> pids;
+  for (pid_t child = 0; in >> child;) {
+    pids.push_back(child);
+  }
+  return pids;
+}
+}  // namespace
+
+TEST(ServerProtocol, RequestRoundTrip) {  // NOLINT
+  SocketPair sockets;
+
+  server::write_request(sockets.client(), {.directory = "/tmp/jobs",
+                                           .model_path = "model.xml"});
+  auto by_path = server::read_request(sockets.worker());
+  EXPECT_EQ(by_path.directory, "/tmp/jobs");
+  EXPECT_EQ(by_path.model_path, "model.xml");
+  EXPECT_TRUE(by_path.xml.empty());
+
+  // Inline model may contain anything, including protocol keywords
+  std::string xml = "<model>\nSTATUS 1\n</model>";
+  server::write_request(sockets.client(), {.xml = xml});
+  auto inline_model = server::read_request(sockets.worker());
+  EXPECT_TRUE(inline_model.directory.empty());
+  EXPECT_EQ(inline_model.xml, xml);
+}
+
+TEST(ServerProtocol, ResponseRoundTrip) {  // NOLINT
+  SocketPair sockets;
+
+  server::write_response(sockets.worker(),
+                         {.status = 1,
+                          .error = "Bad\nmodel",
+                          .outputs = {"/tmp/a.txt", "/tmp/b.pcapng"}});
+  auto response = server::read_response(sockets.client());
+
+  EXPECT_EQ(response.status, 1);
+  EXPECT_EQ(response.error, "Bad model");
+  EXPECT_EQ(response.outputs,
+            (std::vector<std::string>{"/tmp/a.txt", "/tmp/b.pcapng"}));
+}
+
+TEST(ServerProtocol, ClosedConnectionIsError) {  // NOLINT
+  SocketPair sockets;
+
+  ::write(sockets.client(), "XML 100\n<model>", 15);  // NOLINT
+  sockets.close_client();
+
+  EXPECT_THROW(server::read_request(sockets.worker()), server::ProtocolError);
+}
+
+TEST(ServerJob, ReportsModelError) {  // NOLINT
+  auto response = server::run_job({.xml = "<model"});
+  EXPECT_EQ(response.status, 1);
+  EXPECT_FALSE(response.error.empty());
+
+  response = server::run_job({.model_path = "/nonexistent/model.xml"});
+  EXPECT_EQ(response.status, 1);
+  EXPECT_TRUE(response.outputs.empty());
+}
+
+TEST_F(ServerTest, JobReturnsWrittenOutputs) {  // NOLINT
+  auto directory = fs::current_path();
+
+  auto response =
+      server::run_job({.directory = _root.string(), .xml = echo_model});
+  ASSERT_EQ(response.status, 0) << response.error;
+  EXPECT_TRUE(response.error.empty());
+  EXPECT_EQ(fs::current_path(), directory);
+
+  ASSERT_FALSE(response.outputs.empty());
+  for (const auto &output : response.outputs) {
+    EXPECT_EQ(fs::path{output}.parent_path(), _root);
+    EXPECT_TRUE(fs::exists(output)) << output;
+  }
+  EXPECT_NE(std::find(response.outputs.begin(), response.outputs.end(),
+                      (_root / "echo_tx.txt").string()),
+            response.outputs.end());
+}
+
+TEST_F(ServerTest, ServesJobsAndReplacesCrashedWorker) {  // NOLINT
+  auto socket = (_root / "simulation.sock").string();
+
+  auto server_pid = ::fork();
+  ASSERT_GE(server_pid, 0);
+  if (server_pid == 0) {
+    auto status = 0;
+    try {
+      server::Server{socket, 1}.run();
+    } catch (const std::exception &) {
+      status = 1;
+    }
+    ::_exit(status);
+  }
+
+  auto response = submit(socket);
+  EXPECT_EQ(response.status, 0) << response.error;
+  EXPECT_FALSE(response.outputs.empty());
+
+  auto workers = children(server_pid);
+  ASSERT_EQ(workers.size(), 1);
+  ::kill(workers.front(), SIGKILL);
+
+  // Server replaces the worker after a short pause
+  for (int attempt = 0; attempt < 100; ++attempt) {
+    auto current = children(server_pid);
+    if (current.size() == 1 && current.front() != workers.front()) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+  }
+  auto replaced = children(server_pid);
+  ASSERT_EQ(replaced.size(), 1);
+  EXPECT_NE(replaced.front(), workers.front());
+
+  response = submit(socket);
+  EXPECT_EQ(response.status, 0) << response.error;
+
+  ::kill(server_pid, SIGTERM);
+  int status = 0;
+  ASSERT_EQ(::waitpid(server_pid, &status, 0), server_pid);
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+TEST_F(ServerTest, WorkerRepeatsRandomModel) {  // NOLINT
+  auto socket = (_root / "simulation.sock").string();
+
+  auto server_pid = ::fork();
+  ASSERT_GE(server_pid, 0);
+  if (server_pid == 0) {
+    auto status = 0;
+    try {
+      server::Server{socket, 1}.run();
+    } catch (const std::exception &) {
+      status = 1;
+    }
+    ::_exit(status);
+  }
+
+  // The only worker runs both jobs, the second one must not continue random
+  // streams of the first
+  std::vector<std::string> outputs;
+  for (int job = 0; job < 2; ++job) {
+    auto response = submit(socket, lossy_echo_model);
+    ASSERT_EQ(response.status, 0) << response.error;
+
+    std::ifstream output{_root / "lossy_tx.txt"};
+    std::stringstream content;
+    content << output.rdbuf();
+    outputs.push_back(content.str());
+  }
+
+  EXPECT_FALSE(outputs[0].empty());
+  EXPECT_EQ(outputs[0], outputs[1]);
+
+  ::kill(server_pid, SIGTERM);
+  int status = 0;
+  ASSERT_EQ(::waitpid(server_pid, &status, 0), server_pid);
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+}
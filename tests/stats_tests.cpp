@@ -0,0 +1,667 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include "stats/async_writer.h"
+#include "stats/binary_reader.h"
+#include "stats/binary_writer.h"
+#include "stats/compression.h"
+#include "stats/container_reader.h"
+#include "stats/container_writer.h"
+#include "stats/csv_writer.h"
+#include "stats/histogram.h"
+#include "stats/packet_filter.h"
+#include "stats/pcapng_writer.h"
+#include "stats/sample_filter.h"
+#include "stats/shm_reader.h"
+#include "stats/shm_writer.h"
+#include "stats/spsc_ring.h"
+#include "stats/window_aggregator.h"
+#include "stats/writer.h"
+
+namespace {
+// Collects rows in memory
+class MemoryWriter final : public stats::Writer {
+ public:
+  explicit MemoryWriter(std::vector<std::int64_t> &times,
+                        std::vector<double> &values, int *flushes = nullptr,
+                        std::vector<std::string> columns = {"value"})
+      : Writer{std::move(columns)},
+        _times{times},
+        _values{values},
+        _flushes{flushes} {}
+
+  void write(std::int64_t time, const double *values) override {
+    _times.push_back(time);
+    _values.insert(_values.end(), values, values + columns().size());
+  }
+
+  void flush() override {
+    if (_flushes != nullptr) {
+      ++*_flushes;
+    }
+  }
+
+ private:
+  std::vector<std::int64_t> &_times;
+  std::vector<double> &_values;
+  int *_flushes;
+};
+}  // namespace
+
+TEST(BinaryStats, WriteAndRead) {  // NOLINT
+  const std::string path = "binary_stats_test.bin";
+  constexpr std::size_t block_rows = 4;
+  constexpr std::int64_t rows = 10;
+
+  {
+    stats::BinaryWriter writer{path, {"first", "second"}, 1e-9, block_rows};
+    for (std::int64_t i = 0; i < rows; ++i) {
+      const double values[] = {static_cast<double>(i), -0.5 * i};  // NOLINT
+      writer.write(i * 100, values);
+    }
+  }
+
+  stats::BinaryReader reader{path};
+  EXPECT_EQ(reader.columns(), (std::vector<std::string>{"first", "second"}));
+  EXPECT_DOUBLE_EQ(reader.seconds_per_step(), 1e-9);
+
+  std::int64_t row = 0;
+  std::size_t blocks = 0;
+  stats::BinaryReader::Block block;
+  while (reader.next(block)) {
+    ++blocks;
+    ASSERT_EQ(block.values.size(), 2);
+    for (std::size_t i = 0; i < block.times.size(); ++i, ++row) {
+      EXPECT_EQ(block.times[i], row * 100);
+      EXPECT_EQ(block.values[0][i], static_cast<double>(row));
+      EXPECT_EQ(block.values[1][i], -0.5 * row);
+    }
+  }
+
+  EXPECT_EQ(row, rows);
+  EXPECT_EQ(blocks, 3);
+
+  std::remove(path.c_str());
+}
+
+TEST(BinaryStats, ThrowOnBadFile) {  // NOLINT
+  const std::string path = "not_binary_stats.txt";
+  {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    std::fputs("Time,value\n", file);
+    std::fclose(file);
+  }
+
+  EXPECT_THROW(stats::BinaryReader{path}, stats::OutputError);
+
+  std::remove(path.c_str());
+}
+
+TEST(BinaryStats, OutputFormatFromString) {  // NOLINT
+  EXPECT_EQ(stats::output_format_from_string("CSV"), stats::output_format::csv);
+  EXPECT_EQ(stats::output_format_from_string("binary"),
+            stats::output_format::binary);
+  EXPECT_FALSE(stats::output_format_from_string("json").has_value());
+}
+
+TEST(AsyncStats, SpscRingKeepsOrder) {  // NOLINT
+  stats::SpscRing<std::uint64_t> ring{60};
+  EXPECT_EQ(ring.capacity(), 64);
+
+  constexpr std::uint64_t items = 10000;
+  std::thread producer{[&ring] {
+    for (std::uint64_t i = 0; i < items; i += 2) {
+      const std::uint64_t pair[] = {i, i + 1};  // NOLINT
+      while (!ring.try_push(pair, 2)) {
+        std::this_thread::yield();
+      }
+    }
+  }};
+
+  std::uint64_t expected = 0;
+  std::uint64_t buffer[3];  // NOLINT
+  while (expected < items) {
+    auto count = ring.try_pop(buffer, 3);
+    for (std::size_t i = 0; i < count; ++i, ++expected) {
+      ASSERT_EQ(buffer[i], expected);
+    }
+  }
+
+  producer.join();
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(AsyncStats, SpscRingRejectsPartialPush) {  // NOLINT
+  stats::SpscRing<int> ring{4};
+  const int items[] = {1, 2, 3};  // NOLINT
+
+  EXPECT_TRUE(ring.try_push(items, 3));
+  EXPECT_FALSE(ring.try_push(items, 2));
+  EXPECT_TRUE(ring.try_push(items, 1));
+}
+
+TEST(AsyncStats, WritesAllRowsOnStop) {  // NOLINT
+  std::vector<std::int64_t> times;
+  std::vector<double> values;
+  int flushes = 0;
+
+  constexpr std::int64_t rows = 50000;
+  {
+    stats::AsyncPipeline pipeline{16, stats::overflow_policy::block};
+    auto writer = pipeline.attach(
+        std::make_unique<MemoryWriter>(times, values, &flushes));
+
+    for (std::int64_t i = 0; i < rows; ++i) {
+      auto value = 0.5 * static_cast<double>(i);
+      writer->write(i, &value);
+    }
+
+    writer->flush();
+    EXPECT_EQ(times.size(), rows);
+    EXPECT_EQ(flushes, 1);
+
+    pipeline.stop();
+    EXPECT_EQ(pipeline.dropped(), 0);
+  }
+
+  ASSERT_EQ(times.size(), rows);
+  for (std::int64_t i = 0; i < rows; ++i) {
+    EXPECT_EQ(times[i], i);
+    EXPECT_EQ(values[i], 0.5 * static_cast<double>(i));
+  }
+}
+
+TEST(AsyncStats, CountsDroppedRows) {  // NOLINT
+  std::vector<std::int64_t> times;
+  std::vector<double> values;
+
+  constexpr std::int64_t rows = 100000;
+  stats::AsyncPipeline pipeline{1, stats::overflow_policy::drop};
+  auto writer =
+      pipeline.attach(std::make_unique<MemoryWriter>(times, values));
+
+  for (std::int64_t i = 0; i < rows; ++i) {
+    auto value = static_cast<double>(i);
+    writer->write(i, &value);
+  }
+  pipeline.stop();
+
+  EXPECT_EQ(times.size() + pipeline.dropped(), rows);
+  for (std::size_t i = 1; i < times.size(); ++i) {
+    EXPECT_LT(times[i - 1], times[i]);
+  }
+}
+
+TEST(AsyncStats, OverflowPolicyFromString) {  // NOLINT
+  EXPECT_EQ(stats::overflow_policy_from_string("Block"),
+            stats::overflow_policy::block);
+  EXPECT_EQ(stats::overflow_policy_from_string("drop"),
+            stats::overflow_policy::drop);
+  EXPECT_FALSE(stats::overflow_policy_from_string("wait").has_value());
+}
+
+TEST(WindowStats, HistogramQuantiles) {  // NOLINT
+  stats::Histogram histogram;
+  EXPECT_TRUE(std::isnan(histogram.quantile(0.5)));
+
+  for (int i = 1; i <= 10000; ++i) {
+    histogram.add(static_cast<double>(i));
+  }
+
+  EXPECT_EQ(histogram.count(), 10000);
+  EXPECT_DOUBLE_EQ(histogram.quantile(0), 1);
+  EXPECT_DOUBLE_EQ(histogram.quantile(1), 10000);
+
+  constexpr double relative_error = 1.0 / stats::Histogram::sub_buckets;
+  for (auto quantile : {0.01, 0.5, 0.9, 0.99, 0.999}) {
+    auto expected = quantile * 10000;
+    EXPECT_NEAR(histogram.quantile(quantile), expected,
+                expected * relative_error);
+  }
+
+  histogram.reset();
+  histogram.add(-2e-6);
+  histogram.add(0);
+  histogram.add(3e9);
+  EXPECT_NEAR(histogram.quantile(0.34), 0, 1e-12);
+  EXPECT_DOUBLE_EQ(histogram.quantile(0.01), -2e-6);
+  EXPECT_DOUBLE_EQ(histogram.quantile(1), 3e9);
+}
+
+TEST(WindowStats, HistogramAllocatesOnlyUsedBuckets) {  // NOLINT
+  stats::Histogram histogram;
+  histogram.add(0.0);
+  histogram.add(1e-300);
+  histogram.add(1e300);
+
+  // Two blocks of buckets instead of all powers of two in between
+  EXPECT_LE(histogram.memory_usage(), 2 * 1200);
+  EXPECT_EQ(histogram.quantile(0.3), 0.0);
+  EXPECT_NEAR(histogram.quantile(0.5), 1e-300,
+              1e-300 / stats::Histogram::sub_buckets);
+  EXPECT_DOUBLE_EQ(histogram.quantile(1), 1e300);
+
+  histogram.reset();
+  histogram.add(-1.0);
+  EXPECT_LE(histogram.memory_usage(), 3 * 1200);
+  EXPECT_DOUBLE_EQ(histogram.quantile(0.5), -1.0);
+}
+
+TEST(WindowStats, ParsesStatistics) {  // NOLINT
+  auto mean = stats::statistic_from_string("mean");
+  ASSERT_TRUE(mean.has_value());
+  EXPECT_EQ(mean->kind, stats::statistic_kind::mean);
+
+  auto percentile = stats::statistic_from_string("p99.9");
+  ASSERT_TRUE(percentile.has_value());
+  EXPECT_EQ(percentile->kind, stats::statistic_kind::quantile);
+  EXPECT_DOUBLE_EQ(percentile->quantile, 0.999);
+
+  EXPECT_FALSE(stats::statistic_from_string("p0").has_value());
+  EXPECT_FALSE(stats::statistic_from_string("p101").has_value());
+  EXPECT_FALSE(stats::statistic_from_string("p5x").has_value());
+  EXPECT_FALSE(stats::statistic_from_string("median").has_value());
+}
+
+TEST(WindowStats, WritesRowPerWindow) {  // NOLINT
+  std::vector<stats::Statistic> statistics;
+  for (const auto *name : {"count", "mean", "min", "max", "sum", "p50"}) {
+    statistics.push_back(*stats::statistic_from_string(name));
+  }
+
+  auto columns = stats::WindowAggregator::columns("delay", statistics);
+  EXPECT_EQ(columns.front(), "delay_count");
+  EXPECT_EQ(columns.back(), "delay_p50");
+
+  std::vector<std::int64_t> times;
+  std::vector<double> values;
+  stats::WindowAggregator aggregator{
+      100, statistics,
+      std::make_unique<MemoryWriter>(times, values, nullptr, columns)};
+
+  // Windows [0, 100) and [200, 300), no samples in [100, 200)
+  for (double value : {1.0, 2.0, 6.0}) {
+    aggregator.write(static_cast<std::int64_t>(value * 10), &value);
+  }
+  auto late = 10.0;
+  aggregator.write(250, &late);
+  aggregator.flush();
+
+  ASSERT_EQ(times, (std::vector<std::int64_t>{100, 300}));
+
+  // Quantiles are estimated by the histogram
+  EXPECT_NEAR(values[5], 2, 2.0 / stats::Histogram::sub_buckets);
+  values[5] = 2;
+
+  EXPECT_EQ(values, (std::vector<double>{3, 3, 1, 6, 9, 2,  //
+                                         1, 10, 10, 10, 10, 10}));
+}
+
+TEST(SampleFilter, KeepsEveryNthSample) {  // NOLINT
+  stats::SampleFilter filter{3, 0};
+  EXPECT_TRUE(filter.enabled());
+
+  std::vector<std::int64_t> kept;
+  for (std::int64_t time = 0; time < 10; ++time) {
+    if (filter.accept(time)) {
+      kept.push_back(time);
+    }
+  }
+
+  EXPECT_EQ(kept, (std::vector<std::int64_t>{0, 3, 6, 9}));
+  EXPECT_EQ(filter.seen(), 10);
+  EXPECT_EQ(filter.dropped(), 6);
+}
+
+TEST(SampleFilter, LimitsRate) {  // NOLINT
+  stats::SampleFilter filter{1, 10};
+
+  std::vector<std::int64_t> kept;
+  for (std::int64_t time : {0, 1, 9, 10, 12, 25, 34, 35}) {
+    if (filter.accept(time)) {
+      kept.push_back(time);
+    }
+  }
+
+  EXPECT_EQ(kept, (std::vector<std::int64_t>{0, 10, 25, 35}));
+  EXPECT_EQ(filter.accepted(), 4);
+  EXPECT_FALSE(stats::SampleFilter{}.enabled());
+}
+
+namespace {
+void write_container(const std::string& path, bool close) {
+  auto container = std::make_shared<stats::ContainerFile>(path);
+  auto first = container->open_stream("first", {"a", "b"}, 1e-9, 3);
+  auto second = container->open_stream("dir/second", {"c"}, 1e-9, 3);
+
+  for (std::int64_t i = 0; i < 10; ++i) {
+    const double values[] = {static_cast<double>(i), -1.0 * i};  // NOLINT
+    first->write(i, values);
+    if (i % 2 == 0) {
+      second->write(i, values);
+    }
+  }
+
+  first->flush();
+  second->flush();
+  if (close) {
+    container->close();
+  }
+}
+
+void expect_streams(stats::ContainerReader& reader) {
+  ASSERT_EQ(reader.streams().size(), 2);
+  EXPECT_DOUBLE_EQ(reader.seconds_per_step(), 1e-9);
+
+  const auto* first = reader.find("first");
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first->columns, (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(first->blocks.size(), 4);
+
+  const auto* second = reader.find("dir/second");
+  ASSERT_NE(second, nullptr);
+  ASSERT_EQ(second->blocks.size(), 2);
+
+  std::vector<std::int64_t> times;
+  stats::ContainerReader::Block block;
+  for (std::size_t i = 0; i < second->blocks.size(); ++i) {
+    reader.read_block(*second, i, block);
+    ASSERT_EQ(block.values.size(), 1);
+    for (std::size_t row = 0; row < block.times.size(); ++row) {
+      EXPECT_EQ(block.values[0][row], static_cast<double>(block.times[row]));
+      times.push_back(block.times[row]);
+    }
+  }
+  EXPECT_EQ(times, (std::vector<std::int64_t>{0, 2, 4, 6, 8}));
+}
+}  // namespace
+
+TEST(ContainerStats, ReadsStreamByIndex) {  // NOLINT
+  const std::string path = "container_test.simc";
+  write_container(path, true);
+
+  ASSERT_TRUE(stats::ContainerReader::is_container(path));
+  stats::ContainerReader reader{path};
+  EXPECT_TRUE(reader.indexed());
+  expect_streams(reader);
+
+  std::remove(path.c_str());
+}
+
+TEST(ContainerStats, ScansFileWithoutIndex) {  // NOLINT
+  const std::string path = "container_test_interrupted.simc";
+  write_container(path, true);
+
+  // Cut index and trailer as if the run was killed
+  {
+    stats::ContainerReader reader{path};
+    const auto& first = *reader.find("first");
+    const auto& second = *reader.find("dir/second");
+    auto end = std::max(first.blocks.back().offset,
+                        second.blocks.back().offset) +
+               100;
+    std::filesystem::resize_file(path, end);
+  }
+
+  stats::ContainerReader reader{path};
+  EXPECT_FALSE(reader.indexed());
+  expect_streams(reader);
+
+  std::remove(path.c_str());
+}
+
+TEST(CompressedStats, WritesGzipReadableByZlib) {  // NOLINT
+  const std::string path = "compressed_stats_test.txt.gz";
+  constexpr std::int64_t rows = 100000;
+
+  std::string expected = "Time,value\n";
+  {
+    stats::CsvWriter writer{path, {"value"}, 1, stats::compression::gzip};
+    for (std::int64_t i = 0; i < rows; ++i) {
+      auto value = static_cast<double>(i % 7);
+      writer.write(i, &value);
+      expected += std::to_string(i) + ',' + std::to_string(i % 7) + '\n';
+
+      // Flushed data is readable while file is written
+      if (i == rows / 2) {
+        writer.flush();
+      }
+    }
+  }
+
+  EXPECT_LT(std::filesystem::file_size(path), expected.size() / 2);
+
+  std::string content;
+  auto *file = gzopen(path.c_str(), "rb");
+  ASSERT_NE(file, nullptr);
+
+  std::vector<char> chunk(1 << 16);
+  int read = 0;
+  while ((read = gzread(file, chunk.data(),
+                        static_cast<unsigned>(chunk.size()))) > 0) {
+    content.append(chunk.data(), static_cast<std::size_t>(read));
+  }
+  EXPECT_EQ(gzclose(file), Z_OK);
+
+  EXPECT_EQ(content, expected);
+
+  std::remove(path.c_str());
+}
+
+TEST(CompressedStats, CompressionFromString) {  // NOLINT
+  EXPECT_EQ(stats::compression_from_string("GZIP"), stats::compression::gzip);
+  EXPECT_EQ(stats::compression_from_string("zstd"), stats::compression::zstd);
+  EXPECT_EQ(stats::compression_from_string("none"), stats::compression::none);
+  EXPECT_FALSE(stats::compression_from_string("lz4").has_value());
+  EXPECT_STREQ(stats::compressed_extension(stats::compression::zstd), ".zst");
+}
+
+TEST(LiveStats, ReadsSamplesInOtherProcess) {  // NOLINT
+  const std::string name = fmt::format("/simulation-live-test-{}", getpid());
+  constexpr std::int64_t rows = 200000;
+  constexpr std::size_t capacity = 1024;
+
+  auto writer = std::make_unique<stats::ShmWriter>(
+      name, std::vector<std::string>{"value", "twice"}, 1e-9, capacity);
+
+  int ready[2];  // NOLINT
+  ASSERT_EQ(pipe(ready), 0);
+
+  auto child = fork();
+  ASSERT_GE(child, 0);
+
+  if (child == 0) {
+    // Consumer: every read sample must be consistent and in order
+    int status = 0;
+    try {
+      stats::ShmReader reader{name};
+      char byte = 1;
+      status |= write(ready[1], &byte, 1) == 1 ? 0 : 1;
+
+      if (reader.columns() != std::vector<std::string>{"value", "twice"}) {
+        status |= 2;
+      }
+
+      std::uint64_t received = 0;
+      std::uint64_t next = 0;
+      stats::ShmReader::Sample sample;
+      while (true) {
+        auto closed = reader.closed();
+        while (reader.next(sample)) {
+          auto expected = static_cast<double>(sample.sequence);
+          auto expected_time = static_cast<std::int64_t>(sample.sequence) * 10;
+          if (sample.sequence < next || sample.time != expected_time ||
+              sample.values[0] != expected ||
+              sample.values[1] != 2 * expected) {
+            status |= 4;
+          }
+          next = sample.sequence + 1;
+          ++received;
+        }
+
+        if (closed) {
+          break;
+        }
+      }
+
+      if (next != rows || received + reader.lost() != rows) {
+        status |= 8;
+      }
+    } catch (stats::OutputError &) {
+      status |= 16;
+    }
+    _exit(status);
+  }
+
+  char byte = 0;
+  ASSERT_EQ(read(ready[0], &byte, 1), 1);
+
+  // Producer
+  for (std::int64_t i = 0; i < rows; ++i) {
+    const double values[] = {static_cast<double>(i), 2.0 * i};  // NOLINT
+    writer->write(i * 10, values);
+  }
+  writer.reset();
+
+  int status = 0;
+  ASSERT_EQ(waitpid(child, &status, 0), child);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+
+  close(ready[0]);
+  close(ready[1]);
+
+  // Segment is removed with the writer
+  EXPECT_THROW(stats::ShmReader{name}, stats::OutputError);
+}
+
+TEST(LiveStats, SegmentNameHasNoSlashes) {  // NOLINT
+  EXPECT_EQ(stats::ShmWriter::segment_name("/sim", "dir/node-a-cwnd"),
+            "/sim-dir_node-a-cwnd");
+}
+
+namespace {
+// Ethernet II, IPv4 and UDP headers
+auto udp_frame(std::uint16_t src_port, std::uint16_t dst_port)
+    -> std::vector<std::uint8_t> {
+  std::vector<std::uint8_t> frame(14 + 20 + 8 + 10);
+  frame[12] = 0x08;
+  frame[13] = 0x00;
+  frame[14] = 0x45;
+  frame[14 + 9] = 17;
+  frame[34] = static_cast<std::uint8_t>(src_port >> 8U);
+  frame[35] = static_cast<std::uint8_t>(src_port);
+  frame[36] = static_cast<std::uint8_t>(dst_port >> 8U);
+  frame[37] = static_cast<std::uint8_t>(dst_port);
+  return frame;
+}
+
+template <typename T>
+auto read_at(const std::string &bytes, std::size_t offset) -> T {
+  T value{};
+  std::memcpy(&value, bytes.data() + offset, sizeof(value));
+  return value;
+}
+}  // namespace
+
+TEST(PacketCapture, FiltersByProtocolAndPort) {  // NOLINT
+  using stats::capture_protocol;
+  using stats::link_type;
+
+  auto frame = udp_frame(5000, 9);
+
+  stats::PacketFilter any;
+  EXPECT_FALSE(any.enabled());
+  EXPECT_TRUE(any.match(frame.data(), frame.size()));
+
+  EXPECT_TRUE(stats::PacketFilter(link_type::ethernet, capture_protocol::udp,
+                                  std::nullopt)
+                  .match(frame.data(), frame.size()));
+  EXPECT_FALSE(stats::PacketFilter(link_type::ethernet, capture_protocol::tcp,
+                                   std::nullopt)
+                   .match(frame.data(), frame.size()));
+  EXPECT_TRUE(
+      stats::PacketFilter(link_type::ethernet, capture_protocol::any, 9)
+          .match(frame.data(), frame.size()));
+  EXPECT_FALSE(
+      stats::PacketFilter(link_type::ethernet, capture_protocol::udp, 80)
+          .match(frame.data(), frame.size()));
+
+  // The same packet over PPP: protocol field instead of Ethernet header
+  std::vector<std::uint8_t> ppp = {0x00, 0x21};
+  ppp.insert(ppp.end(), frame.begin() + 14, frame.end());
+  EXPECT_TRUE(stats::PacketFilter(link_type::ppp, capture_protocol::udp, 5000)
+                  .match(ppp.data(), ppp.size()));
+
+  // Truncated headers don't match
+  EXPECT_FALSE(
+      stats::PacketFilter(link_type::ethernet, capture_protocol::udp, 9)
+          .match(frame.data(), 36));
+
+  EXPECT_EQ(stats::capture_protocol_from_string("TCP"), capture_protocol::tcp);
+  EXPECT_FALSE(stats::capture_protocol_from_string("sctp").has_value());
+}
+
+TEST(PacketCapture, WritesPcapngBlocks) {  // NOLINT
+  const std::string path = "capture_test.pcapng";
+  constexpr std::uint32_t snap_length = 40;
+
+  auto frame = udp_frame(5000, 9);
+  {
+    stats::PcapngWriter writer{path, stats::link_type::ethernet, snap_length,
+                               "eth0"};
+    writer.write(1'500'000'000, frame.data(),
+                 static_cast<std::uint32_t>(frame.size()),
+                 static_cast<std::uint32_t>(frame.size()));
+    writer.write(0x1'0000'0001, frame.data(), 10, 100);
+    EXPECT_EQ(writer.packets(), 2);
+  }
+
+  std::ifstream in{path, std::ios::binary};
+  std::string bytes{std::istreambuf_iterator<char>{in}, {}};
+
+  // Section header
+  ASSERT_GE(bytes.size(), 28);
+  EXPECT_EQ(read_at<std::uint32_t>(bytes, 0), 0x0A0D0D0A);
+  EXPECT_EQ(read_at<std::uint32_t>(bytes, 8), 0x1A2B3C4D);
+  auto offset = std::size_t{read_at<std::uint32_t>(bytes, 4)};
+
+  // Interface description
+  EXPECT_EQ(read_at<std::uint32_t>(bytes, offset), 1);
+  EXPECT_EQ(read_at<std::uint16_t>(bytes, offset + 8), 1);
+  EXPECT_EQ(read_at<std::uint32_t>(bytes, offset + 12), snap_length);
+  offset += read_at<std::uint32_t>(bytes, offset + 4);
+
+  // Packets: truncated to snap length and padded to 4 bytes
+  std::vector<std::uint32_t> captured;
+  while (offset < bytes.size()) {
+    auto length = read_at<std::uint32_t>(bytes, offset + 4);
+    EXPECT_EQ(read_at<std::uint32_t>(bytes, offset), 6);
+    EXPECT_EQ(length % 4, 0);
+    EXPECT_EQ(read_at<std::uint32_t>(bytes, offset + length - 4), length);
+    captured.push_back(read_at<std::uint32_t>(bytes, offset + 20));
+    offset += length;
+  }
+
+  EXPECT_EQ(captured, (std::vector<std::uint32_t>{snap_length, 10}));
+  EXPECT_EQ(offset, bytes.size());
+
+  std::remove(path.c_str());
+}
@@ -8,6 +8,7 @@
 #include <gtest/gtest.h>
 #include <tinyxml2.h>
 
+#include "model/background_traffic.h"
 #include "model/channel.h"
 #include "parser/parse_util.h"
 #include "parser/parser.h"
@@ -94,6 +95,7 @@ TEST(XmlParse, ReadingNode) {  // NOLINT
   auto res = parser.parse(xml);
   EXPECT_EQ(res.model_name, "CsmaNetworkModel");
   EXPECT_TRUE(res.polulate_tables);
+  EXPECT_FALSE(res.populate_neighbor_cache);
 
   ASSERT_EQ(res.nodes.size(), 1);
   auto& node = res.nodes.front();
@@ -216,6 +218,361 @@ TEST(XmlParse, ReadsRegistrators) {  // NOLINT
   EXPECT_EQ(second.sink, "Output");       // by default
 }
 
+TEST(XmlParse, ReadsRegistratorFormat) {  // NOLINT
+  parser::XmlParser parser;
+
+  const auto* xml =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <statistics>
+            <registrator source="test-source" type="TestType" file="test-1"
+               start="0s" format="binary"/>
+            <registrator source="test-source" type="TestType" file="test-2"
+               start="0s"/>
+          </statistics>
+        </model>
+    )";
+
+  auto result = parser.parse(xml);
+  ASSERT_EQ(result.registrators.size(), 2);
+  EXPECT_EQ(result.registrators[0].format, stats::output_format::binary);
+  EXPECT_EQ(result.registrators[1].format, stats::output_format::csv);
+
+  const auto* bad_format =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <statistics>
+            <registrator source="test-source" type="TestType" file="test-1"
+               start="0s" format="xml"/>
+          </statistics>
+        </model>
+    )";
+
+  EXPECT_THROW(parser.parse(bad_format), parser::ParseError);
+}
+
+TEST(XmlParse, ReadsRegistratorWindow) {  // NOLINT
+  parser::XmlParser parser;
+
+  const auto* xml =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <statistics>
+            <registrator source="test-source" type="TestType" file="test-1"
+               start="0s" window="100ms" stats="mean, max, p99.9"/>
+            <registrator source="test-source" type="TestType" file="test-2"
+               start="0s" window="1s"/>
+            <registrator source="test-source" type="TestType" file="test-3"
+               start="0s"/>
+          </statistics>
+        </model>
+    )";
+
+  auto result = parser.parse(xml);
+  ASSERT_EQ(result.registrators.size(), 3);
+
+  const auto& aggregated = result.registrators[0];
+  EXPECT_EQ(aggregated.window, "100ms");
+  ASSERT_EQ(aggregated.statistics.size(), 3);
+  EXPECT_EQ(aggregated.statistics[1].kind, stats::statistic_kind::max);
+  EXPECT_EQ(aggregated.statistics[2].name, "p99.9");
+
+  EXPECT_EQ(result.registrators[1].statistics.size(), 4);
+
+  EXPECT_FALSE(result.registrators[2].window.has_value());
+  EXPECT_TRUE(result.registrators[2].statistics.empty());
+
+  const auto* bad_statistic =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <statistics>
+            <registrator source="test-source" type="TestType" file="test-1"
+               start="0s" window="1s" stats="mean,median"/>
+          </statistics>
+        </model>
+    )";
+  EXPECT_THROW(parser.parse(bad_statistic), parser::ParseError);
+
+  const auto* no_window =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <statistics>
+            <registrator source="test-source" type="TestType" file="test-1"
+               start="0s" stats="mean"/>
+          </statistics>
+        </model>
+    )";
+  EXPECT_THROW(parser.parse(no_window), parser::ParseError);
+}
+
+TEST(XmlParse, ReadsRegistratorDecimation) {  // NOLINT
+  parser::XmlParser parser;
+
+  const auto* xml =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <statistics>
+            <registrator source="test-source" type="TestType" file="test-1"
+               start="0s" decimate="10" min-interval="1ms"/>
+            <registrator source="test-source" type="TestType" file="test-2"
+               start="0s"/>
+          </statistics>
+        </model>
+    )";
+
+  auto result = parser.parse(xml);
+  ASSERT_EQ(result.registrators.size(), 2);
+  EXPECT_EQ(result.registrators[0].decimate, 10);
+  EXPECT_EQ(result.registrators[0].min_interval, "1ms");
+  EXPECT_EQ(result.registrators[1].decimate, 1);
+  EXPECT_FALSE(result.registrators[1].min_interval.has_value());
+
+  const auto* zero_decimate =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <statistics>
+            <registrator source="test-source" type="TestType" file="test-1"
+               start="0s" decimate="0"/>
+          </statistics>
+        </model>
+    )";
+  EXPECT_THROW(parser.parse(zero_decimate), parser::ParseError);
+}
+
+TEST(XmlParse, ReadsPollers) {  // NOLINT
+  parser::XmlParser parser;
+
+  const auto* xml =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <statistics>
+            <poller file="server" period="100ms" end="10s" format="binary">
+              <value name="rx" object="server/sink" getter="TotalRx"/>
+              <value name="mtu" object="server/eth0" attribute="Mtu"/>
+            </poller>
+          </statistics>
+        </model>
+    )";
+
+  auto result = parser.parse(xml);
+  ASSERT_EQ(result.pollers.size(), 1);
+
+  const auto& poller = result.pollers[0];
+  EXPECT_EQ(poller.file, "server");
+  EXPECT_EQ(poller.period, "100ms");
+  EXPECT_EQ(poller.start_time, "0s");
+  EXPECT_EQ(poller.end_time, "10s");
+  EXPECT_EQ(poller.format, stats::output_format::binary);
+
+  ASSERT_EQ(poller.values.size(), 2);
+  EXPECT_EQ(poller.values[0].name, "rx");
+  EXPECT_EQ(poller.values[0].object, "server/sink");
+  EXPECT_EQ(poller.values[0].getter, "TotalRx");
+  EXPECT_EQ(poller.values[1].attribute, "Mtu");
+
+  const auto* both =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <statistics>
+            <poller file="server" period="100ms">
+              <value name="rx" object="server/sink" getter="TotalRx"
+                     attribute="Mtu"/>
+            </poller>
+          </statistics>
+        </model>
+    )";
+  EXPECT_THROW(parser.parse(both), parser::ParseError);
+
+  const auto* empty =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <statistics>
+            <poller file="server" period="100ms"/>
+          </statistics>
+        </model>
+    )";
+  EXPECT_THROW(parser.parse(empty), parser::ParseError);
+}
+
+TEST(XmlParse, ReadsStatisticsSettings) {  // NOLINT
+  parser::XmlParser parser;
+
+  const auto* xml =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <statistics async="true" queue-size="1024" overflow="drop"
+                      compress="gzip" live="run" live-capacity="4096">
+            <registrator source="test-source" type="TestType" file="test-1"
+                         compress="zstd"/>
+            <registrator source="test-source" type="TestType" file="test-2"/>
+          </statistics>
+        </model>
+    )";
+
+  auto result = parser.parse(xml);
+  EXPECT_TRUE(result.statistics.async);
+  EXPECT_EQ(result.statistics.queue_size, 1024);
+  EXPECT_EQ(result.statistics.overflow, stats::overflow_policy::drop);
+  EXPECT_EQ(result.statistics.compress, stats::compression::gzip);
+  EXPECT_EQ(result.statistics.live, "run");
+  EXPECT_EQ(result.statistics.live_capacity, 4096);
+  ASSERT_EQ(result.registrators.size(), 2);
+  EXPECT_EQ(result.registrators[0].compress, stats::compression::zstd);
+  EXPECT_FALSE(result.registrators[1].compress.has_value());
+
+  auto defaults = parser.parse(R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <statistics/>
+        </model>
+    )");
+  EXPECT_FALSE(defaults.statistics.async);
+  EXPECT_EQ(defaults.statistics.overflow, stats::overflow_policy::block);
+  EXPECT_EQ(defaults.statistics.compress, stats::compression::none);
+  EXPECT_FALSE(defaults.statistics.live.has_value());
+
+  const auto* bad_policy =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <statistics async="true" overflow="wait"/>
+        </model>
+    )";
+
+  EXPECT_THROW(parser.parse(bad_policy), parser::ParseError);
+
+  const auto* bad_compression =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <statistics compress="lz4"/>
+        </model>
+    )";
+
+  EXPECT_THROW(parser.parse(bad_compression), parser::ParseError);
+}
+
+TEST(XmlParse, ReadsDeviceCapture) {  // NOLINT
+  parser::XmlParser parser;
+
+  const auto* xml =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <node name="test">
+            <device-list>
+              <device name="eth0" type="Csma">
+                <capture file="test-eth0" protocol="udp" port="9" sample="10"
+                         snaplen="128"/>
+              </device>
+              <device name="eth1" type="Csma"/>
+            </device-list>
+          </node>
+        </model>
+    )";
+
+  auto result = parser.parse(xml);
+  ASSERT_EQ(result.nodes.size(), 1);
+  const auto& devices = result.nodes.front().devices;
+  ASSERT_EQ(devices.size(), 2);
+
+  ASSERT_TRUE(devices[0].capture.has_value());
+  const auto& capture = *devices[0].capture;
+  EXPECT_EQ(capture.file, "test-eth0");
+  EXPECT_EQ(capture.protocol, stats::capture_protocol::udp);
+  EXPECT_EQ(capture.port, 9);
+  EXPECT_EQ(capture.sample, 10);
+  EXPECT_EQ(capture.snap_length, 128);
+
+  EXPECT_FALSE(devices[1].capture.has_value());
+
+  const auto* bad_port =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <node name="test">
+            <device-list>
+              <device name="eth0" type="Csma">
+                <capture file="test-eth0" port="70000"/>
+              </device>
+            </device-list>
+          </node>
+        </model>
+    )";
+
+  EXPECT_THROW(parser.parse(bad_port), parser::ParseError);
+}
+
+TEST(XmlParse, ReadsBackgroundFlows) {  // NOLINT
+  parser::XmlParser parser;
+
+  const auto* xml =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <background mode="delay">
+            <flow name="bulk" source="node-a" destination="10.0.0.2"
+                  rate="40Mb/s" packet-size="1000" start="1s" end="5s"/>
+            <flow name="web" source="node-b" destination="10.0.0.1"
+                  rate="2Mb/s"/>
+          </background>
+        </model>
+    )";
+
+  auto result = parser.parse(xml);
+  const auto& background = result.background;
+  EXPECT_EQ(background.mode, model::background_mode::delay);
+  ASSERT_EQ(background.flows.size(), 2);
+
+  const auto& bulk = background.flows[0];
+  EXPECT_EQ(bulk.name, "bulk");
+  EXPECT_EQ(bulk.source, "node-a");
+  EXPECT_EQ(bulk.destination, asio::ip::make_address_v4("10.0.0.2"));
+  EXPECT_EQ(bulk.rate, "40Mb/s");
+  EXPECT_EQ(bulk.packet_size, 1000);
+  EXPECT_EQ(bulk.start_time, "1s");
+  EXPECT_EQ(bulk.end_time, "5s");
+
+  const auto& web = background.flows[1];
+  EXPECT_EQ(web.packet_size, 1500);
+  EXPECT_EQ(web.start_time, "0s");
+  EXPECT_FALSE(web.end_time.has_value());
+
+  const auto* bad_mode =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <background mode="fluid"/>
+        </model>
+    )";
+
+  EXPECT_THROW(parser.parse(bad_mode), parser::ParseError);
+
+  const auto* bad_destination =
+      R"(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <model name="CsmaNetworkModel">
+          <background>
+            <flow name="bulk" source="node-a" destination="node-b"
+                  rate="40Mb/s"/>
+          </background>
+        </model>
+    )";
+
+  EXPECT_THROW(parser.parse(bad_destination), parser::ParseError);
+}
+
 TEST(XmlParse, IncorrectNodeReading) {  // NOLINT
   parser::XmlParser parser;
 
@@ -355,6 +712,7 @@ TEST(XmlParse, ParseModelSettings) {  // NOLINT
       <?xml version="1.0" encoding="UTF-8"?>
       <model name="experiment">
         <populate-routing-tables>true</populate-routing-tables>
+        <populate-neighbor-cache>true</populate-neighbor-cache>
         <duration>3s</duration>
         <precision>NS</precision>
       </model>
@@ -363,6 +721,7 @@ TEST(XmlParse, ParseModelSettings) {  // NOLINT
   auto res = parser.parse(xml);
 
   EXPECT_TRUE(res.polulate_tables);
+  EXPECT_TRUE(res.populate_neighbor_cache);
   EXPECT_EQ(res.end_time, "3s");
   EXPECT_EQ(res.time_precision, ns3::Time::NS);
 }
@@ -0,0 +1,100 @@
+// Example reader of live statistics (<statistics live="...">): prints rows of
+// one stream as CSV while the simulation runs
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <CLI/App.hpp>
+#include <CLI/CLI.hpp>
+#include <CLI/Error.hpp>
+#include <CLI/Option.hpp>
+
+#include <fmt/core.h>
+
+#include "stats/shm_reader.h"
+#include "stats/writer.h"
+
+namespace {
+void print_sample(const stats::ShmReader::Sample &sample,
+                  double seconds_per_step) {
+  std::cout << fmt::format("{}",
+                           static_cast<double>(sample.time) * seconds_per_step);
+  for (auto value : sample.values) {
+    std::cout << fmt::format(",{}", value);
+  }
+  std::cout << '\n';
+}
+
+auto open_stream(const std::string &name, bool wait) -> stats::ShmReader {
+  constexpr auto retry_period = std::chrono::milliseconds(100);
+
+  while (true) {
+    try {
+      return stats::ShmReader{name};
+    } catch (stats::OutputError &) {
+      if (!wait) {
+        throw;
+      }
+      std::this_thread::sleep_for(retry_period);
+    }
+  }
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  CLI::App app{"Print live statistics stream as CSV", "simulation-live"};
+
+  std::string stream;
+  bool wait = false;
+
+  app.add_option("stream", stream,
+                 "Shared memory segment: \"<live prefix>-<file name>\"")
+      ->required();
+  app.add_flag("-w,--wait", wait, "Wait for the stream to be created");
+
+  try {
+    app.parse(argc, argv);
+  } catch (CLI::Error &e) {
+    return app.exit(e);
+  }
+
+  constexpr auto poll_period = std::chrono::milliseconds(10);
+
+  try {
+    auto reader = open_stream(stream, wait);
+
+    std::cout << "Time";
+    for (const auto &column : reader.columns()) {
+      std::cout << ',' << column;
+    }
+    std::cout << '\n';
+
+    stats::ShmReader::Sample sample;
+    while (true) {
+      // Samples published before closing are still read
+      auto closed = reader.closed();
+      while (reader.next(sample)) {
+        print_sample(sample, reader.seconds_per_step());
+      }
+
+      if (closed) {
+        break;
+      }
+
+      std::cout.flush();
+      std::this_thread::sleep_for(poll_period);
+    }
+
+    if (reader.lost() > 0) {
+      std::cerr << fmt::format("Warning: {} samples were overwritten\n",
+                               reader.lost());
+    }
+  } catch (stats::OutputError &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
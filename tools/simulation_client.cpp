@@ -0,0 +1,78 @@
+// Client of "simulation --serve": sends model to warm worker, prints files
+// written by the job and exits with its status
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include <unistd.h>
+
+#include <CLI/App.hpp>
+#include <CLI/CLI.hpp>
+#include <CLI/Error.hpp>
+#include <CLI/Option.hpp>
+#include <CLI/Validators.hpp>
+
+#include "server/protocol.h"
+
+int main(int argc, char *argv[]) {
+  CLI::App app{"Run model on simulation server", "simulation-client"};
+
+  std::string socket_path;
+  std::string model;
+  bool send_inline = false;
+
+  app.add_option("-s,--socket", socket_path, "Socket of simulation --serve")
+      ->required();
+  app.add_option("model", model,
+                 "Path to model in XML format, \"-\" to read it from stdin")
+      ->required();
+  app.add_flag("--inline", send_inline,
+               "Send content of model file instead of its path");
+
+  try {
+    app.parse(argc, argv);
+  } catch (CLI::Error &e) {
+    return app.exit(e);
+  }
+
+  try {
+    // Relative paths of model and outputs are resolved as for local run
+    server::Request request{
+        .directory = std::filesystem::current_path().string()};
+    if (model == "-") {
+      request.xml.assign(std::istreambuf_iterator<char>{std::cin}, {});
+      if (request.xml.empty()) {
+        std::cerr << "Error: empty model on stdin" << std::endl;
+        return 1;
+      }
+    } else if (send_inline) {
+      std::ifstream in{model};
+      if (!in) {
+        std::cerr << "Error: can't read " << model << std::endl;
+        return 1;
+      }
+      request.xml.assign(std::istreambuf_iterator<char>{in}, {});
+    } else {
+      request.model_path = std::filesystem::absolute(model).string();
+    }
+
+    auto fd = server::connect(socket_path);
+    server::write_request(fd, request);
+    auto response = server::read_response(fd);
+    ::close(fd);
+
+    for (const auto &output : response.outputs) {
+      std::cout << output << '\n';
+    }
+    if (!response.error.empty()) {
+      std::cerr << "Error: " << response.error << std::endl;
+    }
+    return response.status;
+  } catch (server::ProtocolError &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
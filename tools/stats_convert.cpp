@@ -0,0 +1,156 @@
+// Converter of binary statistics files (format="binary" registrators) and
+// statistics containers to CSV
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <CLI/App.hpp>
+#include <CLI/CLI.hpp>
+#include <CLI/Error.hpp>
+#include <CLI/Option.hpp>
+#include <CLI/Validators.hpp>
+
+#include <fmt/core.h>
+
+#include "stats/binary_reader.h"
+#include "stats/container_reader.h"
+#include "stats/writer.h"
+
+namespace {
+void write_heading(const std::vector<std::string> &columns, std::ostream &out) {
+  out << "Time";
+  for (const auto &column : columns) {
+    out << ',' << column;
+  }
+  out << '\n';
+}
+
+void write_block(const stats::BinaryReader::Block &block,
+                 double seconds_per_step, std::ostream &out) {
+  for (std::size_t row = 0; row < block.times.size(); ++row) {
+    auto time = static_cast<double>(block.times[row]) * seconds_per_step;
+    out << fmt::format("{}", time);
+    for (const auto &column : block.values) {
+      out << fmt::format(",{}", column[row]);
+    }
+    out << '\n';
+  }
+}
+
+void convert(stats::BinaryReader &reader, std::ostream &out) {
+  write_heading(reader.columns(), out);
+
+  stats::BinaryReader::Block block;
+  while (reader.next(block)) {
+    write_block(block, reader.seconds_per_step(), out);
+  }
+}
+
+void convert(stats::ContainerReader &reader,
+             const stats::ContainerReader::Stream &stream, std::ostream &out) {
+  write_heading(stream.columns, out);
+
+  stats::ContainerReader::Block block;
+  for (std::size_t i = 0; i < stream.blocks.size(); ++i) {
+    reader.read_block(stream, i, block);
+    write_block(block, reader.seconds_per_step(), out);
+  }
+}
+
+int convert_container(const std::string &input, const std::string &output,
+                      const std::string &stream_name, bool list) {
+  stats::ContainerReader reader{input};
+  if (!reader.indexed()) {
+    std::cerr << fmt::format(
+        "Warning: \"{}\" has no index, probably the run was interrupted\n",
+        input);
+  }
+
+  if (list) {
+    for (const auto &stream : reader.streams()) {
+      std::size_t rows = 0;
+      for (const auto &block : stream.blocks) {
+        rows += block.rows;
+      }
+      std::cout << fmt::format("{}\t{} rows\n", stream.name, rows);
+    }
+    return 0;
+  }
+
+  if (!stream_name.empty()) {
+    const auto *stream = reader.find(stream_name);
+    if (stream == nullptr) {
+      std::cerr << fmt::format("Error: no stream \"{}\" in \"{}\"\n",
+                               stream_name, input);
+      return 1;
+    }
+
+    if (output.empty()) {
+      convert(reader, *stream, std::cout);
+    } else {
+      std::ofstream out{output};
+      convert(reader, *stream, out);
+    }
+    return 0;
+  }
+
+  // Every stream to "<output>/<stream name>.csv"
+  auto directory = std::filesystem::path{output.empty() ? "." : output};
+  for (const auto &stream : reader.streams()) {
+    auto path = directory / (stream.name + ".csv");
+    std::filesystem::create_directories(path.parent_path());
+
+    std::ofstream out{path};
+    convert(reader, stream, out);
+  }
+  return 0;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  CLI::App app{"Convert binary statistics file or container to CSV",
+               "simulation-stats"};
+
+  std::string input;
+  std::string output;
+  std::string stream;
+  bool list = false;
+
+  app.add_option("input", input, "Binary statistics file or container")
+      ->check(CLI::ExistingFile)
+      ->required();
+  app.add_option("-o,--output", output,
+                 "Output CSV file, stdout by default. For container without "
+                 "--stream: directory for CSV file per stream");
+  app.add_option("-s,--stream", stream, "Convert only this container stream");
+  app.add_flag("-l,--list", list, "List container streams");
+
+  try {
+    app.parse(argc, argv);
+  } catch (CLI::Error &e) {
+    return app.exit(e);
+  }
+
+  try {
+    if (stats::ContainerReader::is_container(input)) {
+      return convert_container(input, output, stream, list);
+    }
+
+    stats::BinaryReader reader{input};
+
+    if (output.empty()) {
+      convert(reader, std::cout);
+    } else {
+      std::ofstream out{output};
+      convert(reader, out);
+    }
+  } catch (stats::OutputError &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}